@@ -0,0 +1,219 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "../../src/core/AdblockContentFiltersProfile.h"
+#include "../../src/core/SessionsManager.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+#include <algorithm>
+
+namespace Otter
+{
+
+struct RecordedRequest final
+{
+	QUrl baseUrl;
+	QUrl requestUrl;
+	NetworkManager::ResourceType resourceType = NetworkManager::OtherType;
+};
+
+QVector<RecordedRequest> loadCorpus(const QString &path)
+{
+	const QHash<QString, NetworkManager::ResourceType> resourceTypes({{QLatin1String("main"), NetworkManager::MainFrameType}, {QLatin1String("subframe"), NetworkManager::SubFrameType}, {QLatin1String("popup"), NetworkManager::PopupType}, {QLatin1String("stylesheet"), NetworkManager::StyleSheetType}, {QLatin1String("script"), NetworkManager::ScriptType}, {QLatin1String("image"), NetworkManager::ImageType}, {QLatin1String("object"), NetworkManager::ObjectType}, {QLatin1String("objectsubrequest"), NetworkManager::ObjectSubrequestType}, {QLatin1String("xhr"), NetworkManager::XmlHttpRequestType}, {QLatin1String("websocket"), NetworkManager::WebSocketType}});
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return {};
+	}
+
+	QVector<RecordedRequest> requests;
+	QTextStream stream(&file);
+
+	while (!stream.atEnd())
+	{
+		const QString line(stream.readLine().trimmed());
+
+		if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+		{
+			continue;
+		}
+
+		const QStringList fields(line.split(QLatin1Char(' '), Qt::SkipEmptyParts));
+
+		if (fields.count() < 3)
+		{
+			continue;
+		}
+
+		RecordedRequest request;
+		request.baseUrl = QUrl(fields.at(1));
+		request.requestUrl = QUrl(fields.at(2));
+		request.resourceType = resourceTypes.value(fields.at(0), NetworkManager::OtherType);
+
+		requests.append(request);
+	}
+
+	return requests;
+}
+
+double getPercentile(const QVector<qint64> &sortedTimes, int percentile)
+{
+	if (sortedTimes.isEmpty())
+	{
+		return 0;
+	}
+
+	const int index(qBound(0, static_cast<int>(((sortedTimes.count() * static_cast<qint64>(percentile)) + 99) / 100) - 1, (sortedTimes.count() - 1)));
+
+	return (static_cast<double>(sortedTimes.at(index)) / 1000);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+	application.setApplicationName(QLatin1String("otter-browser-benchmark-contentblocking"));
+
+	QCommandLineParser commandLineParser;
+	commandLineParser.setApplicationDescription(QLatin1String("Loads Adblock filter lists and checks a URL corpus against them, reporting load time, throughput and check latency percentiles."));
+	commandLineParser.addHelpOption();
+	commandLineParser.addPositionalArgument(QLatin1String("lists"), QLatin1String("Filter lists to benchmark."), QLatin1String("[lists...]"));
+	commandLineParser.addOption(QCommandLineOption(QLatin1String("urls"), QLatin1String("Uses <path> as URL corpus."), QLatin1String("path"), QLatin1String(OTTER_BENCHMARKS_PATH "/contentBlocking/urls.txt")));
+	commandLineParser.addOption(QCommandLineOption(QLatin1String("iterations"), QLatin1String("Sets amount of passes over URL corpus."), QLatin1String("amount"), QLatin1String("5")));
+	commandLineParser.process(application);
+
+	QStringList lists(commandLineParser.positionalArguments());
+	QTextStream stream(stdout);
+
+	if (lists.isEmpty())
+	{
+		lists = QStringList({QLatin1String(OTTER_BENCHMARKS_PATH "/contentBlocking/generalBlocking.txt"), QLatin1String(OTTER_BENCHMARKS_PATH "/contentBlocking/privacy.txt")});
+	}
+
+	const QVector<Otter::RecordedRequest> requests(Otter::loadCorpus(commandLineParser.value(QLatin1String("urls"))));
+	const int iterations(qMax(1, commandLineParser.value(QLatin1String("iterations")).toInt()));
+
+	if (requests.isEmpty())
+	{
+		stream << "Failed to load URL corpus\n";
+
+		return 1;
+	}
+
+	QTemporaryDir profileDirectory;
+
+	if (!profileDirectory.isValid() || !QDir(profileDirectory.path()).mkpath(QLatin1String("contentBlocking")))
+	{
+		stream << "Failed to create temporary profile\n";
+
+		return 1;
+	}
+
+	Otter::SessionsManager::createInstance(profileDirectory.path(), profileDirectory.path(), false, true);
+
+	stream << "Checking " << requests.count() << " requests, " << iterations << " passes per list\n\n";
+	stream << QStringLiteral("%1%2%3%4%5%6\n").arg(QLatin1String("List"), -24).arg(QLatin1String("Load (ms)"), 12).arg(QLatin1String("Checks/s"), 14).arg(QLatin1String("p50 (us)"), 12).arg(QLatin1String("p99 (us)"), 12).arg(QLatin1String("Blocked"), 10);
+
+	for (int i = 0; i < lists.count(); ++i)
+	{
+		const QString name(QFileInfo(lists.at(i)).completeBaseName());
+		const QString path(Otter::SessionsManager::getWritableDataPath(QLatin1String("contentBlocking/") + name + QLatin1String(".txt")));
+
+		if (!QFile::copy(lists.at(i), path))
+		{
+			stream << "Failed to copy filter list: " << lists.at(i) << "\n";
+
+			return 1;
+		}
+
+		Otter::ContentFiltersProfile::ProfileSummary profileSummary;
+		profileSummary.name = name;
+
+		QVector<qint64> loadTimes;
+		QVector<qint64> checkTimes;
+		qint64 totalCheckTime(0);
+		int blockedAmount(0);
+
+		loadTimes.reserve(iterations);
+		checkTimes.reserve(requests.count() * iterations);
+
+		for (int j = 0; j < iterations; ++j)
+		{
+			Otter::AdblockContentFiltersProfile profile(profileSummary, {}, Otter::ContentFiltersProfile::NoFlags);
+			QElapsedTimer timer;
+
+			blockedAmount = 0;
+
+			for (int k = 0; k < requests.count(); ++k)
+			{
+				const Otter::RecordedRequest &request(requests.at(k));
+
+				timer.start();
+
+				const bool isBlocked(profile.checkUrl(request.baseUrl, request.requestUrl, request.resourceType).isBlocked);
+				const qint64 checkTime(timer.nsecsElapsed());
+
+				if (k == 0)
+				{
+					loadTimes.append(profile.getStatistics().loadTime);
+				}
+				else
+				{
+					checkTimes.append(checkTime);
+
+					totalCheckTime += checkTime;
+				}
+
+				if (isBlocked)
+				{
+					++blockedAmount;
+				}
+			}
+
+			if (profile.getError() != Otter::ContentFiltersProfile::NoError)
+			{
+				stream << "Failed to load filter list: " << lists.at(i) << "\n";
+
+				return 1;
+			}
+		}
+
+		std::sort(loadTimes.begin(), loadTimes.end());
+		std::sort(checkTimes.begin(), checkTimes.end());
+
+		const double loadTime(static_cast<double>(loadTimes.at(loadTimes.count() / 2)) / 1000000);
+		const double throughput((totalCheckTime > 0) ? ((static_cast<double>(checkTimes.count()) * 1000000000) / totalCheckTime) : 0);
+
+		stream << QStringLiteral("%1%2%3%4%5%6\n").arg(name, -24).arg(loadTime, 12, 'f', 2).arg(throughput, 14, 'f', 0).arg(Otter::getPercentile(checkTimes, 50), 12, 'f', 2).arg(Otter::getPercentile(checkTimes, 99), 12, 'f', 2).arg(blockedAmount, 10);
+	}
+
+	stream << "\nLoad time is the median over passes; the first check of each pass triggers the load and is excluded from check statistics.\n";
+
+	return 0;
+}
@@ -0,0 +1,359 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include <algorithm>
+#include <functional>
+
+namespace Otter
+{
+
+enum ReplayMode
+{
+	Http1Mode = 0,
+	Http2Mode,
+	ForcedHttp2Mode
+};
+
+struct RecordedResource final
+{
+	QString path;
+	int size = 0;
+	int latency = 0;
+};
+
+struct ReplayResult final
+{
+	qint64 loadTime = 0;
+	int connectionsAmount = -1;
+	int http2RepliesAmount = 0;
+	int fallbacksAmount = 0;
+	int skippedAttemptsAmount = 0;
+	int failedRequestsAmount = 0;
+};
+
+QVector<RecordedResource> loadRecording(const QString &path)
+{
+	QFile file(path);
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return {};
+	}
+
+	QVector<RecordedResource> resources;
+	QTextStream stream(&file);
+
+	while (!stream.atEnd())
+	{
+		const QString line(stream.readLine().trimmed());
+
+		if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+		{
+			continue;
+		}
+
+		const QStringList fields(line.split(QLatin1Char(' '), Qt::SkipEmptyParts));
+
+		if (fields.count() < 3)
+		{
+			continue;
+		}
+
+		RecordedResource resource;
+		resource.path = fields.at(0);
+		resource.size = fields.at(1).toInt();
+		resource.latency = fields.at(2).toInt();
+
+		resources.append(resource);
+	}
+
+	return resources;
+}
+
+class ReplayServer final
+{
+public:
+	explicit ReplayServer(const QVector<RecordedResource> &resources) :
+		m_connectionsAmount(0)
+	{
+		for (int i = 0; i < resources.count(); ++i)
+		{
+			m_resources[resources.at(i).path] = resources.at(i);
+		}
+
+		QObject::connect(&m_server, &QTcpServer::newConnection, [&]()
+		{
+			while (m_server.hasPendingConnections())
+			{
+				QTcpSocket *socket(m_server.nextPendingConnection());
+
+				++m_connectionsAmount;
+
+				QObject::connect(socket, &QTcpSocket::readyRead, socket, [=]()
+				{
+					handleRequests(socket);
+				});
+				QObject::connect(socket, &QTcpSocket::disconnected, socket, [=]()
+				{
+					m_buffers.remove(socket);
+
+					socket->deleteLater();
+				});
+			}
+		});
+	}
+
+	void resetStatistics()
+	{
+		m_connectionsAmount = 0;
+	}
+
+	QUrl getUrl() const
+	{
+		return QUrl(QStringLiteral("http://127.0.0.1:%1/").arg(m_server.serverPort()));
+	}
+
+	int getConnectionsAmount() const
+	{
+		return m_connectionsAmount;
+	}
+
+	bool listen()
+	{
+		return m_server.listen(QHostAddress::LocalHost);
+	}
+
+protected:
+	void handleRequests(QTcpSocket *socket)
+	{
+		QByteArray &buffer(m_buffers[socket]);
+		buffer.append(socket->readAll());
+
+		int headerEnd(buffer.indexOf("\r\n\r\n"));
+
+		while (headerEnd >= 0)
+		{
+			const QByteArray requestLine(buffer.left(buffer.indexOf("\r\n")));
+			const QString path(QString::fromLatin1(requestLine.split(' ').value(1)));
+
+			buffer.remove(0, (headerEnd + 4));
+
+			if (m_resources.contains(path))
+			{
+				const RecordedResource resource(m_resources.value(path));
+				const QPointer<QTcpSocket> pointer(socket);
+
+				QTimer::singleShot(resource.latency, socket, [=]()
+				{
+					if (pointer)
+					{
+						pointer->write(QByteArrayLiteral("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: ") + QByteArray::number(resource.size) + QByteArrayLiteral("\r\nConnection: keep-alive\r\n\r\n"));
+						pointer->write(QByteArray(resource.size, 'x'));
+					}
+				});
+			}
+			else
+			{
+				socket->write(QByteArrayLiteral("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n"));
+			}
+
+			headerEnd = buffer.indexOf("\r\n\r\n");
+		}
+	}
+
+private:
+	QTcpServer m_server;
+	QHash<QString, RecordedResource> m_resources;
+	QHash<QTcpSocket*, QByteArray> m_buffers;
+	int m_connectionsAmount;
+};
+
+ReplayResult replay(const QUrl &baseUrl, const QVector<RecordedResource> &resources, ReplayMode mode)
+{
+	QNetworkAccessManager networkManager;
+	QEventLoop eventLoop;
+	QElapsedTimer timer;
+	QSet<QString> incompatibleHosts;
+	ReplayResult result;
+	int pendingRequests(0);
+	std::function<void(int, bool)> sendRequest;
+
+	sendRequest = [&](int index, bool canAttemptHttp2)
+	{
+		const QUrl url(baseUrl.resolved(QUrl(resources.at(index).path)));
+		const bool isHttp2Attempt(mode != Http1Mode && canAttemptHttp2 && !incompatibleHosts.contains(url.authority()));
+
+		if (mode != Http1Mode && canAttemptHttp2 && !isHttp2Attempt)
+		{
+			++result.skippedAttemptsAmount;
+		}
+
+		QNetworkRequest request(url);
+		request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, isHttp2Attempt);
+		request.setAttribute(QNetworkRequest::Http2DirectAttribute, (isHttp2Attempt && mode == ForcedHttp2Mode));
+		request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+		QNetworkReply *reply(networkManager.get(request));
+
+		++pendingRequests;
+
+		QObject::connect(reply, &QNetworkReply::finished, &eventLoop, [&, reply, index, url, isHttp2Attempt]()
+		{
+			--pendingRequests;
+
+			reply->readAll();
+			reply->deleteLater();
+
+			if (isHttp2Attempt && reply->error() == QNetworkReply::ProtocolFailure && !reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid())
+			{
+				++result.fallbacksAmount;
+
+				incompatibleHosts.insert(url.authority());
+
+				sendRequest(index, false);
+
+				return;
+			}
+
+			if (reply->error() != QNetworkReply::NoError)
+			{
+				++result.failedRequestsAmount;
+			}
+
+			if (reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool())
+			{
+				++result.http2RepliesAmount;
+			}
+
+			if (index == 0)
+			{
+				for (int i = 1; i < resources.count(); ++i)
+				{
+					sendRequest(i, true);
+				}
+			}
+
+			if (pendingRequests == 0)
+			{
+				eventLoop.quit();
+			}
+		});
+	};
+
+	timer.start();
+
+	sendRequest(0, true);
+
+	eventLoop.exec();
+
+	result.loadTime = timer.elapsed();
+
+	return result;
+}
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication application(argc, argv);
+	application.setApplicationName(QLatin1String("otter-browser-benchmark-http2"));
+
+	QCommandLineParser commandLineParser;
+	commandLineParser.setApplicationDescription(QLatin1String("Replays a recorded page load with HTTP/2 disallowed, allowed and forced, mirroring the QtWebKit backend fallback to HTTP/1.1 and its cache of incompatible hosts, reporting load times and connection counts."));
+	commandLineParser.addHelpOption();
+	commandLineParser.addPositionalArgument(QLatin1String("recording"), QLatin1String("Recorded page load to replay."), QLatin1String("[recording]"));
+	commandLineParser.addOption(QCommandLineOption(QLatin1String("base-url"), QLatin1String("Replays against an external server serving the recorded paths instead of the built-in one, needed to negotiate HTTP/2 over TLS."), QLatin1String("url")));
+	commandLineParser.addOption(QCommandLineOption(QLatin1String("iterations"), QLatin1String("Sets amount of replays per mode."), QLatin1String("amount"), QLatin1String("5")));
+	commandLineParser.process(application);
+
+	const QStringList arguments(commandLineParser.positionalArguments());
+	const QVector<Otter::RecordedResource> resources(Otter::loadRecording(arguments.isEmpty() ? QLatin1String(OTTER_BENCHMARKS_PATH "/http2/pageLoad.txt") : arguments.first()));
+	const int iterations(qMax(1, commandLineParser.value(QLatin1String("iterations")).toInt()));
+	QTextStream stream(stdout);
+
+	if (resources.isEmpty())
+	{
+		stream << "Failed to load page recording\n";
+
+		return 1;
+	}
+
+	Otter::ReplayServer server(resources);
+	QUrl baseUrl(commandLineParser.value(QLatin1String("base-url")));
+	const bool isExternal(baseUrl.isValid() && !baseUrl.isEmpty());
+
+	if (!isExternal)
+	{
+		if (!server.listen())
+		{
+			stream << "Failed to start replay server\n";
+
+			return 1;
+		}
+
+		baseUrl = server.getUrl();
+	}
+
+	stream << "Replaying " << resources.count() << " requests against " << baseUrl.toString() << ", " << iterations << " iterations per mode\n\n";
+	stream << QStringLiteral("%1%2%3%4%5%6%7%8\n").arg(QLatin1String("Mode"), -16).arg(QLatin1String("Median (ms)"), 14).arg(QLatin1String("Best (ms)"), 12).arg(QLatin1String("Connections"), 14).arg(QLatin1String("HTTP/2 replies"), 16).arg(QLatin1String("Fallbacks"), 11).arg(QLatin1String("Cached"), 8).arg(QLatin1String("Failures"), 10);
+
+	const QStringList modeNames({QLatin1String("HTTP/1.1 only"), QLatin1String("HTTP/2 allowed"), QLatin1String("HTTP/2 forced")});
+
+	for (int mode = Otter::Http1Mode; mode <= Otter::ForcedHttp2Mode; ++mode)
+	{
+		QVector<qint64> loadTimes;
+		Otter::ReplayResult lastResult;
+
+		for (int i = 0; i < iterations; ++i)
+		{
+			server.resetStatistics();
+
+			lastResult = Otter::replay(baseUrl, resources, static_cast<Otter::ReplayMode>(mode));
+			lastResult.connectionsAmount = (isExternal ? -1 : server.getConnectionsAmount());
+
+			loadTimes.append(lastResult.loadTime);
+		}
+
+		std::sort(loadTimes.begin(), loadTimes.end());
+
+		stream << QStringLiteral("%1%2%3%4%5%6%7%8\n").arg(modeNames.at(mode), -16).arg(loadTimes.at(loadTimes.count() / 2), 14).arg(loadTimes.first(), 12).arg(((lastResult.connectionsAmount < 0) ? QLatin1String("n/a") : QString::number(lastResult.connectionsAmount)), 14).arg(lastResult.http2RepliesAmount, 16).arg(lastResult.fallbacksAmount, 11).arg(lastResult.skippedAttemptsAmount, 8).arg(lastResult.failedRequestsAmount, 10);
+	}
+
+	if (!isExternal)
+	{
+		stream << "\nThe built-in server speaks plain HTTP/1.1, so the forced mode fails its direct HTTP/2 attempts with a protocol error and falls back, while later requests skip the attempt; pass --base-url with an HTTPS server offering HTTP/2 to compare protocols.\n";
+	}
+
+	return 0;
+}
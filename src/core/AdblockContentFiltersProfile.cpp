@@ -23,11 +23,14 @@
 #include "Console.h"
 #include "Job.h"
 #include "SessionsManager.h"
+#include "TasksManager.h"
 #include "../ui/ContentBlockingProfileDialog.h"
 
 #include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QBuffer>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFileInfo>
 #include <QtCore/QSaveFile>
 #include <QtCore/QTextStream>
@@ -46,6 +49,8 @@ AdblockContentFiltersProfile::AdblockContentFiltersProfile(const ContentFiltersP
 	m_profileSummary(profileSummary),
 	m_error(NoError),
 	m_flags(flags),
+	m_updateTask(0),
+	m_isDifferentialUpdate(false),
 	m_wasLoaded(false)
 {
 	if (!languages.isEmpty())
@@ -124,9 +129,25 @@ void AdblockContentFiltersProfile::loadHeader()
 		m_profileSummary.title = information.title;
 	}
 
-	if (!m_dataFetchJob && m_profileSummary.updateInterval > 0 && (!m_profileSummary.lastUpdate.isValid() || m_profileSummary.lastUpdate.daysTo(QDateTime::currentDateTimeUtc()) > m_profileSummary.updateInterval))
+	m_diffPath = information.diffPath;
+
+	if (m_updateTask != 0)
 	{
-		update();
+		TasksManager::removeTask(m_updateTask);
+
+		m_updateTask = 0;
+	}
+
+	if (!m_dataFetchJob && m_profileSummary.updateInterval > 0)
+	{
+		const qint64 remainingTime(m_profileSummary.lastUpdate.isValid() ? QDateTime::currentDateTimeUtc().secsTo(m_profileSummary.lastUpdate.addDays(m_profileSummary.updateInterval)) : 0);
+
+		m_updateTask = TasksManager::registerTask(static_cast<uint>(qMax(static_cast<qint64>(30), remainingTime)), true, [&]()
+		{
+			TasksManager::updateTask(m_updateTask, (m_profileSummary.updateInterval * 86400), true);
+
+			update();
+		}, this, TasksManager::NetworkTask);
 	}
 }
 
@@ -593,19 +614,62 @@ void AdblockContentFiltersProfile::handleJobFinished(bool isSuccess)
 	}
 
 	QIODevice *device(m_dataFetchJob->getData());
+	const QUrl url(m_dataFetchJob->getUrl());
+	const bool isDifferentialUpdate(m_isDifferentialUpdate);
+	const bool isNotModified(isSuccess && m_dataFetchJob->isNotModified());
 
 	m_dataFetchJob->deleteLater();
 	m_dataFetchJob = nullptr;
 
-	if (!isSuccess)
+	m_isDifferentialUpdate = false;
+
+	QByteArray data;
+
+	if (isDifferentialUpdate)
 	{
-		raiseError(QCoreApplication::translate("main", "Failed to update content blocking profile: %1").arg(device ? device->errorString() : tr("Download failure")), DownloadError);
+		if (isSuccess && device)
+		{
+			data = applyDifferentialUpdate(device->readAll());
+		}
 
-		return;
+		if (data.isEmpty())
+		{
+			DataFetchJob::confirmValidators(url, false);
+
+			update(m_profileSummary.updateUrl);
+
+			return;
+		}
+
+		TasksManager::reportTaskResult(m_updateTask, true);
+	}
+	else
+	{
+		TasksManager::reportTaskResult(m_updateTask, isSuccess);
+
+		if (!isSuccess)
+		{
+			raiseError(QCoreApplication::translate("main", "Failed to update content blocking profile: %1").arg(device ? device->errorString() : tr("Download failure")), DownloadError);
+
+			return;
+		}
+
+		if (isNotModified)
+		{
+			m_profileSummary.lastUpdate = QDateTime::currentDateTimeUtc();
+
+			loadHeader();
+
+			emit profileModified();
+
+			return;
+		}
+
+		data = device->readAll();
 	}
 
 	QBuffer buffer;
-	buffer.setData(device->readAll());
+	buffer.setData(data);
 	buffer.open(QIODevice::ReadOnly | QIODevice::Text);
 
 	const HeaderInformation information(loadHeader(&buffer));
@@ -614,6 +678,8 @@ void AdblockContentFiltersProfile::handleJobFinished(bool isSuccess)
 
 	if (information.hasError())
 	{
+		DataFetchJob::confirmValidators(url, false);
+
 		raiseError(information.errorString, information.error);
 
 		return;
@@ -625,6 +691,8 @@ void AdblockContentFiltersProfile::handleJobFinished(bool isSuccess)
 
 	if (!file.open(QIODevice::WriteOnly))
 	{
+		DataFetchJob::confirmValidators(url, false);
+
 		raiseError(QCoreApplication::translate("main", "Failed to update content blocking profile: %1").arg(file.errorString()), DownloadError);
 
 		return;
@@ -634,8 +702,14 @@ void AdblockContentFiltersProfile::handleJobFinished(bool isSuccess)
 
 	m_profileSummary.lastUpdate = QDateTime::currentDateTimeUtc();
 
-	if (!file.commit())
+	if (file.commit())
 	{
+		DataFetchJob::confirmValidators(url, true);
+	}
+	else
+	{
+		DataFetchJob::confirmValidators(url, false);
+
 		Console::addMessage(QCoreApplication::translate("main", "Failed to update content blocking profile: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
 	}
 
@@ -782,6 +856,160 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::evaluateNodeRul
 	return result;
 }
 
+QByteArray AdblockContentFiltersProfile::applyDifferentialUpdate(const QByteArray &patch) const
+{
+	QFile file(getPath());
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return {};
+	}
+
+	const QList<QByteArray> lines(file.readAll().split('\n'));
+
+	file.close();
+
+	const QByteArray name(QUrl(m_diffPath).fragment().toUtf8());
+	const QList<QByteArray> patchLines(patch.split('\n'));
+	QByteArray checksum;
+	int patchBegin(0);
+	int patchEnd(patchLines.count());
+
+	if (!patchLines.isEmpty() && patchLines.first().startsWith("diff "))
+	{
+		patchEnd = -1;
+
+		for (int i = 0; i < patchLines.count(); ++i)
+		{
+			if (!patchLines.at(i).startsWith("diff "))
+			{
+				continue;
+			}
+
+			const QList<QByteArray> fields(patchLines.at(i).mid(5).split(' '));
+			QByteArray blockName;
+			int blockLines(-1);
+
+			for (int j = 0; j < fields.count(); ++j)
+			{
+				if (fields.at(j).startsWith("name:"))
+				{
+					blockName = fields.at(j).mid(5);
+				}
+				else if (fields.at(j).startsWith("lines:"))
+				{
+					blockLines = fields.at(j).mid(6).toInt();
+				}
+				else if (fields.at(j).startsWith("checksum:"))
+				{
+					checksum = fields.at(j).mid(9);
+				}
+			}
+
+			if (blockLines < 0)
+			{
+				return {};
+			}
+
+			if (name.isEmpty() || blockName == name)
+			{
+				patchBegin = (i + 1);
+				patchEnd = qMin((patchBegin + blockLines), patchLines.count());
+
+				break;
+			}
+
+			checksum.clear();
+
+			i += blockLines;
+		}
+
+		if (patchEnd < 0)
+		{
+			return {};
+		}
+	}
+
+	QList<QByteArray> result;
+	result.reserve(lines.count());
+
+	int position(0);
+	int i(patchBegin);
+
+	while (i < patchEnd)
+	{
+		const QByteArray command(patchLines.at(i).trimmed());
+
+		++i;
+
+		if (command.isEmpty())
+		{
+			continue;
+		}
+
+		const QList<QByteArray> arguments(command.mid(1).split(' '));
+		const int line(arguments.value(0).toInt());
+		const int amount(arguments.value(1).toInt());
+
+		if (arguments.count() != 2 || line < 0 || amount <= 0)
+		{
+			return {};
+		}
+
+		if (command.at(0) == 'a')
+		{
+			if (line < position || line > lines.count() || (i + amount) > patchEnd)
+			{
+				return {};
+			}
+
+			for (; position < line; ++position)
+			{
+				result.append(lines.at(position));
+			}
+
+			for (int j = 0; j < amount; ++j)
+			{
+				result.append(patchLines.at(i + j));
+			}
+
+			i += amount;
+		}
+		else if (command.at(0) == 'd')
+		{
+			if (line < 1 || (line - 1) < position || (line - 1 + amount) > lines.count())
+			{
+				return {};
+			}
+
+			for (; position < (line - 1); ++position)
+			{
+				result.append(lines.at(position));
+			}
+
+			position += amount;
+		}
+		else
+		{
+			return {};
+		}
+	}
+
+	for (; position < lines.count(); ++position)
+	{
+		result.append(lines.at(position));
+	}
+
+	const QByteArray data(result.join('\n'));
+
+	if (!checksum.isEmpty() && !QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex().startsWith(checksum))
+	{
+		return {};
+	}
+
+	return data;
+}
+
 AdblockContentFiltersProfile::HeaderInformation AdblockContentFiltersProfile::loadHeader(QIODevice *rulesDevice)
 {
 	HeaderInformation information;
@@ -807,11 +1035,13 @@ AdblockContentFiltersProfile::HeaderInformation AdblockContentFiltersProfile::lo
 		if (line.startsWith(QLatin1String("! Title: ")))
 		{
 			information.title = line.section(QLatin1Char(':'), 1).trimmed();
-
-			break;
+		}
+		else if (line.startsWith(QLatin1String("! Diff-Path: ")))
+		{
+			information.diffPath = line.section(QLatin1Char(':'), 1).trimmed();
 		}
 
-		if (lineNumber > 50)
+		if ((!information.title.isEmpty() && !information.diffPath.isEmpty()) || lineNumber > 50)
 		{
 			break;
 		}
@@ -1041,6 +1271,9 @@ bool AdblockContentFiltersProfile::loadRules()
 
 	m_wasLoaded = true;
 
+	QElapsedTimer timer;
+	timer.start();
+
 	if (m_domainExpression.pattern().isEmpty())
 	{
 		m_domainExpression = QRegularExpression(QLatin1String("[:\?&/=]"));
@@ -1063,6 +1296,8 @@ bool AdblockContentFiltersProfile::loadRules()
 
 	file.close();
 
+	setLoadTime(timer.nsecsElapsed());
+
 	return true;
 }
 
@@ -1089,7 +1324,14 @@ bool AdblockContentFiltersProfile::update(const QUrl &url)
 		return false;
 	}
 
-	m_dataFetchJob = new DataFetchJob(updateUrl, this);
+	m_isDifferentialUpdate = (!url.isValid() && !m_diffPath.isEmpty() && QFile::exists(getPath()));
+
+	m_dataFetchJob = new DataFetchJob((m_isDifferentialUpdate ? updateUrl.resolved(QUrl(m_diffPath)).adjusted(QUrl::RemoveFragment) : updateUrl), this);
+
+	if (!m_isDifferentialUpdate)
+	{
+		m_dataFetchJob->setConditional(QFile::exists(getPath()));
+	}
 
 	connect(m_dataFetchJob, &Job::jobFinished, this, &AdblockContentFiltersProfile::handleJobFinished);
 	connect(m_dataFetchJob, &Job::progressChanged, this, &AdblockContentFiltersProfile::updateProgressChanged);
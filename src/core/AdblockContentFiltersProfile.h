@@ -47,6 +47,7 @@ public:
 	struct HeaderInformation final
 	{
 		QString title;
+		QString diffPath;
 		QString errorString;
 		QUrl updateUrl;
 		ProfileError error = NoError;
@@ -156,6 +157,7 @@ protected:
 	ContentFiltersManager::CheckResult checkUrlSubstring(const Node *node, const QString &subString, QString currentRule, const Request &request) const;
 	ContentFiltersManager::CheckResult checkRuleMatch(const Node::Rule *rule, const QString &currentRule, const Request &request) const;
 	ContentFiltersManager::CheckResult evaluateNodeRules(const Node *node, const QString &currentRule, const Request &request) const;
+	QByteArray applyDifferentialUpdate(const QByteArray &patch) const;
 	bool loadRules();
 	bool resolveDomainExceptions(const QString &url, const QStringList &ruleList) const;
 
@@ -168,12 +170,15 @@ private:
 	DataFetchJob *m_dataFetchJob;
 	ProfileSummary m_profileSummary;
 	QRegularExpression m_domainExpression;
+	QString m_diffPath;
 	QStringList m_cosmeticFiltersRules;
 	QVector<QLocale::Language> m_languages;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainRules;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainExceptions;
 	ProfileError m_error;
 	ProfileFlags m_flags;
+	quint64 m_updateTask;
+	bool m_isDifferentialUpdate;
 	bool m_wasLoaded;
 
 	static QHash<QString, RuleOption> m_options;
@@ -22,6 +22,7 @@
 #include "AddonsManager.h"
 #include "BookmarksManager.h"
 #include "Console.h"
+#include "ContentFiltersManager.h"
 #include "FeedsManager.h"
 #include "GesturesManager.h"
 #include "HandlersManager.h"
@@ -39,6 +40,7 @@
 #include "TasksManager.h"
 #include "ToolBarsManager.h"
 #include "ThemesManager.h"
+#include "ThumbnailsManager.h"
 #include "TransfersManager.h"
 #include "Utils.h"
 #include "Updater.h"
@@ -64,6 +66,7 @@
 
 #include <QtCore/QCryptographicHash>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QLibraryInfo>
@@ -71,6 +74,7 @@
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtGui/QDesktopServices>
 #include <QtNetwork/QLocalSocket>
@@ -95,6 +99,7 @@ QPointer<QObject> Application::m_nonMenuFocusObject(nullptr);
 QString Application::m_localePath;
 QCommandLineParser Application::m_commandLineParser;
 QVector<MainWindow*> Application::m_windows;
+QVector<Application::StartupPhase> Application::m_startupProfile;
 bool Application::m_isAboutToQuit(false);
 bool Application::m_isFirstRun(false);
 bool Application::m_isHidden(false);
@@ -261,6 +266,11 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv),
 			{
 				reportOptions |= SettingsReport;
 			}
+
+			if (rawReportOptions.contains(QLatin1String("startup")))
+			{
+				reportOptions |= StartupReport;
+			}
 		}
 
 		if (rawReportOptions.contains(QLatin1String("dialog")))
@@ -409,39 +419,41 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv),
 		return;
 	}
 
-	TasksManager::createInstance();
+	runStartupPhase(QLatin1String("TasksManager"), &TasksManager::createInstance);
 
-	ThemesManager::createInstance();
+	runStartupPhase(QLatin1String("ThemesManager"), &ThemesManager::createInstance);
 
-	ActionsManager::createInstance();
+	runStartupPhase(QLatin1String("ActionsManager"), &ActionsManager::createInstance);
 
-	AddonsManager::createInstance();
+	runStartupPhase(QLatin1String("AddonsManager"), &AddonsManager::createInstance);
 
-	BookmarksManager::createInstance();
+	runStartupPhase(QLatin1String("BookmarksManager"), &BookmarksManager::createInstance);
 
-	FeedsManager::createInstance();
+	runStartupPhase(QLatin1String("FeedsManager"), &FeedsManager::createInstance);
 
-	GesturesManager::createInstance();
+	runStartupPhase(QLatin1String("GesturesManager"), &GesturesManager::createInstance);
 
-	HandlersManager::createInstance();
+	runStartupPhase(QLatin1String("HandlersManager"), &HandlersManager::createInstance);
 
-	HistoryManager::createInstance();
+	runStartupPhase(QLatin1String("HistoryManager"), &HistoryManager::createInstance);
 
-	NetworkManagerFactory::createInstance();
+	runStartupPhase(QLatin1String("NetworkManagerFactory"), &NetworkManagerFactory::createInstance);
 
-	NotesManager::createInstance();
+	runStartupPhase(QLatin1String("NotesManager"), &NotesManager::createInstance);
 
-	NotificationsManager::createInstance();
+	runStartupPhase(QLatin1String("NotificationsManager"), &NotificationsManager::createInstance);
 
-	PasswordsManager::createInstance();
+	runStartupPhase(QLatin1String("PasswordsManager"), &PasswordsManager::createInstance);
 
-	SearchEnginesManager::createInstance();
+	runStartupPhase(QLatin1String("SearchEnginesManager"), &SearchEnginesManager::createInstance);
 
-	SpellCheckManager::createInstance();
+	runStartupPhase(QLatin1String("SpellCheckManager"), &SpellCheckManager::createInstance);
 
-	ToolBarsManager::createInstance();
+	runStartupPhase(QLatin1String("ThumbnailsManager"), &ThumbnailsManager::createInstance);
 
-	TransfersManager::createInstance();
+	runStartupPhase(QLatin1String("ToolBarsManager"), &ToolBarsManager::createInstance);
+
+	runStartupPhase(QLatin1String("TransfersManager"), &TransfersManager::createInstance);
 
 	setLocale(SettingsManager::getOption(SettingsManager::Browser_LocaleOption).toString());
 	setQuitOnLastWindowClosed(true);
@@ -515,6 +527,17 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv),
 			m_nonMenuFocusObject = object;
 		}
 	});
+
+	QTimer::singleShot(2000, this, [&]()
+	{
+		if (m_isAboutToQuit)
+		{
+			return;
+		}
+
+		runStartupPhase(QLatin1String("FeedsManager"), &FeedsManager::ensureInitialized, true);
+		runStartupPhase(QLatin1String("SpellCheckManager"), &SpellCheckManager::ensureInitialized, true);
+	});
 }
 
 Application::~Application()
@@ -937,6 +960,21 @@ void Application::scheduleUpdateCheck(int interval)
 	});
 }
 
+void Application::runStartupPhase(const QString &name, const std::function<void()> &function, bool isDeferred)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	function();
+
+	StartupPhase phase;
+	phase.name = name;
+	phase.duration = timer.nsecsElapsed();
+	phase.isDeferred = isDeferred;
+
+	m_startupProfile.append(phase);
+}
+
 void Application::handleOptionChanged(int identifier, const QVariant &value)
 {
 	switch (identifier)
@@ -983,6 +1021,8 @@ void Application::handleAboutToQuit()
 		m_localServer->close();
 	}
 
+	TasksManager::flush();
+
 	QStringList clearSettings(SettingsManager::getOption(SettingsManager::History_ClearOnCloseOption).toStringList());
 	clearSettings.removeAll({});
 
@@ -1437,6 +1477,33 @@ QString Application::createReport(ReportOptions options)
 		report.sections.append(SettingsManager::createReport());
 	}
 
+	if (options.testFlag(StartupReport) && !m_startupProfile.isEmpty())
+	{
+		DiagnosticReport::Section startupReport;
+		startupReport.title = QLatin1String("Startup");
+		startupReport.fieldWidths = {30, 15, 0};
+		startupReport.entries.reserve(m_startupProfile.count());
+
+		for (int i = 0; i < m_startupProfile.count(); ++i)
+		{
+			const StartupPhase phase(m_startupProfile.at(i));
+
+			startupReport.entries.append({phase.name, QString::number((static_cast<double>(phase.duration) / 1000000), 'f', 2) + QLatin1String(" ms"), (phase.isDeferred ? QLatin1String("deferred") : QLatin1String("initial"))});
+		}
+
+		report.sections.append(startupReport);
+	}
+
+	if (options.testFlag(ContentBlockingReport))
+	{
+		const DiagnosticReport::Section contentBlockingReport(ContentFiltersManager::createReport());
+
+		if (!contentBlockingReport.entries.isEmpty())
+		{
+			report.sections.append(contentBlockingReport);
+		}
+	}
+
 	if (options.testFlag(KeyboardShortcutsReport))
 	{
 		report.sections.append(ActionsManager::createReport());
@@ -1684,6 +1751,11 @@ QVector<MainWindow*> Application::getWindows()
 	return m_windows;
 }
 
+QVector<Application::StartupPhase> Application::getStartupProfile()
+{
+	return m_startupProfile;
+}
+
 bool Application::canClose()
 {
 	if (TransfersManager::hasRunningTransfers() && SettingsManager::getOption(SettingsManager::Choices_WarnQuitTransfersOption).toBool())
@@ -29,6 +29,8 @@
 #include <QtWidgets/QApplication>
 #include <QtNetwork/QLocalServer>
 
+#include <functional>
+
 namespace Otter
 {
 
@@ -51,8 +53,10 @@ public:
 		KeyboardShortcutsReport = 2,
 		PathsReport = 4,
 		SettingsReport = 8,
-		StandardReport = (EnvironmentReport | PathsReport | SettingsReport),
-		FullReport = (EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport)
+		StartupReport = 16,
+		ContentBlockingReport = 32,
+		StandardReport = (ContentBlockingReport | EnvironmentReport | PathsReport | SettingsReport | StartupReport),
+		FullReport = (ContentBlockingReport | EnvironmentReport | KeyboardShortcutsReport | PathsReport | SettingsReport | StartupReport)
 	};
 
 	Q_DECLARE_FLAGS(ReportOptions, ReportOption)
@@ -63,6 +67,13 @@ public:
 		QVector<QStringList> records;
 	};
 
+	struct StartupPhase final
+	{
+		QString name;
+		qint64 duration = 0;
+		bool isDeferred = false;
+	};
+
 	explicit Application(int &argc, char **argv);
 	~Application();
 
@@ -84,6 +95,7 @@ public:
 	static QString getApplicationDirectoryPath();
 	ActionsManager::ActionDefinition::State getActionState(int identifier, const QVariantMap &parameters = {}) const override;
 	static QVector<MainWindow*> getWindows();
+	static QVector<StartupPhase> getStartupProfile();
 	static bool canClose();
 	static bool isAboutToQuit();
 	static bool isFirstRun();
@@ -96,6 +108,7 @@ public slots:
 
 protected:
 	void scheduleUpdateCheck(int interval);
+	static void runStartupPhase(const QString &name, const std::function<void()> &function, bool isDeferred = false);
 	static void setLocale(const QString &locale);
 
 protected slots:
@@ -121,6 +134,7 @@ private:
 	static QString m_localePath;
 	static QCommandLineParser m_commandLineParser;
 	static QVector<MainWindow*> m_windows;
+	static QVector<StartupPhase> m_startupProfile;
 	static bool m_isAboutToQuit;
 	static bool m_isFirstRun;
 	static bool m_isHidden;
@@ -21,6 +21,7 @@
 #include "BookmarksManager.h"
 #include "Application.h"
 #include "SessionsManager.h"
+#include "TasksManager.h"
 
 #include <QtCore/QDateTime>
 
@@ -31,26 +32,10 @@ BookmarksManager* BookmarksManager::m_instance(nullptr);
 BookmarksModel* BookmarksManager::m_model(nullptr);
 qulonglong BookmarksManager::m_lastUsedFolder(0);
 
-BookmarksManager::BookmarksManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+BookmarksManager::BookmarksManager(QObject *parent) : QObject(parent)
 {
 }
 
-void BookmarksManager::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == m_saveTimer)
-	{
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		if (m_model)
-		{
-			m_model->save(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
-		}
-	}
-}
-
 void BookmarksManager::createInstance()
 {
 	if (!m_instance)
@@ -78,21 +63,31 @@ void BookmarksManager::scheduleSave()
 {
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		if (m_model)
 		{
 			m_model->save(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
 		}
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(1000);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			if (!m_model)
+			{
+				return;
+			}
+
+			if (Application::isAboutToQuit())
+			{
+				m_model->save(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
+			}
+			else
+			{
+				m_model->saveInBackground(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
+			}
+		});
 	}
 }
 
@@ -49,15 +49,12 @@ public:
 protected:
 	explicit BookmarksManager(QObject *parent);
 
-	void timerEvent(QTimerEvent *event) override;
 	static void ensureInitialized();
 
 protected slots:
 	void scheduleSave();
 
 private:
-	int m_saveTimer;
-
 	static BookmarksManager *m_instance;
 	static BookmarksModel *m_model;
 	static qulonglong m_lastUsedFolder;
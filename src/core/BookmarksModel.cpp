@@ -23,11 +23,14 @@
 #include "FeedsManager.h"
 #include "HistoryManager.h"
 #include "SessionsManager.h"
+#include "TasksManager.h"
 #include "ThemesManager.h"
 #include "Utils.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QMimeData>
 #include <QtCore/QSaveFile>
 #include <QtWidgets/QMessageBox>
@@ -375,6 +378,7 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 	m_rootItem(new Bookmark()),
 	m_trashItem(new Bookmark()),
 	m_importTargetItem(nullptr),
+	m_saveWatcher(new QFutureWatcher<void>(this)),
 	m_mode(mode)
 {
 	m_rootItem->setData(RootBookmark, TypeRole);
@@ -387,47 +391,77 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 	appendRow(m_trashItem);
 	setItemPrototype(new Bookmark());
 
+	connect(m_saveWatcher, &QFutureWatcher<void>::finished, this, [&]()
+	{
+		if (!m_savePath.isEmpty())
+		{
+			const QString savePath(m_savePath);
+
+			m_savePath.clear();
+
+			saveInBackground(savePath);
+		}
+	});
+
 	if (!QFile::exists(path))
 	{
 		return;
 	}
 
-	QFile file(path);
-	const bool isNotes(m_mode == NotesMode);
-
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	if (!loadCache(path))
 	{
-		Console::addMessage((isNotes ? tr("Failed to open notes file: %1") : tr("Failed to open bookmarks file: %1")).arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+		QFile file(path);
+		const bool isNotes(m_mode == NotesMode);
 
-		return;
-	}
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			Console::addMessage((isNotes ? tr("Failed to open notes file: %1") : tr("Failed to open bookmarks file: %1")).arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
 
-	QXmlStreamReader reader(&file);
+			return;
+		}
 
-	if (reader.readNextStartElement() && reader.name() == QLatin1String("xbel") && reader.attributes().value(QLatin1String("version")).toString() == QLatin1String("1.0"))
-	{
-		while (reader.readNextStartElement())
+		QXmlStreamReader reader(&file);
+
+		if (reader.readNextStartElement() && reader.name() == QLatin1String("xbel") && reader.attributes().value(QLatin1String("version")).toString() == QLatin1String("1.0"))
 		{
-			if (reader.name() == QLatin1String("folder") || reader.name() == QLatin1String("bookmark") || reader.name() == QLatin1String("separator"))
-			{
-				readBookmark(&reader, m_rootItem);
-			}
-			else
+			while (reader.readNextStartElement())
 			{
-				reader.skipCurrentElement();
-			}
+				if (reader.name() == QLatin1String("folder") || reader.name() == QLatin1String("bookmark") || reader.name() == QLatin1String("separator"))
+				{
+					readBookmark(&reader, m_rootItem);
+				}
+				else
+				{
+					reader.skipCurrentElement();
+				}
 
-			if (reader.hasError())
-			{
-				m_rootItem->removeRows(0, m_rootItem->rowCount());
+				if (reader.hasError())
+				{
+					m_rootItem->removeRows(0, m_rootItem->rowCount());
 
-				Console::addMessage((isNotes ? tr("Failed to load notes file: %1") : tr("Failed to load bookmarks file: %1")).arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+					Console::addMessage((isNotes ? tr("Failed to load notes file: %1") : tr("Failed to load bookmarks file: %1")).arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
 
-				QMessageBox::warning(nullptr, tr("Error"), (isNotes ? tr("Failed to load notes file.") : tr("Failed to load bookmarks file.")), QMessageBox::Close);
+					QMessageBox::warning(nullptr, tr("Error"), (isNotes ? tr("Failed to load notes file.") : tr("Failed to load bookmarks file.")), QMessageBox::Close);
 
-				return;
+					return;
+				}
 			}
 		}
+
+		file.close();
+
+		if (!SessionsManager::isReadOnly())
+		{
+			const QFileInfo information(path);
+			const QVector<BookmarkInformation> bookmarks(createSnapshot());
+			const qint64 size(information.size());
+			const qint64 timestamp(information.lastModified().toMSecsSinceEpoch());
+
+			m_saveWatcher->setFuture(TasksManager::runInBackground([=]()
+			{
+				writeCache(path, bookmarks, mode, size, timestamp);
+			}, TasksManager::InputOutputWorker));
+		}
 	}
 
 	connect(this, &BookmarksModel::itemChanged, this, &BookmarksModel::modelModified);
@@ -555,11 +589,22 @@ void BookmarksModel::removeBookmark(Bookmark *bookmark)
 
 	removeBookmarkUrl(bookmark);
 
-	const quint64 identifier(bookmark->data(IdentifierRole).toULongLong());
+	QVector<Bookmark*> bookmarks({bookmark});
 
-	if (identifier > 0 && m_identifiers.contains(identifier))
+	while (!bookmarks.isEmpty())
 	{
-		m_identifiers.remove(identifier);
+		const Bookmark *removedBookmark(bookmarks.takeLast());
+		const quint64 identifier(removedBookmark->data(IdentifierRole).toULongLong());
+
+		if (identifier > 0 && m_identifiers.contains(identifier))
+		{
+			m_identifiers.remove(identifier);
+		}
+
+		for (int i = 0; i < removedBookmark->rowCount(); ++i)
+		{
+			bookmarks.append(removedBookmark->getChild(i));
+		}
 	}
 
 	if (!bookmark->data(KeywordRole).toString().isEmpty() && m_keywords.contains(bookmark->data(KeywordRole).toString()))
@@ -574,6 +619,29 @@ void BookmarksModel::removeBookmark(Bookmark *bookmark)
 	emit modelModified();
 }
 
+void BookmarksModel::saveInBackground(const QString &path)
+{
+	if (SessionsManager::isReadOnly())
+	{
+		return;
+	}
+
+	if (m_saveWatcher->isRunning())
+	{
+		m_savePath = path;
+
+		return;
+	}
+
+	const QVector<BookmarkInformation> bookmarks(createSnapshot());
+	const FormatMode mode(m_mode);
+
+	m_saveWatcher->setFuture(TasksManager::runInBackground([=]()
+	{
+		writeBookmarks(path, bookmarks, mode);
+	}, TasksManager::InputOutputWorker));
+}
+
 void BookmarksModel::readBookmark(QXmlStreamReader *reader, Bookmark *parent)
 {
 	Bookmark *bookmark(nullptr);
@@ -753,125 +821,50 @@ void BookmarksModel::readBookmark(QXmlStreamReader *reader, Bookmark *parent)
 	}
 }
 
-void BookmarksModel::writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark) const
+void BookmarksModel::createSnapshot(Bookmark *bookmark, QVector<BookmarkInformation> *bookmarks) const
 {
-	if (!bookmark)
-	{
-		return;
-	}
+	BookmarkInformation information;
+	information.type = bookmark->getType();
 
-	const QString elementOwner(QLatin1String("http://otter-browser.org/otter-xbel-bookmark"));
-	const BookmarkType type(bookmark->getType());
-	const bool isBookmarks(m_mode == BookmarksMode);
-
-	switch (type)
+	switch (information.type)
 	{
 		case FeedBookmark:
+		case FolderBookmark:
 		case UrlBookmark:
-			writer->writeStartElement(QLatin1String("bookmark"));
-			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark->getRawData(IdentifierRole).toULongLong()));
-
-			if (type == FeedBookmark)
-			{
-				writer->writeAttribute(QLatin1String("feed"), QLatin1String("true"));
-			}
-
-			if (!bookmark->getRawData(UrlRole).toString().isEmpty())
-			{
-				writer->writeAttribute(QLatin1String("href"), bookmark->getRawData(UrlRole).toString());
-			}
-
-			if (bookmark->getRawData(TimeAddedRole).toDateTime().isValid())
-			{
-				writer->writeAttribute(QLatin1String("added"), bookmark->getRawData(TimeAddedRole).toDateTime().toString(Qt::ISODate));
-			}
-
-			if (bookmark->getRawData(TimeModifiedRole).toDateTime().isValid())
-			{
-				writer->writeAttribute(QLatin1String("modified"), bookmark->getRawData(TimeModifiedRole).toDateTime().toString(Qt::ISODate));
-			}
-
-			if (isBookmarks)
-			{
-				if (bookmark->getRawData(TimeVisitedRole).toDateTime().isValid())
-				{
-					writer->writeAttribute(QLatin1String("visited"), bookmark->getRawData(TimeVisitedRole).toDateTime().toString(Qt::ISODate));
-				}
-
-				writer->writeTextElement(QLatin1String("title"), bookmark->getRawData(TitleRole).toString());
-			}
-
-			if (!bookmark->getRawData(DescriptionRole).toString().isEmpty())
-			{
-				writer->writeTextElement(QLatin1String("desc"), bookmark->getRawData(DescriptionRole).toString());
-			}
-
-			if (isBookmarks && (!bookmark->getRawData(KeywordRole).toString().isEmpty() || bookmark->getRawData(VisitsRole).toInt() > 0))
-			{
-				writer->writeStartElement(QLatin1String("info"));
-				writer->writeStartElement(QLatin1String("metadata"));
-				writer->writeAttribute(QLatin1String("owner"), elementOwner);
-
-				if (!bookmark->getRawData(KeywordRole).toString().isEmpty())
-				{
-					writer->writeTextElement(QLatin1String("keyword"), bookmark->getRawData(KeywordRole).toString());
-				}
-
-				if (bookmark->getRawData(VisitsRole).toInt() > 0)
-				{
-					writer->writeTextElement(QLatin1String("visits"), QString::number(bookmark->getRawData(VisitsRole).toInt()));
-				}
-
-				writer->writeEndElement();
-				writer->writeEndElement();
-			}
-
-			writer->writeEndElement();
+			information.title = bookmark->getRawData(TitleRole).toString();
+			information.description = bookmark->getRawData(DescriptionRole).toString();
+			information.keyword = bookmark->getRawData(KeywordRole).toString();
+			information.url = bookmark->getRawData(UrlRole).toString();
+			information.timeAdded = bookmark->getRawData(TimeAddedRole).toDateTime();
+			information.timeModified = bookmark->getRawData(TimeModifiedRole).toDateTime();
+			information.timeVisited = bookmark->getRawData(TimeVisitedRole).toDateTime();
+			information.identifier = bookmark->getRawData(IdentifierRole).toULongLong();
+			information.visits = bookmark->getRawData(VisitsRole).toInt();
 
 			break;
-		case FolderBookmark:
-			writer->writeStartElement(QLatin1String("folder"));
-			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark->getRawData(IdentifierRole).toULongLong()));
-
-			if (bookmark->getRawData(TimeAddedRole).toDateTime().isValid())
-			{
-				writer->writeAttribute(QLatin1String("added"), bookmark->getRawData(TimeAddedRole).toDateTime().toString(Qt::ISODate));
-			}
-
-			if (bookmark->getRawData(TimeModifiedRole).toDateTime().isValid())
-			{
-				writer->writeAttribute(QLatin1String("modified"), bookmark->getRawData(TimeModifiedRole).toDateTime().toString(Qt::ISODate));
-			}
-
-			writer->writeTextElement(QLatin1String("title"), bookmark->getRawData(TitleRole).toString());
+		default:
+			break;
+	}
 
-			if (!bookmark->getRawData(DescriptionRole).toString().isEmpty())
-			{
-				writer->writeTextElement(QLatin1String("desc"), bookmark->getRawData(DescriptionRole).toString());
-			}
+	const int index(bookmarks->count());
 
-			if (isBookmarks && !bookmark->getRawData(KeywordRole).toString().isEmpty())
-			{
-				writer->writeStartElement(QLatin1String("info"));
-				writer->writeStartElement(QLatin1String("metadata"));
-				writer->writeAttribute(QLatin1String("owner"), elementOwner);
-				writer->writeTextElement(QLatin1String("keyword"), bookmark->getRawData(KeywordRole).toString());
-				writer->writeEndElement();
-				writer->writeEndElement();
-			}
+	bookmarks->append(information);
 
-			for (int i = 0; i < bookmark->rowCount(); ++i)
-			{
-				writeBookmark(writer, bookmark->getChild(i));
-			}
+	if (information.type != FolderBookmark && information.type != RootBookmark)
+	{
+		return;
+	}
 
-			writer->writeEndElement();
+	for (int i = 0; i < bookmark->rowCount(); ++i)
+	{
+		Bookmark *childBookmark(bookmark->getChild(i));
 
-			break;
-		default:
-			writer->writeEmptyElement(QLatin1String("separator"));
+		if (childBookmark)
+		{
+			createSnapshot(childBookmark, bookmarks);
 
-			break;
+			++(*bookmarks)[index].childrenAmount;
+		}
 	}
 }
 
@@ -887,7 +880,7 @@ void BookmarksModel::removeBookmarkUrl(Bookmark *bookmark)
 		case FeedBookmark:
 		case UrlBookmark:
 			{
-				const QUrl url(Utils::normalizeUrl(bookmark->data(UrlRole).toUrl()));
+				const UrlKey url(bookmark->data(UrlRole).toUrl());
 
 				if (!url.isEmpty() && m_urls.contains(url))
 				{
@@ -925,7 +918,7 @@ void BookmarksModel::readdBookmarkUrl(Bookmark *bookmark)
 		case FeedBookmark:
 		case UrlBookmark:
 			{
-				const QUrl url(Utils::normalizeUrl(bookmark->data(UrlRole).toUrl()));
+				const UrlKey url(bookmark->data(UrlRole).toUrl());
 
 				if (!url.isEmpty())
 				{
@@ -953,7 +946,7 @@ void BookmarksModel::readdBookmarkUrl(Bookmark *bookmark)
 
 void BookmarksModel::setupFeed(Bookmark *bookmark)
 {
-	const QUrl normalizedUrl(Utils::normalizeUrl(bookmark->getUrl()));
+	const UrlKey normalizedUrl(bookmark->getUrl());
 	Feed *feed(FeedsManager::createFeed(bookmark->getUrl(), bookmark->getTitle()));
 
 	if (!m_feeds.contains(normalizedUrl))
@@ -986,18 +979,7 @@ void BookmarksModel::emptyTrash()
 
 void BookmarksModel::handleFeedModified(Feed *feed)
 {
-	if (!hasFeed(feed->getUrl()))
-	{
-		return;
-	}
-
-	const QUrl normalizedUrl(Utils::normalizeUrl(feed->getUrl()));
-	QVector<Bookmark*> bookmarks(m_feeds.value(feed->getUrl()));
-
-	if (feed->getUrl() != normalizedUrl)
-	{
-		bookmarks.append(m_feeds.value(normalizedUrl));
-	}
+	const QVector<Bookmark*> bookmarks(m_feeds.value(UrlKey(feed->getUrl())));
 
 	if (bookmarks.isEmpty())
 	{
@@ -1049,7 +1031,7 @@ void BookmarksModel::handleKeywordChanged(Bookmark *bookmark, const QString &new
 	}
 }
 
-void BookmarksModel::handleUrlChanged(Bookmark *bookmark, const QUrl &newUrl, const QUrl &oldUrl)
+void BookmarksModel::handleUrlChanged(Bookmark *bookmark, const UrlKey &newUrl, const UrlKey &oldUrl)
 {
 	if (!oldUrl.isEmpty() && m_urls.contains(oldUrl))
 	{
@@ -1127,7 +1109,7 @@ BookmarksModel::Bookmark* BookmarksModel::addBookmark(BookmarkType type, const Q
 
 			if (!url.isEmpty())
 			{
-				handleUrlChanged(bookmark, Utils::normalizeUrl(url));
+				handleUrlChanged(bookmark, UrlKey(url));
 			}
 
 			if (type == UrlBookmark)
@@ -1281,6 +1263,11 @@ QMimeData* BookmarksModel::mimeData(const QModelIndexList &indexes) const
 	return mimeData;
 }
 
+QString BookmarksModel::getCachePath(const QString &path)
+{
+	return path + QLatin1String(".cache");
+}
+
 QDateTime BookmarksModel::readDateTime(QXmlStreamReader *reader, const QString &attribute)
 {
 	QDateTime dateTime(QDateTime::fromString(reader->attributes().value(attribute).toString(), Qt::ISODate));
@@ -1289,6 +1276,16 @@ QDateTime BookmarksModel::readDateTime(QXmlStreamReader *reader, const QString &
 	return dateTime;
 }
 
+QVector<BookmarksModel::BookmarkInformation> BookmarksModel::createSnapshot() const
+{
+	QVector<BookmarkInformation> bookmarks;
+	bookmarks.reserve(getCount() + 1);
+
+	createSnapshot(m_rootItem, &bookmarks);
+
+	return bookmarks;
+}
+
 QStringList BookmarksModel::mimeTypes() const
 {
 	return {QLatin1String("text/uri-list")};
@@ -1334,7 +1331,7 @@ QVector<BookmarksModel::BookmarkMatch> BookmarksModel::findBookmarks(const QStri
 		allMatches.append(currentMatches.at(i));
 	}
 
-	QHash<QUrl, QVector<Bookmark*> >::const_iterator urlsIterator;
+	QHash<UrlKey, QVector<Bookmark*> >::const_iterator urlsIterator;
 
 	for (urlsIterator = m_urls.constBegin(); urlsIterator != m_urls.constEnd(); ++urlsIterator)
 	{
@@ -1376,33 +1373,18 @@ QVector<BookmarksModel::Bookmark*> BookmarksModel::findUrls(const QUrl &url, Boo
 		branch = m_rootItem;
 	}
 
-	const QUrl normalizedUrl(Utils::normalizeUrl(url));
+	const QVector<Bookmark*> candidates(m_urls.value(UrlKey(url)));
 	QVector<Bookmark*> bookmarks;
+	bookmarks.reserve(candidates.count());
 
-	for (int i = 0; i < branch->rowCount(); ++i)
+	for (int i = 0; i < candidates.count(); ++i)
 	{
-		Bookmark *bookmark(branch->getChild(i));
+		Bookmark *bookmark(candidates.at(i));
+		const Bookmark *parent(bookmark->getParent());
 
-		if (!bookmark)
+		if (bookmark->getType() == UrlBookmark && parent && parent->getType() != FeedBookmark && branch->isAncestorOf(bookmark))
 		{
-			continue;
-		}
-
-		switch (bookmark->getType())
-		{
-			case FolderBookmark:
-				bookmarks.append(findUrls(url, bookmark));
-
-				break;
-			case UrlBookmark:
-				if (normalizedUrl == Utils::normalizeUrl(bookmark->getUrl()))
-				{
-					bookmarks.append(bookmark);
-				}
-
-				break;
-			default:
-				break;
+			bookmarks.append(bookmark);
 		}
 	}
 
@@ -1411,25 +1393,212 @@ QVector<BookmarksModel::Bookmark*> BookmarksModel::findUrls(const QUrl &url, Boo
 
 QVector<BookmarksModel::Bookmark*> BookmarksModel::getBookmarks(const QUrl &url) const
 {
-	const QUrl normalizedUrl(Utils::normalizeUrl(url));
-	QVector<BookmarksModel::Bookmark*> bookmarks;
+	return m_urls.value(UrlKey(url));
+}
+
+BookmarksModel::FormatMode BookmarksModel::getFormatMode() const
+{
+	return m_mode;
+}
+
+int BookmarksModel::loadSnapshot(const QVector<BookmarkInformation> &bookmarks, int index, Bookmark *parent)
+{
+	const BookmarkInformation &information(bookmarks.at(index));
+	const bool isBookmarks(m_mode == BookmarksMode);
+	Bookmark *bookmark(parent);
+
+	++index;
 
-	if (m_urls.contains(url))
+	switch (information.type)
 	{
-		bookmarks = m_urls[url];
+		case FeedBookmark:
+		case FolderBookmark:
+		case UrlBookmark:
+			{
+				const QString keyword(isBookmarks ? information.keyword.trimmed() : QString());
+				const QString description(information.description.trimmed());
+				QMap<int, QVariant> metaData({{IdentifierRole, information.identifier}, {TimeAddedRole, information.timeAdded}, {TimeModifiedRole, information.timeModified}});
+
+				if (isBookmarks || information.type == FolderBookmark)
+				{
+					metaData[TitleRole] = information.title.trimmed();
+				}
+
+				if (!description.isEmpty())
+				{
+					metaData[DescriptionRole] = description;
+				}
+
+				if (!keyword.isEmpty())
+				{
+					metaData[KeywordRole] = keyword;
+				}
+
+				if (information.type != FolderBookmark)
+				{
+					metaData[UrlRole] = information.url;
+					metaData[TimeVisitedRole] = (isBookmarks ? information.timeVisited : QDateTime());
+
+					if (isBookmarks && information.visits > 0)
+					{
+						metaData[VisitsRole] = information.visits;
+					}
+				}
+
+				bookmark = addBookmark(information.type, metaData, parent);
+
+				if (metaData.contains(KeywordRole))
+				{
+					handleKeywordChanged(bookmark, keyword);
+				}
+			}
+
+			break;
+		case RootBookmark:
+			break;
+		default:
+			addBookmark(SeparatorBookmark, {}, parent);
+
+			return index;
 	}
 
-	if (url != normalizedUrl && m_urls.contains(normalizedUrl))
+	if (information.type == FolderBookmark || information.type == RootBookmark)
 	{
-		bookmarks.append(m_urls[normalizedUrl]);
+		for (int i = 0; (i < information.childrenAmount && index < bookmarks.count()); ++i)
+		{
+			index = loadSnapshot(bookmarks, index, bookmark);
+		}
 	}
 
-	return bookmarks;
+	return index;
 }
 
-BookmarksModel::FormatMode BookmarksModel::getFormatMode() const
+int BookmarksModel::writeBookmark(QXmlStreamWriter *writer, const QVector<BookmarkInformation> &bookmarks, int index, FormatMode mode)
 {
-	return m_mode;
+	const BookmarkInformation &bookmark(bookmarks.at(index));
+	const QString elementOwner(QLatin1String("http://otter-browser.org/otter-xbel-bookmark"));
+	const bool isBookmarks(mode == BookmarksMode);
+
+	++index;
+
+	switch (bookmark.type)
+	{
+		case RootBookmark:
+			for (int i = 0; (i < bookmark.childrenAmount && index < bookmarks.count()); ++i)
+			{
+				index = writeBookmark(writer, bookmarks, index, mode);
+			}
+
+			break;
+		case FeedBookmark:
+		case UrlBookmark:
+			writer->writeStartElement(QLatin1String("bookmark"));
+			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark.identifier));
+
+			if (bookmark.type == FeedBookmark)
+			{
+				writer->writeAttribute(QLatin1String("feed"), QLatin1String("true"));
+			}
+
+			if (!bookmark.url.isEmpty())
+			{
+				writer->writeAttribute(QLatin1String("href"), bookmark.url);
+			}
+
+			if (bookmark.timeAdded.isValid())
+			{
+				writer->writeAttribute(QLatin1String("added"), bookmark.timeAdded.toString(Qt::ISODate));
+			}
+
+			if (bookmark.timeModified.isValid())
+			{
+				writer->writeAttribute(QLatin1String("modified"), bookmark.timeModified.toString(Qt::ISODate));
+			}
+
+			if (isBookmarks)
+			{
+				if (bookmark.timeVisited.isValid())
+				{
+					writer->writeAttribute(QLatin1String("visited"), bookmark.timeVisited.toString(Qt::ISODate));
+				}
+
+				writer->writeTextElement(QLatin1String("title"), bookmark.title);
+			}
+
+			if (!bookmark.description.isEmpty())
+			{
+				writer->writeTextElement(QLatin1String("desc"), bookmark.description);
+			}
+
+			if (isBookmarks && (!bookmark.keyword.isEmpty() || bookmark.visits > 0))
+			{
+				writer->writeStartElement(QLatin1String("info"));
+				writer->writeStartElement(QLatin1String("metadata"));
+				writer->writeAttribute(QLatin1String("owner"), elementOwner);
+
+				if (!bookmark.keyword.isEmpty())
+				{
+					writer->writeTextElement(QLatin1String("keyword"), bookmark.keyword);
+				}
+
+				if (bookmark.visits > 0)
+				{
+					writer->writeTextElement(QLatin1String("visits"), QString::number(bookmark.visits));
+				}
+
+				writer->writeEndElement();
+				writer->writeEndElement();
+			}
+
+			writer->writeEndElement();
+
+			break;
+		case FolderBookmark:
+			writer->writeStartElement(QLatin1String("folder"));
+			writer->writeAttribute(QLatin1String("id"), QString::number(bookmark.identifier));
+
+			if (bookmark.timeAdded.isValid())
+			{
+				writer->writeAttribute(QLatin1String("added"), bookmark.timeAdded.toString(Qt::ISODate));
+			}
+
+			if (bookmark.timeModified.isValid())
+			{
+				writer->writeAttribute(QLatin1String("modified"), bookmark.timeModified.toString(Qt::ISODate));
+			}
+
+			writer->writeTextElement(QLatin1String("title"), bookmark.title);
+
+			if (!bookmark.description.isEmpty())
+			{
+				writer->writeTextElement(QLatin1String("desc"), bookmark.description);
+			}
+
+			if (isBookmarks && !bookmark.keyword.isEmpty())
+			{
+				writer->writeStartElement(QLatin1String("info"));
+				writer->writeStartElement(QLatin1String("metadata"));
+				writer->writeAttribute(QLatin1String("owner"), elementOwner);
+				writer->writeTextElement(QLatin1String("keyword"), bookmark.keyword);
+				writer->writeEndElement();
+				writer->writeEndElement();
+			}
+
+			for (int i = 0; (i < bookmark.childrenAmount && index < bookmarks.count()); ++i)
+			{
+				index = writeBookmark(writer, bookmarks, index, mode);
+			}
+
+			writer->writeEndElement();
+
+			break;
+		default:
+			writer->writeEmptyElement(QLatin1String("separator"));
+
+			break;
+	}
+
+	return index;
 }
 
 int BookmarksModel::getCount() const
@@ -1535,13 +1704,67 @@ bool BookmarksModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
 	return QStandardItemModel::dropMimeData(data, action, row, column, parent);
 }
 
-bool BookmarksModel::save(const QString &path) const
+bool BookmarksModel::loadCache(const QString &path)
 {
-	if (SessionsManager::isReadOnly())
+	QFile file(getCachePath(path));
+
+	if (!file.open(QIODevice::ReadOnly))
 	{
 		return false;
 	}
 
+	const QFileInfo information(path);
+	QDataStream stream(&file);
+	quint32 magic(0);
+	quint32 version(0);
+	qint32 mode(0);
+	qint64 size(0);
+	qint64 timestamp(0);
+	quint32 amount(0);
+
+	stream >> magic >> version >> mode >> size >> timestamp >> amount;
+
+	if (stream.status() != QDataStream::Ok || magic != 0x4F42584C || version != 1 || mode != m_mode || size != information.size() || timestamp != information.lastModified().toMSecsSinceEpoch() || amount == 0)
+	{
+		return false;
+	}
+
+	QVector<BookmarkInformation> bookmarks;
+	bookmarks.reserve(static_cast<int>(amount));
+
+	for (quint32 i = 0; i < amount; ++i)
+	{
+		BookmarkInformation bookmark;
+		qint32 type(0);
+		qint32 visits(0);
+		qint32 childrenAmount(0);
+
+		stream >> type >> bookmark.identifier >> bookmark.title >> bookmark.description >> bookmark.keyword >> bookmark.url >> bookmark.timeAdded >> bookmark.timeModified >> bookmark.timeVisited >> visits >> childrenAmount;
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			return false;
+		}
+
+		bookmark.type = static_cast<BookmarkType>(type);
+		bookmark.visits = visits;
+		bookmark.childrenAmount = childrenAmount;
+
+		bookmarks.append(bookmark);
+	}
+
+	if (bookmarks.first().type != RootBookmark)
+	{
+		return false;
+	}
+
+	loadSnapshot(bookmarks, 0, m_rootItem);
+
+	return true;
+}
+
+bool BookmarksModel::writeBookmarks(const QString &path, const QVector<BookmarkInformation> &bookmarks, FormatMode mode)
+{
 	QSaveFile file(path);
 
 	if (!file.open(QIODevice::WriteOnly))
@@ -1557,16 +1780,58 @@ bool BookmarksModel::save(const QString &path) const
 	writer.writeStartElement(QLatin1String("xbel"));
 	writer.writeAttribute(QLatin1String("version"), QLatin1String("1.0"));
 
-	for (int i = 0; i < m_rootItem->rowCount(); ++i)
+	if (!bookmarks.isEmpty())
 	{
-		writeBookmark(&writer, m_rootItem->getChild(i));
+		writeBookmark(&writer, bookmarks, 0, mode);
 	}
 
 	writer.writeEndDocument();
 
+	if (!file.commit())
+	{
+		return false;
+	}
+
+	const QFileInfo information(path);
+
+	return writeCache(path, bookmarks, mode, information.size(), information.lastModified().toMSecsSinceEpoch());
+}
+
+bool BookmarksModel::writeCache(const QString &path, const QVector<BookmarkInformation> &bookmarks, FormatMode mode, qint64 size, qint64 timestamp)
+{
+	QSaveFile file(getCachePath(path));
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream << static_cast<quint32>(0x4F42584C) << static_cast<quint32>(1) << static_cast<qint32>(mode) << size << timestamp << static_cast<quint32>(bookmarks.count());
+
+	for (int i = 0; i < bookmarks.count(); ++i)
+	{
+		const BookmarkInformation &bookmark(bookmarks.at(i));
+
+		stream << static_cast<qint32>(bookmark.type) << bookmark.identifier << bookmark.title << bookmark.description << bookmark.keyword << bookmark.url << bookmark.timeAdded << bookmark.timeModified << bookmark.timeVisited << static_cast<qint32>(bookmark.visits) << static_cast<qint32>(bookmark.childrenAmount);
+	}
+
 	return file.commit();
 }
 
+bool BookmarksModel::save(const QString &path)
+{
+	if (SessionsManager::isReadOnly())
+	{
+		return false;
+	}
+
+	m_savePath.clear();
+	m_saveWatcher->waitForFinished();
+
+	return writeBookmarks(path, createSnapshot(), m_mode);
+}
+
 bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
 	Bookmark *bookmark(getBookmark(index));
@@ -1601,8 +1866,8 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 			break;
 		case UrlRole:
 			{
-				const QUrl oldUrl(Utils::normalizeUrl(index.data(UrlRole).toUrl()));
-				const QUrl newUrl(Utils::normalizeUrl(value.toUrl()));
+				const UrlKey oldUrl(index.data(UrlRole).toUrl());
+				const UrlKey newUrl(value.toUrl());
 
 				if (oldUrl != newUrl)
 				{
@@ -1642,12 +1907,12 @@ bool BookmarksModel::setData(const QModelIndex &index, const QVariant &value, in
 
 bool BookmarksModel::hasBookmark(const QUrl &url) const
 {
-	return (m_urls.contains(url) || m_urls.contains(Utils::normalizeUrl(url)));
+	return m_urls.contains(UrlKey(url));
 }
 
 bool BookmarksModel::hasFeed(const QUrl &url) const
 {
-	return (m_feeds.contains(url) || m_feeds.contains(Utils::normalizeUrl(url)));
+	return m_feeds.contains(UrlKey(url));
 }
 
 bool BookmarksModel::hasKeyword(const QString &keyword) const
@@ -21,6 +21,10 @@
 #ifndef OTTER_BOOKMARKSMODEL_H
 #define OTTER_BOOKMARKSMODEL_H
 
+#include "Utils.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QUrl>
 #include <QtCore/QXmlStreamReader>
 #include <QtCore/QXmlStreamWriter>
@@ -117,6 +121,7 @@ public:
 	void trashBookmark(Bookmark *bookmark);
 	void restoreBookmark(Bookmark *bookmark);
 	void removeBookmark(Bookmark *bookmark);
+	void saveInBackground(const QString &path);
 	Bookmark* addBookmark(BookmarkType type, const QMap<int, QVariant> &metaData = {}, Bookmark *parent = nullptr, int index = -1);
 	Bookmark* getBookmarkByKeyword(const QString &keyword) const;
 	Bookmark* getBookmarkByPath(const QString &path, bool createIfNotExists = false);
@@ -135,7 +140,7 @@ public:
 	bool moveBookmark(Bookmark *bookmark, Bookmark *newParent, int newRow = -1);
 	bool canDropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) const override;
 	bool dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent) override;
-	bool save(const QString &path) const;
+	bool save(const QString &path);
 	bool setData(const QModelIndex &index, const QVariant &value, int role) override;
 	bool hasBookmark(const QUrl &url) const;
 	bool hasFeed(const QUrl &url) const;
@@ -151,14 +156,36 @@ protected:
 		int row = -1;
 	};
 
+	struct BookmarkInformation final
+	{
+		QString title;
+		QString description;
+		QString keyword;
+		QString url;
+		QDateTime timeAdded;
+		QDateTime timeModified;
+		QDateTime timeVisited;
+		quint64 identifier = 0;
+		BookmarkType type = UnknownBookmark;
+		int visits = 0;
+		int childrenAmount = 0;
+	};
+
 	void readBookmark(QXmlStreamReader *reader, Bookmark *parent);
-	void writeBookmark(QXmlStreamWriter *writer, Bookmark *bookmark) const;
+	void createSnapshot(Bookmark *bookmark, QVector<BookmarkInformation> *bookmarks) const;
 	void removeBookmarkUrl(Bookmark *bookmark);
 	void readdBookmarkUrl(Bookmark *bookmark);
 	void setupFeed(Bookmark *bookmark);
 	void handleKeywordChanged(Bookmark *bookmark, const QString &newKeyword, const QString &oldKeyword = {});
-	void handleUrlChanged(Bookmark *bookmark, const QUrl &newUrl, const QUrl &oldUrl = {});
+	void handleUrlChanged(Bookmark *bookmark, const UrlKey &newUrl, const UrlKey &oldUrl = {});
+	static QString getCachePath(const QString &path);
 	static QDateTime readDateTime(QXmlStreamReader *reader, const QString &attribute);
+	QVector<BookmarkInformation> createSnapshot() const;
+	int loadSnapshot(const QVector<BookmarkInformation> &bookmarks, int index, Bookmark *parent);
+	static int writeBookmark(QXmlStreamWriter *writer, const QVector<BookmarkInformation> &bookmarks, int index, FormatMode mode);
+	bool loadCache(const QString &path);
+	static bool writeBookmarks(const QString &path, const QVector<BookmarkInformation> &bookmarks, FormatMode mode);
+	static bool writeCache(const QString &path, const QVector<BookmarkInformation> &bookmarks, FormatMode mode, qint64 size, qint64 timestamp);
 
 protected slots:
 	void handleFeedModified(Feed *feed);
@@ -169,10 +196,12 @@ private:
 	Bookmark *m_trashItem;
 	Bookmark *m_importTargetItem;
 	QHash<Bookmark*, BookmarkLocation> m_trash;
-	QHash<QUrl, QVector<Bookmark*> > m_feeds;
-	QHash<QUrl, QVector<Bookmark*> > m_urls;
+	QHash<UrlKey, QVector<Bookmark*> > m_feeds;
+	QHash<UrlKey, QVector<Bookmark*> > m_urls;
 	QHash<QString, Bookmark*> m_keywords;
 	QMap<quint64, Bookmark*> m_identifiers;
+	QFutureWatcher<void> *m_saveWatcher;
+	QString m_savePath;
 	FormatMode m_mode;
 
 signals:
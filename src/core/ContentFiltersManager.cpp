@@ -27,6 +27,7 @@
 #include "SessionsManager.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QTimer>
@@ -37,6 +38,7 @@ namespace Otter
 ContentFiltersManager* ContentFiltersManager::m_instance(nullptr);
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_contentBlockingProfiles;
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_fraudCheckingProfiles;
+QHash<QString, QString> ContentFiltersManager::m_cosmeticFiltersStyleSheets;
 
 ContentFiltersManager::ContentFiltersManager(QObject *parent) : QObject(parent),
 	m_saveTimer(0)
@@ -45,6 +47,10 @@ ContentFiltersManager::ContentFiltersManager(QObject *parent) : QObject(parent),
 	{
 		initialize();
 	});
+
+	connect(this, &ContentFiltersManager::profileAdded, this, &ContentFiltersManager::clearCosmeticFiltersStyleSheets);
+	connect(this, &ContentFiltersManager::profileModified, this, &ContentFiltersManager::clearCosmeticFiltersStyleSheets);
+	connect(this, &ContentFiltersManager::profileRemoved, this, &ContentFiltersManager::clearCosmeticFiltersStyleSheets);
 }
 
 void ContentFiltersManager::createInstance()
@@ -325,6 +331,7 @@ void ContentFiltersManager::addProfile(ContentFiltersProfile *profile)
 	emit m_instance->profileAdded(profile->getName());
 
 	connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::scheduleSave);
+	connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::clearCosmeticFiltersStyleSheets);
 }
 
 void ContentFiltersManager::removeProfile(ContentFiltersProfile *profile, bool removeFile)
@@ -425,6 +432,8 @@ ContentFiltersManager::CheckResult ContentFiltersManager::checkUrl(const QVector
 	CheckResult result;
 	result.isFraud = ((resourceType == NetworkManager::MainFrameType || resourceType == NetworkManager::SubFrameType) ? isFraud(requestUrl) : false);
 
+	QElapsedTimer timer;
+
 	for (int i = 0; i < profiles.count(); ++i)
 	{
 		const int profile(profiles.at(i));
@@ -434,8 +443,15 @@ ContentFiltersManager::CheckResult ContentFiltersManager::checkUrl(const QVector
 			continue;
 		}
 
-		CheckResult currentResult(m_contentBlockingProfiles.at(profile)->checkUrl(baseUrl, requestUrl, resourceType));
+		ContentFiltersProfile *contentBlockingProfile(m_contentBlockingProfiles.at(profile));
+
+		timer.start();
+
+		CheckResult currentResult(contentBlockingProfile->checkUrl(baseUrl, requestUrl, resourceType));
 		currentResult.profile = profile;
+
+		contentBlockingProfile->addCheckTime(timer.nsecsElapsed(), currentResult.isBlocked);
+
 		currentResult.isFraud = result.isFraud;
 
 		if (currentResult.isBlocked)
@@ -451,6 +467,11 @@ ContentFiltersManager::CheckResult ContentFiltersManager::checkUrl(const QVector
 	return result;
 }
 
+void ContentFiltersManager::clearCosmeticFiltersStyleSheets()
+{
+	m_cosmeticFiltersStyleSheets.clear();
+}
+
 ContentFiltersManager::CosmeticFiltersResult ContentFiltersManager::getCosmeticFilters(const QVector<int> &profiles, const QUrl &requestUrl)
 {
 	if (profiles.isEmpty())
@@ -458,15 +479,18 @@ ContentFiltersManager::CosmeticFiltersResult ContentFiltersManager::getCosmeticF
 		return {};
 	}
 
-	const CosmeticFiltersMode mode(checkUrl(profiles, requestUrl, requestUrl, NetworkManager::OtherType).comesticFiltersMode);
+	return getCosmeticFilters(profiles, requestUrl.host(), checkUrl(profiles, requestUrl, requestUrl, NetworkManager::OtherType).comesticFiltersMode);
+}
 
+ContentFiltersManager::CosmeticFiltersResult ContentFiltersManager::getCosmeticFilters(const QVector<int> &profiles, const QString &host, CosmeticFiltersMode mode)
+{
 	if (mode == NoFilters)
 	{
 		return {};
 	}
 
 	CosmeticFiltersResult result;
-	const QStringList domains(createSubdomainList(requestUrl.host()));
+	const QStringList domains(createSubdomainList(host));
 	const bool isDomainOnly(mode == DomainOnlyFilters);
 
 	for (int i = 0; i < profiles.count(); ++i)
@@ -503,6 +527,63 @@ QStringList ContentFiltersManager::createSubdomainList(const QString &domain)
 	return subdomainList;
 }
 
+QString ContentFiltersManager::getCosmeticFiltersStyleSheet(const QVector<int> &profiles, const QUrl &requestUrl)
+{
+	if (profiles.isEmpty())
+	{
+		return {};
+	}
+
+	const CosmeticFiltersMode mode(checkUrl(profiles, requestUrl, requestUrl, NetworkManager::OtherType).comesticFiltersMode);
+
+	if (mode == NoFilters)
+	{
+		return {};
+	}
+
+	QStringList keyParts;
+	keyParts.reserve(profiles.count() + 2);
+	keyParts.append(QString::number(mode));
+	keyParts.append(requestUrl.host());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		keyParts.append(QString::number(profiles.at(i)));
+	}
+
+	const QString key(keyParts.join(QLatin1Char(' ')));
+
+	if (m_cosmeticFiltersStyleSheets.contains(key))
+	{
+		return m_cosmeticFiltersStyleSheets[key];
+	}
+
+	const CosmeticFiltersResult cosmeticFilters(getCosmeticFilters(profiles, requestUrl.host(), mode));
+	QSet<QString> skippedRules(cosmeticFilters.exceptions.begin(), cosmeticFilters.exceptions.end());
+	QString styleSheet;
+
+	for (int i = 0; i < cosmeticFilters.rules.count(); ++i)
+	{
+		const QString rule(cosmeticFilters.rules.at(i));
+
+		if (!skippedRules.contains(rule))
+		{
+			styleSheet.append(rule + QLatin1String(" {display: none !important;}\n"));
+
+			skippedRules.insert(rule);
+		}
+	}
+
+	if (m_cosmeticFiltersStyleSheets.count() >= 100)
+	{
+		m_cosmeticFiltersStyleSheets.clear();
+	}
+
+	m_cosmeticFiltersStyleSheets[key] = styleSheet;
+
+	return styleSheet;
+}
+
 QStringList ContentFiltersManager::getProfileNames()
 {
 	initialize();
@@ -555,6 +636,29 @@ QVector<int> ContentFiltersManager::getProfileIdentifiers(const QStringList &nam
 	return identifiers;
 }
 
+DiagnosticReport::Section ContentFiltersManager::createReport()
+{
+	DiagnosticReport::Section report;
+	report.title = QLatin1String("Content Blocking");
+	report.fieldWidths = {30, 20, 20, 20, 20, 20, 0};
+	report.entries.reserve(m_contentBlockingProfiles.count());
+
+	for (int i = 0; i < m_contentBlockingProfiles.count(); ++i)
+	{
+		const ContentFiltersProfile *profile(m_contentBlockingProfiles.at(i));
+		const ContentFiltersProfile::ProfileStatistics statistics(profile->getStatistics());
+
+		if (statistics.checksAmount == 0 && statistics.loadTime == 0)
+		{
+			continue;
+		}
+
+		report.entries.append({profile->getName(), QStringLiteral("%1 checks").arg(statistics.checksAmount), QStringLiteral("%1 blocked").arg(statistics.blockedAmount), QStringLiteral("%1 ms total").arg((static_cast<double>(statistics.checkTime) / 1000000), 0, 'f', 2), QStringLiteral("p50 < %1 us").arg((static_cast<double>(profile->getCheckTimePercentile(50)) / 1000), 0, 'f', 2), QStringLiteral("p99 < %1 us").arg((static_cast<double>(profile->getCheckTimePercentile(99)) / 1000), 0, 'f', 2), QStringLiteral("loaded in %1 ms").arg((static_cast<double>(statistics.loadTime) / 1000000), 0, 'f', 2)});
+	}
+
+	return report;
+}
+
 bool ContentFiltersManager::isFraud(const QUrl &url)
 {
 	for (int i = 0; i < m_fraudCheckingProfiles.count(); ++i)
@@ -572,4 +676,50 @@ ContentFiltersProfile::ContentFiltersProfile(QObject *parent) : QObject(parent)
 {
 }
 
+void ContentFiltersProfile::addCheckTime(qint64 time, bool isBlocked)
+{
+	if (m_statistics.checkTimeHistogram.isEmpty())
+	{
+		m_statistics.checkTimeHistogram.fill(0, 64);
+	}
+
+	m_statistics.checkTime += time;
+
+	++m_statistics.checksAmount;
+	++m_statistics.checkTimeHistogram[64 - qCountLeadingZeroBits(static_cast<quint64>(qMax(time, static_cast<qint64>(0))))];
+
+	if (isBlocked)
+	{
+		++m_statistics.blockedAmount;
+	}
+}
+
+void ContentFiltersProfile::setLoadTime(qint64 time)
+{
+	m_statistics.loadTime = time;
+}
+
+ContentFiltersProfile::ProfileStatistics ContentFiltersProfile::getStatistics() const
+{
+	return m_statistics;
+}
+
+qint64 ContentFiltersProfile::getCheckTimePercentile(int percentile) const
+{
+	const quint64 threshold(((m_statistics.checksAmount * static_cast<quint64>(percentile)) + 99) / 100);
+	quint64 checksAmount(0);
+
+	for (int i = 0; i < m_statistics.checkTimeHistogram.count(); ++i)
+	{
+		checksAmount += m_statistics.checkTimeHistogram.at(i);
+
+		if (checksAmount >= threshold && checksAmount > 0)
+		{
+			return ((i == 0) ? 0 : (static_cast<qint64>(1) << qMin(i, 62)));
+		}
+	}
+
+	return 0;
+}
+
 }
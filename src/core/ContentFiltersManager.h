@@ -22,6 +22,7 @@
 #define OTTER_CONTENTFILTERSMANAGER_H
 
 #include "NetworkManager.h"
+#include "Utils.h"
 
 #include <QtCore/QUrl>
 
@@ -68,11 +69,13 @@ public:
 	static ContentFiltersProfile* getProfile(int identifier);
 	static CheckResult checkUrl(const QVector<int> &profiles, const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType);
 	static CosmeticFiltersResult getCosmeticFilters(const QVector<int> &profiles, const QUrl &requestUrl);
+	static QString getCosmeticFiltersStyleSheet(const QVector<int> &profiles, const QUrl &requestUrl);
 	static QStringList createSubdomainList(const QString &domain);
 	static QStringList getProfileNames();
 	static QVector<ContentFiltersProfile*> getContentBlockingProfiles();
 	static QVector<ContentFiltersProfile*> getFraudCheckingProfiles();
 	static QVector<int> getProfileIdentifiers(const QStringList &names);
+	static DiagnosticReport::Section createReport();
 	static bool isFraud(const QUrl &url);
 
 protected:
@@ -80,9 +83,11 @@ protected:
 
 	void timerEvent(QTimerEvent *event) override;
 	void save();
+	static CosmeticFiltersResult getCosmeticFilters(const QVector<int> &profiles, const QString &host, CosmeticFiltersMode mode);
 
 protected slots:
 	void scheduleSave();
+	void clearCosmeticFiltersStyleSheets();
 
 private:
 	int m_saveTimer;
@@ -90,6 +95,7 @@ private:
 	static ContentFiltersManager *m_instance;
 	static QVector<ContentFiltersProfile*> m_contentBlockingProfiles;
 	static QVector<ContentFiltersProfile*> m_fraudCheckingProfiles;
+	static QHash<QString, QString> m_cosmeticFiltersStyleSheets;
 
 signals:
 	void profileAdded(const QString &profile);
@@ -140,8 +146,18 @@ public:
 		bool areWildcardsEnabled = false;
 	};
 
+	struct ProfileStatistics final
+	{
+		QVector<quint64> checkTimeHistogram;
+		qint64 checkTime = 0;
+		qint64 loadTime = 0;
+		quint64 checksAmount = 0;
+		quint64 blockedAmount = 0;
+	};
+
 	explicit ContentFiltersProfile(QObject *parent = nullptr);
 
+	void addCheckTime(qint64 time, bool isBlocked);
 	virtual void clear() = 0;
 	virtual void setProfileSummary(const ProfileSummary &profileSummary) = 0;
 	virtual QString getName() const = 0;
@@ -150,6 +166,7 @@ public:
 	virtual QUrl getUpdateUrl() const = 0;
 	virtual QDateTime getLastUpdate() const = 0;
 	virtual ProfileSummary getProfileSummary() const = 0;
+	ProfileStatistics getStatistics() const;
 	virtual ContentFiltersManager::CheckResult checkUrl(const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType) = 0;
 	virtual ContentFiltersManager::CosmeticFiltersResult getCosmeticFilters(const QStringList &domains, bool isDomainOnly) = 0;
 	virtual QVector<QLocale::Language> getLanguages() const = 0;
@@ -157,6 +174,7 @@ public:
 	virtual ContentFiltersManager::CosmeticFiltersMode getCosmeticFiltersMode() const = 0;
 	virtual ProfileError getError() const = 0;
 	virtual ProfileFlags getFlags() const = 0;
+	qint64 getCheckTimePercentile(int percentile) const;
 	virtual int getUpdateInterval() const = 0;
 	virtual int getUpdateProgress() const = 0;
 	virtual bool update(const QUrl &url = {}) = 0;
@@ -165,6 +183,12 @@ public:
 	virtual bool isUpdating() const = 0;
 	virtual bool isFraud(const QUrl &url) = 0;
 
+protected:
+	void setLoadTime(qint64 time);
+
+private:
+	ProfileStatistics m_statistics;
+
 signals:
 	void profileModified();
 	void updateProgressChanged(int progress);
@@ -21,11 +21,11 @@
 #include "Application.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "TasksManager.h"
 
 #include <QtCore/QDataStream>
 #include <QtCore/QFile>
 #include <QtCore/QSaveFile>
-#include <QtCore/QTimerEvent>
 
 namespace Otter
 {
@@ -34,8 +34,7 @@ CookieJar::CookieJar(const QString &path, QObject *parent) : QNetworkCookieJar(p
 	m_path(path),
 	m_generalCookiesPolicy(AcceptAllCookies),
 	m_thirdPartyCookiesPolicy(AcceptAllCookies),
-	m_keepMode(KeepUntilExpiresMode),
-	m_saveTimer(0)
+	m_keepMode(KeepUntilExpiresMode)
 {
 	if (!path.isEmpty())
 	{
@@ -47,20 +46,6 @@ CookieJar::CookieJar(const QString &path, QObject *parent) : QNetworkCookieJar(p
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &CookieJar::handleOptionChanged);
 }
 
-void CookieJar::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() != m_saveTimer)
-	{
-		return;
-	}
-
-	killTimer(m_saveTimer);
-
-	m_saveTimer = 0;
-
-	save();
-}
-
 void CookieJar::loadCookies(const QString &path)
 {
 	QFile file(path);
@@ -125,18 +110,16 @@ void CookieJar::scheduleSave()
 
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		save();
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(500);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			save();
+		});
 	}
 }
 
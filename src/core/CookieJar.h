@@ -69,7 +69,6 @@ public:
 	bool hasCookie(const QNetworkCookie &cookie) const;
 
 protected:
-	void timerEvent(QTimerEvent *event) override;
 	void loadCookies(const QString &path);
 	void scheduleSave();
 	void save();
@@ -82,7 +81,6 @@ private:
 	CookiesPolicy m_generalCookiesPolicy;
 	CookiesPolicy m_thirdPartyCookiesPolicy;
 	KeepMode m_keepMode;
-	int m_saveTimer;
 
 signals:
 	void cookieAdded(const QNetworkCookie &cookie);
@@ -77,8 +77,8 @@ ImportJob::ImportJob(QObject *parent) : Job(parent)
 }
 
 BookmarksImportJob::BookmarksImportJob(BookmarksModel::Bookmark *folder, bool areDuplicatesAllowed, QObject *parent) : ImportJob(parent),
-	m_currentFolder(folder),
-	m_importFolder(folder),
+	m_currentFolder(folder ? folder->getIdentifier() : 0),
+	m_importFolder(m_currentFolder),
 	m_areDuplicatesAllowed(areDuplicatesAllowed)
 {
 }
@@ -87,31 +87,26 @@ void BookmarksImportJob::goToParent()
 {
 	if (m_currentFolder != m_importFolder)
 	{
-		if (m_currentFolder)
-		{
-			m_currentFolder = m_currentFolder->getParent();
-		}
-
-		if (!m_currentFolder)
-		{
-			m_currentFolder = (m_importFolder ? m_importFolder : BookmarksManager::getModel()->getRootItem());
-		}
+		const BookmarksModel::Bookmark *currentFolder(getCurrentFolder());
+		const BookmarksModel::Bookmark *parentFolder(currentFolder ? currentFolder->getParent() : nullptr);
+
+		m_currentFolder = (parentFolder ? parentFolder->getIdentifier() : m_importFolder);
 	}
 }
 
 void BookmarksImportJob::setCurrentFolder(BookmarksModel::Bookmark *folder)
 {
-	m_currentFolder = folder;
+	m_currentFolder = (folder ? folder->getIdentifier() : 0);
 }
 
 BookmarksModel::Bookmark* BookmarksImportJob::getCurrentFolder() const
 {
-	return m_currentFolder;
+	return BookmarksManager::getBookmark(m_currentFolder);
 }
 
 BookmarksModel::Bookmark* BookmarksImportJob::getImportFolder() const
 {
-	return m_importFolder;
+	return ((m_importFolder > 0) ? BookmarksManager::getBookmark(m_importFolder) : nullptr);
 }
 
 QDateTime BookmarksImportJob::getDateTime(const QString &timestamp) const
@@ -126,4 +121,9 @@ bool BookmarksImportJob::areDuplicatesAllowed() const
 	return m_areDuplicatesAllowed;
 }
 
+bool BookmarksImportJob::hasRemovedFolder() const
+{
+	return ((m_importFolder > 0 && !BookmarksManager::getBookmark(m_importFolder)) || (m_currentFolder > 0 && !BookmarksManager::getBookmark(m_currentFolder)));
+}
+
 }
@@ -138,10 +138,11 @@ protected:
 	BookmarksModel::Bookmark* getImportFolder() const;
 	QDateTime getDateTime(const QString &timestamp) const;
 	bool areDuplicatesAllowed() const;
+	bool hasRemovedFolder() const;
 
 private:
-	BookmarksModel::Bookmark *m_currentFolder;
-	BookmarksModel::Bookmark *m_importFolder;
+	quint64 m_currentFolder;
+	quint64 m_importFolder;
 	bool m_areDuplicatesAllowed;
 };
 
@@ -79,6 +79,14 @@ FeedParser* FeedParser::createParser(Feed *feed, DataFetchJob *data)
 	return nullptr;
 }
 
+void FeedParser::addMessage(const QString &note, Console::MessageCategory category, Console::MessageLevel level, const QUrl &url, int line)
+{
+	QMetaObject::invokeMethod(Console::getInstance(), [=]()
+	{
+		Console::addMessage(note, category, level, url.toDisplayString(), line);
+	});
+}
+
 QString FeedParser::createIdentifier(const Feed::Entry &entry)
 {
 	if (entry.publicationTime.isValid())
@@ -98,9 +106,9 @@ AtomFeedParser::AtomFeedParser() : FeedParser()
 	m_information.mimeType = QMimeDatabase().mimeTypeForName(QLatin1String("application/atom+xml"));
 }
 
-void AtomFeedParser::parse(DataFetchJob *data)
+bool AtomFeedParser::parse(const QByteArray &data, const QUrl &url)
 {
-	QXmlStreamReader reader(data->getData());
+	QXmlStreamReader reader(data);
 	bool isSuccess(true);
 
 	m_information.entries.reserve(10);
@@ -219,7 +227,7 @@ void AtomFeedParser::parse(DataFetchJob *data)
 
 			if (reader.hasError())
 			{
-				Console::addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+				addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, url);
 
 				isSuccess = false;
 			}
@@ -230,12 +238,12 @@ void AtomFeedParser::parse(DataFetchJob *data)
 
 	if (m_information.entries.isEmpty())
 	{
-		Console::addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+		addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, url);
 
 		isSuccess = false;
 	}
 
-	emit parsingFinished(isSuccess);
+	return isSuccess;
 }
 
 FeedParser::FeedInformation AtomFeedParser::getInformation() const
@@ -256,9 +264,9 @@ RssFeedParser::RssFeedParser() : FeedParser()
 	m_information.mimeType = QMimeDatabase().mimeTypeForName(QLatin1String("application/rss+xml"));
 }
 
-void RssFeedParser::parse(DataFetchJob *data)
+bool RssFeedParser::parse(const QByteArray &data, const QUrl &url)
 {
-	QXmlStreamReader reader(data->getData());
+	QXmlStreamReader reader(data);
 	bool isSuccess(true);
 	QRegularExpression emailExpression(QLatin1String(R"(^[a-zA-Z0-9\._\-]+@[a-zA-Z0-9\._\-]+\.[a-zA-Z0-9]+$)"));
 	emailExpression.optimize();
@@ -382,7 +390,7 @@ void RssFeedParser::parse(DataFetchJob *data)
 
 			if (reader.hasError())
 			{
-				Console::addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, data->getUrl().toDisplayString(), static_cast<int>(reader.lineNumber()));
+				addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, url, static_cast<int>(reader.lineNumber()));
 
 				isSuccess = false;
 			}
@@ -393,12 +401,12 @@ void RssFeedParser::parse(DataFetchJob *data)
 
 	if (m_information.entries.isEmpty())
 	{
-		Console::addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+		addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, url);
 
 		isSuccess = false;
 	}
 
-	emit parsingFinished(isSuccess);
+	return isSuccess;
 }
 
 FeedParser::FeedInformation RssFeedParser::getInformation() const
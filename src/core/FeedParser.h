@@ -20,6 +20,7 @@
 #ifndef OTTER_FEEDPARSER_H
 #define OTTER_FEEDPARSER_H
 
+#include "Console.h"
 #include "FeedsManager.h"
 
 #include <QtCore/QMimeType>
@@ -55,15 +56,13 @@ public:
 
 	explicit FeedParser();
 
-	virtual void parse(DataFetchJob *data) = 0;
+	virtual bool parse(const QByteArray &data, const QUrl &url) = 0;
 	virtual FeedInformation getInformation() const = 0;
 	static FeedParser* createParser(Feed *feed, DataFetchJob *data);
 
 protected:
+	static void addMessage(const QString &note, Console::MessageCategory category, Console::MessageLevel level, const QUrl &url, int line = -1);
 	static QString createIdentifier(const Feed::Entry &entry);
-
-signals:
-	void parsingFinished(bool isSuccess);
 };
 
 class AtomFeedParser final : public FeedParser
@@ -71,7 +70,7 @@ class AtomFeedParser final : public FeedParser
 public:
 	explicit AtomFeedParser();
 
-	void parse(DataFetchJob *data) override;
+	bool parse(const QByteArray &data, const QUrl &url) override;
 	FeedInformation getInformation() const override;
 
 protected:
@@ -86,7 +85,7 @@ class RssFeedParser final : public FeedParser
 public:
 	explicit RssFeedParser();
 
-	void parse(DataFetchJob *data) override;
+	bool parse(const QByteArray &data, const QUrl &url) override;
 	FeedInformation getInformation() const override;
 
 protected:
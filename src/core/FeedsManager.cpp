@@ -23,12 +23,16 @@
 #include "Console.h"
 #include "FeedParser.h"
 #include "Job.h"
-#include "LongTermTimer.h"
 #include "NotificationsManager.h"
 #include "SessionsManager.h"
+#include "SettingsManager.h"
+#include "TasksManager.h"
 #include "Utils.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -38,32 +42,68 @@ namespace Otter
 {
 
 Feed::Feed(const QString &title, const QUrl &url, const QIcon &icon, int updateInterval, QObject *parent) : QObject(parent),
-	m_updateTimer(nullptr),
 	m_parser(nullptr),
+	m_parserWatcher(nullptr),
 	m_title(title),
 	m_url(url),
 	m_icon(icon),
 	m_error(NoError),
+	m_updateTask(0),
 	m_updateInterval(0),
 	m_updateProgress(-1),
+	m_unreadEntriesAmount(0),
+	m_areEntriesModified(false),
 	m_isUpdating(false)
 {
 	setUpdateInterval(updateInterval);
+
+	m_parserWatcher = new QFutureWatcher<void>(this);
+
+	connect(m_parserWatcher, &QFutureWatcher<void>::finished, this, &Feed::handleParsingFinished);
 }
 
-void Feed::markEntryAsRead(const QString &identifier)
+Feed::~Feed()
 {
-	for (int i = 0; i < m_entries.count(); ++i)
+	if (m_parserWatcher->isRunning())
 	{
-		if (m_entries.at(i).identifier == identifier)
+		FeedParser *parser(m_parser);
+		QFutureWatcher<void> *parserWatcher(m_parserWatcher);
+
+		parserWatcher->disconnect(this);
+		parserWatcher->setParent(nullptr);
+
+		connect(parserWatcher, &QFutureWatcher<void>::finished, parserWatcher, [=]()
 		{
-			m_entries[i].lastReadTime = QDateTime::currentDateTimeUtc();
+			delete parser;
 
-			emit feedModified(this);
+			parserWatcher->deleteLater();
+		});
+	}
+	else if (m_parser)
+	{
+		delete m_parser;
+	}
+}
 
-			break;
-		}
+void Feed::markEntryAsRead(const QString &identifier)
+{
+	const int index(m_entriesIndex.value(identifier, -1));
+
+	if (index < 0)
+	{
+		return;
 	}
+
+	if (m_entries.at(index).lastReadTime.isNull())
+	{
+		--m_unreadEntriesAmount;
+	}
+
+	m_entries[index].lastReadTime = QDateTime::currentDateTimeUtc();
+
+	m_areEntriesModified = true;
+
+	emit feedModified(this);
 }
 
 void Feed::markAllEntriesAsRead()
@@ -72,35 +112,36 @@ void Feed::markAllEntriesAsRead()
 
 	for (int i = 0; i < m_entries.count(); ++i)
 	{
-		if (!m_entries.at(i).lastReadTime.isValid())
+		if (m_entries.at(i).lastReadTime.isNull())
 		{
 			m_entries[i].lastReadTime = currentDateTime;
 		}
 	}
 
+	m_unreadEntriesAmount = 0;
+	m_areEntriesModified = true;
+
 	emit feedModified(this);
 }
 
 void Feed::markEntryAsRemoved(const QString &identifier)
 {
-	if (m_removedEntries.contains(identifier))
+	const int index(m_entriesIndex.value(identifier, -1));
+
+	if (index < 0 || m_removedEntries.contains(identifier))
 	{
 		return;
 	}
 
-	for (int i = 0; i < m_entries.count(); ++i)
-	{
-		if (m_entries.at(i).identifier == identifier)
-		{
-			m_entries.removeAt(i);
+	m_entries.removeAt(index);
 
-			m_removedEntries.append(identifier);
+	m_removedEntries.insert(identifier);
 
-			emit feedModified(this);
+	updateIndex();
 
-			break;
-		}
-	}
+	m_areEntriesModified = true;
+
+	emit feedModified(this);
 }
 
 void Feed::setTitle(const QString &title)
@@ -128,6 +169,7 @@ void Feed::setUrl(const QUrl &url)
 	if (url != m_url)
 	{
 		m_url = url;
+		m_areEntriesModified = true;
 
 		update();
 
@@ -159,12 +201,69 @@ void Feed::setCategories(const QMap<QString, QString> &categories)
 
 void Feed::setRemovedEntries(const QStringList &removedEntries)
 {
-	m_removedEntries = removedEntries;
+	m_removedEntries = QSet<QString>(removedEntries.begin(), removedEntries.end());
 }
 
 void Feed::setEntries(const QVector<Feed::Entry> &entries)
 {
 	m_entries = entries;
+
+	expireEntries();
+	updateIndex();
+}
+
+void Feed::expireEntries()
+{
+	const int limitAmount(SettingsManager::getOption(SettingsManager::History_FeedEntriesLimitAmountOption).toInt());
+	const int limitPeriod(SettingsManager::getOption(SettingsManager::History_FeedEntriesLimitPeriodOption).toInt());
+	const QDateTime expirationTime((limitPeriod > 0) ? QDateTime::currentDateTimeUtc().addDays(-limitPeriod) : QDateTime());
+
+	if ((limitAmount <= 0 || m_entries.count() <= limitAmount) && !expirationTime.isValid())
+	{
+		return;
+	}
+
+	QVector<Entry> entries;
+	entries.reserve((limitAmount > 0) ? qMin(limitAmount, m_entries.count()) : m_entries.count());
+
+	for (int i = 0; i < m_entries.count(); ++i)
+	{
+		const Entry &entry(m_entries.at(i));
+		const QDateTime time(entry.updateTime.isValid() ? entry.updateTime : entry.publicationTime);
+
+		if ((limitAmount > 0 && entries.count() >= limitAmount) || (expirationTime.isValid() && time.isValid() && time < expirationTime))
+		{
+			m_removedEntries.insert(entry.identifier);
+		}
+		else
+		{
+			entries.append(entry);
+		}
+	}
+
+	if (entries.count() != m_entries.count())
+	{
+		m_entries = entries;
+		m_areEntriesModified = true;
+	}
+}
+
+void Feed::updateIndex()
+{
+	m_entriesIndex.clear();
+	m_entriesIndex.reserve(m_entries.count());
+
+	m_unreadEntriesAmount = 0;
+
+	for (int i = 0; i < m_entries.count(); ++i)
+	{
+		m_entriesIndex[m_entries.at(i).identifier] = i;
+
+		if (m_entries.at(i).lastReadTime.isNull())
+		{
+			++m_unreadEntriesAmount;
+		}
+	}
 }
 
 void Feed::setUpdateInterval(int interval)
@@ -176,21 +275,19 @@ void Feed::setUpdateInterval(int interval)
 
 	m_updateInterval = interval;
 
-	if (interval <= 0 && m_updateTimer)
+	if (m_updateTask != 0)
 	{
-		m_updateTimer->deleteLater();
-		m_updateTimer = nullptr;
+		TasksManager::removeTask(m_updateTask);
+
+		m_updateTask = 0;
 	}
-	else
+
+	if (interval > 0)
 	{
-		if (!m_updateTimer)
+		m_updateTask = TasksManager::registerTask((static_cast<uint>(interval) * 60), true, [&]()
 		{
-			m_updateTimer = new LongTermTimer(this);
-
-			connect(m_updateTimer, &LongTermTimer::timeout, this, &Feed::update);
-		}
-
-		m_updateTimer->start(static_cast<quint64>(interval) * 60000);
+			update();
+		}, this, TasksManager::NetworkTask);
 	}
 
 	emit feedModified(this);
@@ -209,6 +306,7 @@ void Feed::update()
 	emit feedModified(this);
 
 	DataFetchJob *dataJob(new DataFetchJob(m_url, this));
+	dataJob->setConditional(!m_entries.isEmpty());
 
 	connect(dataJob, &DataFetchJob::progressChanged, this, [&](int progress)
 	{
@@ -223,6 +321,8 @@ void Feed::update()
 			m_error = DownloadError;
 			m_isUpdating = false;
 
+			TasksManager::reportTaskResult(m_updateTask, false);
+
 			Console::addMessage(tr("Failed to download feed"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
 
 			emit feedModified(this);
@@ -230,6 +330,20 @@ void Feed::update()
 			return;
 		}
 
+		if (dataJob->isNotModified())
+		{
+			m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
+			m_updateProgress = -1;
+			m_isUpdating = false;
+
+			TasksManager::reportTaskResult(m_updateTask, true);
+
+			emit updateProgressChanged(-1);
+			emit feedModified(this);
+
+			return;
+		}
+
 		m_parser = FeedParser::createParser(this, dataJob);
 
 		if (!m_parser)
@@ -237,6 +351,9 @@ void Feed::update()
 			m_error = ParseError;
 			m_isUpdating = false;
 
+			DataFetchJob::confirmValidators(m_url, false);
+			TasksManager::reportTaskResult(m_updateTask, false);
+
 			Console::addMessage(tr("Failed to parse feed: unknown feed format"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
 
 			emit feedModified(this);
@@ -244,148 +361,213 @@ void Feed::update()
 			return;
 		}
 
-		m_parser->moveToThread(&m_parserThread);
+		const QByteArray data(dataJob->getData()->readAll());
+		const QUrl url(m_url);
+		const QVector<Entry> entries(m_entries);
+		const QHash<QString, int> entriesIndex(m_entriesIndex);
+		const QSet<QString> removedEntries(m_removedEntries);
+		FeedParser *parser(m_parser);
+		QSharedPointer<ParsingResult> parsingResult(new ParsingResult());
+
+		m_parsingResult = parsingResult;
 
-		connect(m_parser, &FeedParser::parsingFinished, m_parser, [&](bool isParsingSuccess)
+		m_parserWatcher->setFuture(TasksManager::runInBackground([=]()
 		{
-			const FeedParser::FeedInformation information(m_parser->getInformation());
+			const bool isSuccess(parser->parse(data, url));
 
-			if (!isParsingSuccess)
-			{
-				m_error = ParseError;
-			}
+			*parsingResult = mergeEntries(parser->getInformation().entries, entries, entriesIndex, removedEntries);
+			parsingResult->isSuccess = isSuccess;
+		}, TasksManager::ComputationWorker));
 
-			if (m_icon.isNull() && information.icon.isValid())
-			{
-				IconFetchJob *iconJob(new IconFetchJob(information.icon, this));
+		m_updateProgress = -1;
 
-				connect(iconJob, &IconFetchJob::jobFinished, this, [=](bool isIconFetchSuccess)
-				{
-					if (isIconFetchSuccess)
-					{
-						setIcon(iconJob->getIcon());
-					}
-				});
+		emit updateProgressChanged(-1);
+	});
 
-				iconJob->start();
-			}
+	dataJob->start();
+}
+
+void Feed::handleParsingFinished()
+{
+	if (!m_parser)
+	{
+		return;
+	}
+
+	const FeedParser::FeedInformation information(m_parser->getInformation());
+	const ParsingResult result(m_parsingResult ? *m_parsingResult : ParsingResult());
+
+	m_parsingResult.reset();
 
-			if (m_title.isEmpty())
+	if (!result.isSuccess)
+	{
+		m_error = ParseError;
+	}
+
+	DataFetchJob::confirmValidators(m_url, result.isSuccess);
+	TasksManager::reportTaskResult(m_updateTask, result.isSuccess);
+
+	if (m_icon.isNull() && information.icon.isValid())
+	{
+		IconFetchJob *iconJob(new IconFetchJob(information.icon, this));
+
+		connect(iconJob, &IconFetchJob::jobFinished, this, [=](bool isIconFetchSuccess)
+		{
+			if (isIconFetchSuccess)
 			{
-				m_title = information.title;
+				setIcon(iconJob->getIcon());
 			}
+		});
+
+		iconJob->start();
+	}
 
-			if (m_description.isEmpty())
+	if (m_title.isEmpty())
+	{
+		m_title = information.title;
+	}
+
+	if (m_description.isEmpty())
+	{
+		m_description = information.description;
+	}
+
+	if (!information.entries.isEmpty())
+	{
+		for (int i = 0; i < result.updatedEntries.count(); ++i)
+		{
+			Entry entry(result.updatedEntries.at(i));
+			const int index(m_entriesIndex.value(entry.identifier, -1));
+
+			if (index >= 0)
 			{
-				m_description = information.description;
+				entry.lastReadTime = m_entries.at(index).lastReadTime;
+
+				m_entries[index] = entry;
 			}
+		}
+
+		if (!result.addedEntries.isEmpty())
+		{
+			QVector<Entry> entries;
+			entries.reserve(result.addedEntries.count() + m_entries.count());
 
-			if (!information.entries.isEmpty())
+			for (int i = (result.addedEntries.count() - 1); i >= 0; --i)
 			{
-				QStringList existingRemovedEntries;
-				int amount(0);
+				const Entry &entry(result.addedEntries.at(i));
 
-				for (int i = (information.entries.count() - 1); i >= 0; --i)
+				if (!m_entriesIndex.contains(entry.identifier) && !m_removedEntries.contains(entry.identifier))
 				{
-					Feed::Entry entry(information.entries.at(i));
+					entries.append(entry);
+				}
+			}
 
-					if (m_removedEntries.contains(entry.identifier))
-					{
-						existingRemovedEntries.append(entry.identifier);
+			entries.append(m_entries);
 
-						continue;
-					}
+			m_entries = entries;
+		}
 
-					bool hasEntry(false);
+		m_removedEntries.subtract(result.obsoleteRemovedEntries);
+		m_areEntriesModified = true;
 
-					for (int j = 0; j < m_entries.count(); ++j)
-					{
-						const Feed::Entry existingEntry(m_entries.at(j));
+		expireEntries();
+		updateIndex();
 
-						if (existingEntry.identifier != entry.identifier)
-						{
-							continue;
-						}
+		if (result.amount > 0)
+		{
+			Notification::Message message;
+			message.message = getTitle() + QLatin1Char('\n') + tr("%n new message(s)", nullptr, result.amount);
+			message.icon = getIcon();
+			message.event = NotificationsManager::FeedUpdatedEvent;
 
-						if ((entry.publicationTime.isValid() && existingEntry.publicationTime != entry.publicationTime) || (entry.updateTime.isValid() && existingEntry.updateTime != entry.updateTime))
-						{
-							++amount;
-						}
+			if (message.icon.isNull())
+			{
+				message.icon = ThemesManager::createIcon(QLatin1String("application-rss+xml"));
+			}
 
-						entry.lastReadTime = existingEntry.lastReadTime;
-						entry.publicationTime = normalizeDateTime(entry.publicationTime);
+			connect(NotificationsManager::createNotification(message, this), &Notification::clicked, this, [&]()
+			{
+				Application::getInstance()->triggerAction(ActionsManager::OpenUrlAction, {{QLatin1String("url"), FeedsManager::createFeedReaderUrl(getUrl())}});
+			});
+		}
 
-						if (entry.updateTime.isValid())
-						{
-							entry.updateTime = normalizeDateTime(entry.updateTime);
-						}
+		emit entriesModified(this);
+	}
 
-						m_entries[j] = entry;
+	m_mimeType = information.mimeType;
+	m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
+	m_lastUpdateTime = information.lastUpdateTime;
+	m_categories = information.categories;
 
-						hasEntry = true;
+	m_parser->deleteLater();
+	m_parser = nullptr;
 
-						break;
-					}
+	m_isUpdating = false;
 
-					if (!hasEntry)
-					{
-						++amount;
+	emit feedModified(this);
+}
 
-						entry.publicationTime = normalizeDateTime(entry.publicationTime);
-						entry.updateTime = normalizeDateTime(entry.updateTime);
+Feed::ParsingResult Feed::mergeEntries(const QVector<Entry> &parsedEntries, const QVector<Entry> &entries, const QHash<QString, int> &entriesIndex, const QSet<QString> &removedEntries)
+{
+	ParsingResult result;
+	QSet<QString> existingRemovedEntries;
+	QHash<QString, int> addedEntriesIndex;
 
-						m_entries.prepend(entry);
-					}
-				}
+	for (int i = (parsedEntries.count() - 1); i >= 0; --i)
+	{
+		Entry entry(parsedEntries.at(i));
 
-				m_removedEntries = existingRemovedEntries;
+		if (removedEntries.contains(entry.identifier))
+		{
+			existingRemovedEntries.insert(entry.identifier);
 
-				if (amount > 0)
-				{
-					Notification::Message message;
-					message.message = getTitle() + QLatin1Char('\n') + tr("%n new message(s)", nullptr, amount);
-					message.icon = getIcon();
-					message.event = NotificationsManager::FeedUpdatedEvent;
-
-					if (message.icon.isNull())
-					{
-						message.icon = ThemesManager::createIcon(QLatin1String("application-rss+xml"));
-					}
-
-					connect(NotificationsManager::createNotification(message, this), &Notification::clicked, this, [&]()
-					{
-						Application::getInstance()->triggerAction(ActionsManager::OpenUrlAction, {{QLatin1String("url"), FeedsManager::createFeedReaderUrl(getUrl())}});
-					});
-				}
+			continue;
+		}
 
-				emit entriesModified(this);
-			}
+		const int index(entriesIndex.value(entry.identifier, -1));
 
-			m_mimeType = information.mimeType;
-			m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
-			m_lastUpdateTime = information.lastUpdateTime;
-			m_categories = information.categories;
+		if (index >= 0)
+		{
+			const Entry &existingEntry(entries.at(index));
 
-			m_parserThread.exit();
+			if ((entry.publicationTime.isValid() && existingEntry.publicationTime != entry.publicationTime) || (entry.updateTime.isValid() && existingEntry.updateTime != entry.updateTime))
+			{
+				++result.amount;
+			}
 
-			m_parser->deleteLater();
-			m_parser = nullptr;
+			entry.publicationTime = normalizeDateTime(entry.publicationTime);
 
-			m_isUpdating = false;
+			if (entry.updateTime.isValid())
+			{
+				entry.updateTime = normalizeDateTime(entry.updateTime);
+			}
 
-			emit feedModified(this);
-		});
+			result.updatedEntries.append(entry);
+		}
+		else
+		{
+			entry.publicationTime = normalizeDateTime(entry.publicationTime);
+			entry.updateTime = normalizeDateTime(entry.updateTime);
 
-		m_parserThread.start();
+			if (addedEntriesIndex.contains(entry.identifier))
+			{
+				result.addedEntries[addedEntriesIndex[entry.identifier]] = entry;
+			}
+			else
+			{
+				++result.amount;
 
-		m_parser->parse(dataJob);
+				addedEntriesIndex[entry.identifier] = result.addedEntries.count();
 
-		m_updateProgress = -1;
+				result.addedEntries.append(entry);
+			}
+		}
+	}
 
-		emit updateProgressChanged(-1);
-	});
+	result.obsoleteRemovedEntries = removedEntries;
+	result.obsoleteRemovedEntries.subtract(existingRemovedEntries);
 
-	dataJob->start();
+	return result;
 }
 
 QString Feed::getTitle() const
@@ -437,7 +619,7 @@ QMap<QString, QString> Feed::getCategories() const
 
 QStringList Feed::getRemovedEntries() const
 {
-	return m_removedEntries;
+	return m_removedEntries.values();
 }
 
 QVector<Feed::Entry> Feed::getEntries(const QStringList &categories) const
@@ -480,17 +662,7 @@ Feed::FeedError Feed::getError() const
 
 int Feed::getUnreadEntriesAmount() const
 {
-	int amount(0);
-
-	for (int i = 0; i < m_entries.count(); ++i)
-	{
-		if (m_entries.at(i).lastReadTime.isNull())
-		{
-			++amount;
-		}
-	}
-
-	return amount;
+	return m_unreadEntriesAmount;
 }
 
 int Feed::getUpdateInterval() const
@@ -513,23 +685,10 @@ FeedsModel* FeedsManager::m_model(nullptr);
 QVector<Feed*> FeedsManager::m_feeds;
 bool FeedsManager::m_isInitialized(false);
 
-FeedsManager::FeedsManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+FeedsManager::FeedsManager(QObject *parent) : QObject(parent)
 {
 }
 
-void FeedsManager::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == m_saveTimer)
-	{
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		save();
-	}
-}
-
 void FeedsManager::createInstance()
 {
 	if (!m_instance)
@@ -562,7 +721,6 @@ void FeedsManager::ensureInitialized()
 			feed->setDescription(feedObject.value(QLatin1String("description")).toString());
 			feed->setLastUpdateTime(QDateTime::fromString(feedObject.value(QLatin1String("lastUpdateTime")).toString(), Qt::ISODate));
 			feed->setLastSynchronizationTime(QDateTime::fromString(feedObject.value(QLatin1String("lastSynchronizationTime")).toString(), Qt::ISODate));
-			feed->setRemovedEntries(feedObject.value(QLatin1String("removedEntries")).toVariant().toStringList());
 
 			if (feedObject.contains(QLatin1String("categories")))
 			{
@@ -578,30 +736,23 @@ void FeedsManager::ensureInitialized()
 				feed->setCategories(categories);
 			}
 
-			const QJsonArray entriesArray(feedObject.value(QLatin1String("entries")).toArray());
-			QVector<Feed::Entry> entries;
-			entries.reserve(entriesArray.count());
-
-			for (int j = 0; j < entriesArray.count(); ++j)
+			if (feedObject.contains(QLatin1String("entries")))
 			{
-				const QJsonObject entryObject(entriesArray.at(j).toObject());
-				Feed::Entry entry;
-				entry.identifier = entryObject.value(QLatin1String("identifier")).toString();
-				entry.title = entryObject.value(QLatin1String("title")).toString();
-				entry.summary = entryObject.value(QLatin1String("summary")).toString();
-				entry.content = entryObject.value(QLatin1String("content")).toString();
-				entry.author = entryObject.value(QLatin1String("author")).toString();
-				entry.email = entryObject.value(QLatin1String("email")).toString();
-				entry.url = entryObject.value(QLatin1String("url")).toString();
-				entry.lastReadTime = QDateTime::fromString(entryObject.value(QLatin1String("lastReadTime")).toString(), Qt::ISODate);
-				entry.publicationTime = QDateTime::fromString(entryObject.value(QLatin1String("publicationTime")).toString(), Qt::ISODate);
-				entry.updateTime = QDateTime::fromString(entryObject.value(QLatin1String("updateTime")).toString(), Qt::ISODate);
-				entry.categories = entryObject.value(QLatin1String("categories")).toVariant().toStringList();
-
-				entries.append(entry);
+				readEntries(feed, feedObject);
+
+				feed->m_areEntriesModified = true;
 			}
+			else
+			{
+				QFile entriesFile(getEntriesPath(feed->getUrl()));
+
+				if (entriesFile.open(QIODevice::ReadOnly))
+				{
+					readEntries(feed, QJsonDocument::fromJson(entriesFile.readAll()).object());
 
-			feed->setEntries(entries);
+					entriesFile.close();
+				}
+			}
 		}
 	}
 
@@ -617,18 +768,16 @@ void FeedsManager::scheduleSave()
 {
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		save();
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(1000);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			save();
+		});
 	}
 }
 
@@ -651,11 +800,14 @@ void FeedsManager::save()
 		return;
 	}
 
+	Utils::ensureDirectoryExists(SessionsManager::getWritableDataPath(QLatin1String("feeds")));
+
 	QJsonArray feedsArray;
+	QSet<QString> entriesFiles;
 
 	for (int i = 0; i < m_feeds.count(); ++i)
 	{
-		const Feed *feed(m_feeds.at(i));
+		Feed *feed(m_feeds.at(i));
 
 		if (!FeedsManager::getModel()->hasFeed(feed->getUrl()) && !BookmarksManager::getModel()->hasFeed(feed->getUrl()))
 		{
@@ -688,77 +840,145 @@ void FeedsManager::save()
 			feedObject.insert(QLatin1String("categories"), categoriesObject);
 		}
 
-		if (!feed->getRemovedEntries().isEmpty())
+		feedsArray.append(feedObject);
+
+		const QString entriesPath(getEntriesPath(feed->getUrl()));
+
+		entriesFiles.insert(QFileInfo(entriesPath).fileName());
+
+		if (!feed->m_areEntriesModified && QFile::exists(entriesPath))
 		{
-			feedObject.insert(QLatin1String("removedEntries"), QJsonArray::fromStringList(feed->getRemovedEntries()));
+			continue;
 		}
 
-		const QVector<Feed::Entry> entries(feed->getEntries());
-		QJsonArray entriesArray;
+		QSaveFile entriesFile(entriesPath);
 
-		for (int j = 0; j < entries.count(); ++j)
+		if (entriesFile.open(QIODevice::WriteOnly))
 		{
-			const Feed::Entry &entry(entries.at(j));
-			QJsonObject entryObject({{QLatin1String("identifier"), entry.identifier}, {QLatin1String("title"), entry.title}});
+			entriesFile.write(QJsonDocument(writeEntries(feed)).toJson(QJsonDocument::Compact));
 
-			if (!entry.summary.isEmpty())
+			if (entriesFile.commit())
 			{
-				entryObject.insert(QLatin1String("summary"), entry.summary);
+				feed->m_areEntriesModified = false;
 			}
+		}
+	}
 
-			if (!entry.content.isEmpty())
-			{
-				entryObject.insert(QLatin1String("content"), entry.content);
-			}
+	const QStringList existingEntriesFiles(QDir(SessionsManager::getWritableDataPath(QLatin1String("feeds"))).entryList({QLatin1String("*.json")}, QDir::Files));
 
-			if (!entry.author.isEmpty())
-			{
-				entryObject.insert(QLatin1String("author"), entry.author);
-			}
+	for (int i = 0; i < existingEntriesFiles.count(); ++i)
+	{
+		if (!entriesFiles.contains(existingEntriesFiles.at(i)))
+		{
+			QFile::remove(SessionsManager::getWritableDataPath(QLatin1String("feeds/") + existingEntriesFiles.at(i)));
+		}
+	}
 
-			if (!entry.email.isEmpty())
-			{
-				entryObject.insert(QLatin1String("email"), entry.email);
-			}
+	QJsonDocument document;
+	document.setArray(feedsArray);
 
-			if (!entry.url.isEmpty())
-			{
-				entryObject.insert(QLatin1String("url"), entry.url.toString());
-			}
+	file.write(document.toJson());
+	file.commit();
+}
 
-			if (entry.lastReadTime.isValid())
-			{
-				entryObject.insert(QLatin1String("lastReadTime"), entry.lastReadTime.toString(Qt::ISODate));
-			}
+void FeedsManager::readEntries(Feed *feed, const QJsonObject &object)
+{
+	feed->setRemovedEntries(object.value(QLatin1String("removedEntries")).toVariant().toStringList());
 
-			if (entry.publicationTime.isValid())
-			{
-				entryObject.insert(QLatin1String("publicationTime"), entry.publicationTime.toString(Qt::ISODate));
-			}
+	const QJsonArray entriesArray(object.value(QLatin1String("entries")).toArray());
+	QVector<Feed::Entry> entries;
+	entries.reserve(entriesArray.count());
 
-			if (entry.updateTime.isValid())
-			{
-				entryObject.insert(QLatin1String("updateTime"), entry.updateTime.toString(Qt::ISODate));
-			}
+	for (int i = 0; i < entriesArray.count(); ++i)
+	{
+		const QJsonObject entryObject(entriesArray.at(i).toObject());
+		Feed::Entry entry;
+		entry.identifier = entryObject.value(QLatin1String("identifier")).toString();
+		entry.title = entryObject.value(QLatin1String("title")).toString();
+		entry.summary = entryObject.value(QLatin1String("summary")).toString();
+		entry.content = entryObject.value(QLatin1String("content")).toString();
+		entry.author = entryObject.value(QLatin1String("author")).toString();
+		entry.email = entryObject.value(QLatin1String("email")).toString();
+		entry.url = entryObject.value(QLatin1String("url")).toString();
+		entry.lastReadTime = QDateTime::fromString(entryObject.value(QLatin1String("lastReadTime")).toString(), Qt::ISODate);
+		entry.publicationTime = QDateTime::fromString(entryObject.value(QLatin1String("publicationTime")).toString(), Qt::ISODate);
+		entry.updateTime = QDateTime::fromString(entryObject.value(QLatin1String("updateTime")).toString(), Qt::ISODate);
+		entry.categories = entryObject.value(QLatin1String("categories")).toVariant().toStringList();
+
+		entries.append(entry);
+	}
 
-			if (!entry.categories.isEmpty())
-			{
-				entryObject.insert(QLatin1String("categories"), QJsonArray::fromStringList(entry.categories));
-			}
+	feed->setEntries(entries);
+}
+
+QJsonObject FeedsManager::writeEntries(const Feed *feed)
+{
+	QJsonObject mainObject;
+
+	if (!feed->m_removedEntries.isEmpty())
+	{
+		mainObject.insert(QLatin1String("removedEntries"), QJsonArray::fromStringList(feed->getRemovedEntries()));
+	}
+
+	const QVector<Feed::Entry> entries(feed->getEntries());
+	QJsonArray entriesArray;
 
-			entriesArray.append(entryObject);
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const Feed::Entry &entry(entries.at(i));
+		QJsonObject entryObject({{QLatin1String("identifier"), entry.identifier}, {QLatin1String("title"), entry.title}});
+
+		if (!entry.summary.isEmpty())
+		{
+			entryObject.insert(QLatin1String("summary"), entry.summary);
 		}
 
-		feedObject.insert(QLatin1String("entries"), entriesArray);
+		if (!entry.content.isEmpty())
+		{
+			entryObject.insert(QLatin1String("content"), entry.content);
+		}
 
-		feedsArray.append(feedObject);
+		if (!entry.author.isEmpty())
+		{
+			entryObject.insert(QLatin1String("author"), entry.author);
+		}
+
+		if (!entry.email.isEmpty())
+		{
+			entryObject.insert(QLatin1String("email"), entry.email);
+		}
+
+		if (!entry.url.isEmpty())
+		{
+			entryObject.insert(QLatin1String("url"), entry.url.toString());
+		}
+
+		if (entry.lastReadTime.isValid())
+		{
+			entryObject.insert(QLatin1String("lastReadTime"), entry.lastReadTime.toString(Qt::ISODate));
+		}
+
+		if (entry.publicationTime.isValid())
+		{
+			entryObject.insert(QLatin1String("publicationTime"), entry.publicationTime.toString(Qt::ISODate));
+		}
+
+		if (entry.updateTime.isValid())
+		{
+			entryObject.insert(QLatin1String("updateTime"), entry.updateTime.toString(Qt::ISODate));
+		}
+
+		if (!entry.categories.isEmpty())
+		{
+			entryObject.insert(QLatin1String("categories"), QJsonArray::fromStringList(entry.categories));
+		}
+
+		entriesArray.append(entryObject);
 	}
 
-	QJsonDocument document;
-	document.setArray(feedsArray);
+	mainObject.insert(QLatin1String("entries"), entriesArray);
 
-	file.write(document.toJson());
-	file.commit();
+	return mainObject;
 }
 
 FeedsManager* FeedsManager::getInstance()
@@ -822,6 +1042,11 @@ QUrl FeedsManager::createFeedReaderUrl(const QUrl &url)
 	return QUrl(QLatin1String("feed:") + url.toDisplayString());
 }
 
+QString FeedsManager::getEntriesPath(const QUrl &url)
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("feeds/") + QString::fromLatin1(QCryptographicHash::hash(url.toString().toUtf8(), QCryptographicHash::Md5).toHex()) + QLatin1String(".json"));
+}
+
 QVector<Feed*> FeedsManager::getFeeds()
 {
 	ensureInitialized();
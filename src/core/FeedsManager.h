@@ -23,15 +23,17 @@
 #include "FeedsModel.h"
 
 #include <QtCore/QDateTime>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMimeType>
-#include <QtCore/QThread>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
 
 namespace Otter
 {
 
 class FeedsManager;
 class FeedParser;
-class LongTermTimer;
 
 class Feed final : public QObject
 {
@@ -61,6 +63,7 @@ public:
 	};
 
 	explicit Feed(const QString &title, const QUrl &url, const QIcon &icon, int updateInterval, QObject *parent = nullptr);
+	~Feed();
 
 	void markEntryAsRead(const QString &identifier);
 	void markAllEntriesAsRead();
@@ -92,15 +95,30 @@ public slots:
 	void update();
 
 protected:
+	struct ParsingResult final
+	{
+		QVector<Entry> addedEntries;
+		QVector<Entry> updatedEntries;
+		QSet<QString> obsoleteRemovedEntries;
+		int amount = 0;
+		bool isSuccess = false;
+	};
+
 	void setCategories(const QMap<QString, QString> &categories);
 	void setRemovedEntries(const QStringList &removedEntries);
 	void setEntries(const QVector<Entry> &entries);
+	void expireEntries();
+	void updateIndex();
+	static ParsingResult mergeEntries(const QVector<Entry> &parsedEntries, const QVector<Entry> &entries, const QHash<QString, int> &entriesIndex, const QSet<QString> &removedEntries);
 	static QDateTime normalizeDateTime(const QDateTime &time);
 
+protected slots:
+	void handleParsingFinished();
+
 private:
-	LongTermTimer *m_updateTimer;
 	FeedParser *m_parser;
-	QThread m_parserThread;
+	QFutureWatcher<void> *m_parserWatcher;
+	QSharedPointer<ParsingResult> m_parsingResult;
 	QString m_title;
 	QString m_description;
 	QUrl m_url;
@@ -109,11 +127,15 @@ private:
 	QDateTime m_lastSynchronizationTime;
 	QMimeType m_mimeType;
 	QMap<QString, QString> m_categories;
-	QStringList m_removedEntries;
+	QSet<QString> m_removedEntries;
 	QVector<Entry> m_entries;
+	QHash<QString, int> m_entriesIndex;
 	FeedError m_error;
+	quint64 m_updateTask;
 	int m_updateInterval;
 	int m_updateProgress;
+	int m_unreadEntriesAmount;
+	bool m_areEntriesModified;
 	bool m_isUpdating;
 
 signals:
@@ -130,6 +152,7 @@ class FeedsManager final : public QObject
 
 public:
 	static void createInstance();
+	static void ensureInitialized();
 	static FeedsManager* getInstance();
 	static FeedsModel* getModel();
 	static Feed* createFeed(const QUrl &url, const QString &title = {}, const QIcon &icon = {}, int updateInterval = -1);
@@ -140,16 +163,15 @@ public:
 protected:
 	explicit FeedsManager(QObject *parent);
 
-	void timerEvent(QTimerEvent *event) override;
-	static void ensureInitialized();
+	static void readEntries(Feed *feed, const QJsonObject &object);
 	void save();
+	static QString getEntriesPath(const QUrl &url);
+	static QJsonObject writeEntries(const Feed *feed);
 
 protected slots:
 	void scheduleSave();
 
 private:
-	int m_saveTimer;
-
 	static FeedsManager *m_instance;
 	static FeedsModel *m_model;
 	static QVector<Feed*> m_feeds;
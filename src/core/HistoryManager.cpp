@@ -23,6 +23,7 @@
 #include "Application.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "TasksManager.h"
 #include "ThemesManager.h"
 
 #include <QtCore/QTimerEvent>
@@ -36,8 +37,7 @@ HistoryModel* HistoryManager::m_typedHistoryModel(nullptr);
 bool HistoryManager::m_isEnabled(false);
 bool HistoryManager::m_isStoringFavicons(true);
 
-HistoryManager::HistoryManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+HistoryManager::HistoryManager(QObject *parent) : QObject(parent)
 {
 	m_dayTimer = startTimer(QTime::currentTime().msecsTo(QTime(23, 59, 59, 999)));
 
@@ -57,15 +57,7 @@ void HistoryManager::createInstance()
 
 void HistoryManager::timerEvent(QTimerEvent *event)
 {
-	if (event->timerId() == m_saveTimer)
-	{
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		save();
-	}
-	else if (event->timerId() == m_dayTimer)
+	if (event->timerId() == m_dayTimer)
 	{
 		killTimer(m_dayTimer);
 
@@ -96,18 +88,16 @@ void HistoryManager::scheduleSave()
 {
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		save();
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(1000);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			save();
+		});
 	}
 }
 
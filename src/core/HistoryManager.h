@@ -62,7 +62,6 @@ protected slots:
 
 private:
 	int m_dayTimer;
-	int m_saveTimer;
 
 	static HistoryManager *m_instance;
 	static HistoryModel *m_browsingHistoryModel;
@@ -173,7 +173,7 @@ void HistoryModel::removeEntry(quint64 identifier)
 		return;
 	}
 
-	const QUrl url(Utils::normalizeUrl(entry->getUrl()));
+	const UrlKey url(entry->getUrl());
 
 	if (m_urls.contains(url))
 	{
@@ -203,7 +203,7 @@ HistoryModel::Entry* HistoryModel::addEntry(const QUrl &url, const QString &titl
 
 	if (m_type == TypedHistory && hasEntry(url))
 	{
-		const QVector<Entry*> entries(m_urls[Utils::normalizeUrl(url)]);
+		const QVector<Entry*> entries(m_urls.value(UrlKey(url)));
 
 		for (int i = 0; i < entries.count(); ++i)
 		{
@@ -250,14 +250,7 @@ HistoryModel::Entry* HistoryModel::getEntry(quint64 identifier) const
 
 QDateTime HistoryModel::getLastVisitTime(const QUrl &url) const
 {
-	const QUrl normalizedUrl(Utils::normalizeUrl(url));
-
-	if (!m_urls.contains(normalizedUrl))
-	{
-		return {};
-	}
-
-	const QVector<Entry*> entries(m_urls.value(normalizedUrl));
+	const QVector<Entry*> entries(m_urls.value(UrlKey(url)));
 	QDateTime lastVisitTime;
 
 	for (int i = 0; i < entries.count(); ++i)
@@ -279,7 +272,7 @@ QVector<HistoryModel::HistoryEntryMatch> HistoryModel::findEntries(const QString
 	QVector<HistoryEntryMatch> allMatches;
 	QVector<HistoryEntryMatch> currentMatches;
 	QMultiMap<QDateTime, HistoryEntryMatch> matchesMap;
-	QHash<QUrl, QVector<Entry*> >::const_iterator urlsIterator;
+	QHash<UrlKey, QVector<Entry*> >::const_iterator urlsIterator;
 
 	for (urlsIterator = m_urls.constBegin(); urlsIterator != m_urls.constEnd(); ++urlsIterator)
 	{
@@ -362,8 +355,8 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 
 	if (role == UrlRole && value.toUrl() != index.data(UrlRole).toUrl())
 	{
-		const QUrl oldUrl(Utils::normalizeUrl(index.data(UrlRole).toUrl()));
-		const QUrl newUrl(Utils::normalizeUrl(value.toUrl()));
+		const UrlKey oldUrl(index.data(UrlRole).toUrl());
+		const UrlKey newUrl(value.toUrl());
 
 		if (!oldUrl.isEmpty() && m_urls.contains(oldUrl))
 		{
@@ -407,7 +400,7 @@ bool HistoryModel::setData(const QModelIndex &index, const QVariant &value, int
 
 bool HistoryModel::hasEntry(const QUrl &url) const
 {
-	return m_urls.contains(Utils::normalizeUrl(url));
+	return m_urls.contains(UrlKey(url));
 }
 
 }
@@ -21,6 +21,8 @@
 #ifndef OTTER_HISTORYMODEL_H
 #define OTTER_HISTORYMODEL_H
 
+#include "Utils.h"
+
 #include <QtCore/QDateTime>
 #include <QtCore/QUrl>
 #include <QtGui/QStandardItemModel>
@@ -88,7 +90,7 @@ public:
 	bool setData(const QModelIndex &index, const QVariant &value, int role) override;
 
 private:
-	QHash<QUrl, QVector<Entry*> > m_urls;
+	QHash<UrlKey, QVector<Entry*> > m_urls;
 	QMap<quint64, Entry*> m_identifiers;
 	HistoryType m_type;
 
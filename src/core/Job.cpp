@@ -20,8 +20,14 @@
 #include "Job.h"
 #include "NetworkManager.h"
 #include "NetworkManagerFactory.h"
+#include "SessionsManager.h"
 #include "Utils.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
 namespace Otter
 {
 
@@ -79,7 +85,7 @@ void FetchJob::start()
 		return;
 	}
 
-	m_reply = NetworkManagerFactory::createRequest(m_url, QNetworkAccessManager::GetOperation, m_isPrivate);
+	m_reply = NetworkManagerFactory::createRequest(m_url, QNetworkAccessManager::GetOperation, m_isPrivate, nullptr, m_headers);
 
 	connect(m_reply, &QNetworkReply::downloadProgress, this, [&](qint64 bytesReceived, qint64 bytesTotal)
 	{
@@ -151,33 +157,205 @@ void FetchJob::setPrivate(bool isPrivate)
 	m_isPrivate = isPrivate;
 }
 
+void FetchJob::setHeader(const QByteArray &name, const QByteArray &value)
+{
+	m_headers[name] = value;
+}
+
 QUrl FetchJob::getUrl() const
 {
 	return (m_reply ? m_reply->request().url() : m_url);
 }
 
+bool FetchJob::isPrivate() const
+{
+	return m_isPrivate;
+}
+
 bool FetchJob::isRunning() const
 {
 	return (m_reply != nullptr);
 }
 
+QHash<QString, DataFetchJob::CacheValidators> DataFetchJob::m_validators;
+QHash<QString, DataFetchJob::CacheValidators> DataFetchJob::m_pendingValidators;
+bool DataFetchJob::m_areValidatorsLoaded(false);
+
 DataFetchJob::DataFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, parent),
-	m_reply(nullptr)
+	m_reply(nullptr),
+	m_isConditional(false),
+	m_isNotModified(false)
 {
 }
 
 void DataFetchJob::handleSuccessfulReply(QNetworkReply *reply)
 {
 	m_reply = reply;
+	m_isNotModified = (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304);
+
+	if (m_isConditional && !m_isNotModified)
+	{
+		CacheValidators validators;
+		validators.entityTag = reply->rawHeader(QByteArrayLiteral("ETag"));
+		validators.lastModified = reply->rawHeader(QByteArrayLiteral("Last-Modified"));
+
+		m_pendingValidators[m_validatorsUrl] = validators;
+	}
 
 	markAsFinished();
 }
 
+void DataFetchJob::confirmValidators(const QUrl &url, bool isValid)
+{
+	const QString validatorsUrl(url.toString());
+
+	loadValidators();
+
+	if (!isValid)
+	{
+		m_pendingValidators.remove(validatorsUrl);
+
+		if (m_validators.remove(validatorsUrl) > 0)
+		{
+			saveValidators();
+		}
+
+		return;
+	}
+
+	if (!m_pendingValidators.contains(validatorsUrl))
+	{
+		return;
+	}
+
+	const CacheValidators validators(m_pendingValidators.take(validatorsUrl));
+
+	if (validators.entityTag.isEmpty() && validators.lastModified.isEmpty())
+	{
+		if (m_validators.remove(validatorsUrl) > 0)
+		{
+			saveValidators();
+		}
+	}
+	else
+	{
+		m_validators[validatorsUrl] = validators;
+
+		saveValidators();
+	}
+}
+
+void DataFetchJob::loadValidators()
+{
+	if (m_areValidatorsLoaded)
+	{
+		return;
+	}
+
+	m_areValidatorsLoaded = true;
+
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("validators.json")));
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		return;
+	}
+
+	const QJsonObject mainObject(QJsonDocument::fromJson(file.readAll()).object());
+	QJsonObject::const_iterator iterator;
+
+	for (iterator = mainObject.constBegin(); iterator != mainObject.constEnd(); ++iterator)
+	{
+		const QJsonObject validatorsObject(iterator.value().toObject());
+		CacheValidators validators;
+		validators.entityTag = validatorsObject.value(QLatin1String("entityTag")).toString().toLatin1();
+		validators.lastModified = validatorsObject.value(QLatin1String("lastModified")).toString().toLatin1();
+
+		m_validators[iterator.key()] = validators;
+	}
+
+	file.close();
+}
+
+void DataFetchJob::saveValidators()
+{
+	if (SessionsManager::isReadOnly())
+	{
+		return;
+	}
+
+	QSaveFile file(SessionsManager::getWritableDataPath(QLatin1String("validators.json")));
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return;
+	}
+
+	QJsonObject mainObject;
+	QHash<QString, CacheValidators>::const_iterator iterator;
+
+	for (iterator = m_validators.constBegin(); iterator != m_validators.constEnd(); ++iterator)
+	{
+		QJsonObject validatorsObject;
+
+		if (!iterator.value().entityTag.isEmpty())
+		{
+			validatorsObject.insert(QLatin1String("entityTag"), QString::fromLatin1(iterator.value().entityTag));
+		}
+
+		if (!iterator.value().lastModified.isEmpty())
+		{
+			validatorsObject.insert(QLatin1String("lastModified"), QString::fromLatin1(iterator.value().lastModified));
+		}
+
+		mainObject.insert(iterator.key(), validatorsObject);
+	}
+
+	file.write(QJsonDocument(mainObject).toJson(QJsonDocument::Compact));
+	file.commit();
+}
+
+void DataFetchJob::setConditional(bool isConditional)
+{
+	m_isConditional = (isConditional && !isPrivate());
+
+	if (!m_isConditional)
+	{
+		return;
+	}
+
+	loadValidators();
+
+	m_validatorsUrl = getUrl().toString();
+
+	if (!m_validators.contains(m_validatorsUrl))
+	{
+		return;
+	}
+
+	const CacheValidators validators(m_validators[m_validatorsUrl]);
+
+	if (!validators.entityTag.isEmpty())
+	{
+		setHeader(QByteArrayLiteral("If-None-Match"), validators.entityTag);
+	}
+
+	if (!validators.lastModified.isEmpty())
+	{
+		setHeader(QByteArrayLiteral("If-Modified-Since"), validators.lastModified);
+	}
+}
+
 QIODevice* DataFetchJob::getData() const
 {
 	return m_reply;
 }
 
+bool DataFetchJob::isNotModified() const
+{
+	return m_isNotModified;
+}
+
 QMap<QByteArray, QByteArray> DataFetchJob::getHeaders() const
 {
 	QMap<QByteArray, QByteArray> headers;
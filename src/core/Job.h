@@ -62,6 +62,7 @@ public:
 	void setTimeout(int seconds);
 	void setSizeLimit(qint64 limit);
 	void setPrivate(bool isPrivate);
+	void setHeader(const QByteArray &name, const QByteArray &value);
 	QUrl getUrl() const;
 	bool isRunning() const override;
 
@@ -74,10 +75,12 @@ protected:
 	void markAsFailure();
 	void markAsFinished();
 	virtual void handleSuccessfulReply(QNetworkReply *reply) = 0;
+	bool isPrivate() const;
 
 private:
 	QNetworkReply *m_reply;
 	QUrl m_url;
+	QMap<QByteArray, QByteArray> m_headers;
 	qint64 m_sizeLimit;
 	int m_timeoutTimer;
 	bool m_isFinished;
@@ -92,14 +95,32 @@ class DataFetchJob final : public FetchJob
 public:
 	explicit DataFetchJob(const QUrl &url, QObject *parent = nullptr);
 
+	void setConditional(bool isConditional);
 	QIODevice* getData() const;
 	QMap<QByteArray, QByteArray> getHeaders() const;
+	bool isNotModified() const;
+	static void confirmValidators(const QUrl &url, bool isValid);
 
 protected:
+	struct CacheValidators final
+	{
+		QByteArray entityTag;
+		QByteArray lastModified;
+	};
+
 	void handleSuccessfulReply(QNetworkReply *reply) override;
+	static void loadValidators();
+	static void saveValidators();
 
 private:
 	QNetworkReply *m_reply;
+	QString m_validatorsUrl;
+	bool m_isConditional;
+	bool m_isNotModified;
+
+	static QHash<QString, CacheValidators> m_validators;
+	static QHash<QString, CacheValidators> m_pendingValidators;
+	static bool m_areValidatorsLoaded;
 };
 
 class IconFetchJob final : public FetchJob
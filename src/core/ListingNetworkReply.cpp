@@ -36,8 +36,13 @@ ListingNetworkReply::ListingNetworkReply(const QNetworkRequest &request, QObject
 	setRequest(request);
 }
 
-QByteArray ListingNetworkReply::createListing(const QString &title, const QVector<ListingNetworkReply::NavigationEntry> &navigation, const QVector<ListingNetworkReply::ListingEntry> &entries)
+void ListingNetworkReply::loadTemplate()
 {
+	if (!m_entryTemplate.isEmpty())
+	{
+		return;
+	}
+
 	const QRegularExpression entryExpression(QLatin1String("<!--entry:begin-->(.*)<!--entry:end-->"), (QRegularExpression::DotMatchesEverythingOption | QRegularExpression::MultilineOption));
 	QFile file(SessionsManager::getReadableDataPath(QLatin1String("files/listing.html")));
 	file.open(QIODevice::ReadOnly | QIODevice::Text);
@@ -45,28 +50,27 @@ QByteArray ListingNetworkReply::createListing(const QString &title, const QVecto
 	QTextStream stream(&file);
 	stream.setCodec("UTF-8");
 
-	QString navigationHtml;
-	QString entriesHtml;
-	QString listingTemplate(stream.readAll());
-	const QString entryTemplate(entryExpression.match(listingTemplate).captured(1));
+	const QString listingTemplate(stream.readAll());
+	const QRegularExpressionMatch match(entryExpression.match(listingTemplate));
 
-	listingTemplate.replace(entryExpression, QLatin1String("{entries}"));
-
-	for (int i = 0; i < navigation.count(); ++i)
-	{
-		const NavigationEntry entry(navigation.at(i));
+	m_headerTemplate = listingTemplate.left(match.capturedStart());
+	m_entryTemplate = match.captured(1);
+	m_footerTemplate = listingTemplate.mid(match.capturedEnd());
+}
 
-		navigationHtml.append(QStringLiteral("<a href=\"%1\">%2</a>").arg(entry.url.toString(), entry.name) + ((i < (navigation.count() - 1)) ? QLatin1String("&shy;") : QString()));
-	}
+QString ListingNetworkReply::createEntries(const QVector<ListingNetworkReply::ListingEntry> &entries, QString *style)
+{
+	loadTemplate();
 
-	QHash<QString, QIcon> icons;
+	QString entriesHtml;
 	const QFileIconProvider iconProvider;
+	const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
 
 	for (int i = 0; i < entries.count(); ++i)
 	{
 		const ListingEntry &entry(entries.at(i));
 
-		if (!icons.contains(entry.mimeType.name()))
+		if (!m_icons.contains(entry.mimeType.name()))
 		{
 			QIcon icon;
 
@@ -110,7 +114,9 @@ QByteArray ListingNetworkReply::createListing(const QString &title, const QVecto
 				}
 			}
 
-			icons[entry.mimeType.name()] = icon;
+			m_icons[entry.mimeType.name()] = icon;
+
+			style->append(QStringLiteral("tr td:first-child.icon_%1\n{\n\tbackground-image:url(\"%2\");\n}\n").arg(Utils::createIdentifier(entry.mimeType.name()), Utils::savePixmapAsDataUri(icon.pixmap(iconSize, iconSize))));
 		}
 
 		QStringList classes;
@@ -140,31 +146,65 @@ QByteArray ListingNetworkReply::createListing(const QString &title, const QVecto
 		variables[QLatin1String("size")] = ((entry.type == ListingEntry::FileType) ? Utils::formatUnit(entry.size, false, 2) : QString());
 		variables[QLatin1String("lastModified")] = Utils::formatDateTime(entry.timeModified).toHtmlEscaped();
 
-		entriesHtml.append(Utils::substitutePlaceholders(entryTemplate, variables));
+		entriesHtml.append(Utils::substitutePlaceholders(m_entryTemplate, variables));
 	}
 
-	QString styleHtml;
-	const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
-	QHash<QString, QIcon>::iterator iterator;
+	return entriesHtml;
+}
+
+QByteArray ListingNetworkReply::createListing(const QString &title, const QVector<ListingNetworkReply::NavigationEntry> &navigation, const QVector<ListingNetworkReply::ListingEntry> &entries)
+{
+	QString style;
+	const QString entriesHtml(createEntries(entries, &style));
 
-	for (iterator = icons.begin(); iterator != icons.end(); ++iterator)
+	return (createListingHeader(title, navigation, style) + entriesHtml.toUtf8() + createListingFooter());
+}
+
+QByteArray ListingNetworkReply::createListingHeader(const QString &title, const QVector<ListingNetworkReply::NavigationEntry> &navigation, const QString &style)
+{
+	loadTemplate();
+
+	QString navigationHtml;
+
+	for (int i = 0; i < navigation.count(); ++i)
 	{
-		styleHtml.append(QStringLiteral("tr td:first-child.icon_%1\n{\n\tbackground-image:url(\"%2\");\n}\n").arg(Utils::createIdentifier(iterator.key()), Utils::savePixmapAsDataUri(iterator.value().pixmap(iconSize, iconSize))));
+		const NavigationEntry entry(navigation.at(i));
+
+		navigationHtml.append(QStringLiteral("<a href=\"%1\">%2</a>").arg(entry.url.toString(), entry.name) + ((i < (navigation.count() - 1)) ? QLatin1String("&shy;") : QString()));
 	}
 
 	QHash<QString, QString> variables;
 	variables[QLatin1String("title")] = title.toHtmlEscaped();
 	variables[QLatin1String("description")] = tr("Directory Contents").toHtmlEscaped();
 	variables[QLatin1String("dir")] = (Application::isLeftToRight() ? QLatin1String("ltr") : QLatin1String("rtl"));
-	variables[QLatin1String("style")] = styleHtml;
+	variables[QLatin1String("style")] = style;
 	variables[QLatin1String("navigation")] = navigationHtml;
-	variables[QLatin1String("entries")] = entriesHtml;
 	variables[QLatin1String("headerName")] = tr("Name").toHtmlEscaped();
 	variables[QLatin1String("headerType")] = tr("Type").toHtmlEscaped();
 	variables[QLatin1String("headerSize")] = tr("Size").toHtmlEscaped();
 	variables[QLatin1String("headerDate")] = tr("Date").toHtmlEscaped();
 
-	return Utils::substitutePlaceholders(listingTemplate, variables).toUtf8();
+	return Utils::substitutePlaceholders(m_headerTemplate, variables).toUtf8();
+}
+
+QByteArray ListingNetworkReply::createListingEntries(const QVector<ListingNetworkReply::ListingEntry> &entries)
+{
+	QString style;
+	const QString entriesHtml(createEntries(entries, &style));
+
+	if (style.isEmpty())
+	{
+		return entriesHtml.toUtf8();
+	}
+
+	return (QLatin1String("<style type=\"text/css\">\n") + style + QLatin1String("</style>\n") + entriesHtml).toUtf8();
+}
+
+QByteArray ListingNetworkReply::createListingFooter()
+{
+	loadTemplate();
+
+	return m_footerTemplate.toUtf8();
 }
 
 }
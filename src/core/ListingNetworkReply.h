@@ -20,8 +20,10 @@
 #ifndef OTTER_LISTINGNETWORKREPLY_H
 #define OTTER_LISTINGNETWORKREPLY_H
 
+#include <QtCore/QHash>
 #include <QtCore/QMimeType>
 #include <QtCore/QUrl>
+#include <QtGui/QIcon>
 #include <QtNetwork/QNetworkReply>
 
 namespace Otter
@@ -60,7 +62,18 @@ protected:
 		bool isSymlink = false;
 	};
 
+	void loadTemplate();
+	QString createEntries(const QVector<ListingEntry> &entries, QString *style);
 	QByteArray createListing(const QString &title, const QVector<NavigationEntry> &navigation, const QVector<ListingEntry> &entries);
+	QByteArray createListingHeader(const QString &title, const QVector<NavigationEntry> &navigation, const QString &style = {});
+	QByteArray createListingEntries(const QVector<ListingEntry> &entries);
+	QByteArray createListingFooter();
+
+private:
+	QString m_headerTemplate;
+	QString m_entryTemplate;
+	QString m_footerTemplate;
+	QHash<QString, QIcon> m_icons;
 
 signals:
 	void listingError();
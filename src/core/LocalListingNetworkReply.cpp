@@ -19,10 +19,12 @@
 **************************************************************************/
 
 #include "LocalListingNetworkReply.h"
+#include "TasksManager.h"
 #include "Utils.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QMimeDatabase>
 #include <QtCore/QTimer>
 
@@ -30,7 +32,8 @@ namespace Otter
 {
 
 LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent) : ListingNetworkReply(request, parent),
-	m_offset(0)
+	m_offset(0),
+	m_isAborted(0)
 {
 	setRequest(request);
 	open(QIODevice::ReadOnly | QIODevice::Unbuffered);
@@ -75,16 +78,12 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 		return;
 	}
 
-	QMimeDatabase mimeDatabase;
 	QVector<NavigationEntry> navigation;
 #ifdef Q_OS_WIN32
 	const bool isListingDevices(request.url().toLocalFile() == QLatin1String("/"));
-	const QFileInfoList rawEntries(isListingDevices ? QDir::drives() : directory.entryInfoList((QDir::AllEntries | QDir::Hidden), (QDir::Name | QDir::DirsFirst)));
 #else
-	const QFileInfoList rawEntries(directory.entryInfoList((QDir::AllEntries | QDir::Hidden), (QDir::Name | QDir::DirsFirst)));
+	const bool isListingDevices(false);
 #endif
-	QVector<ListingEntry> entries;
-	entries.reserve(rawEntries.count());
 
 	do
 	{
@@ -113,20 +112,86 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 	navigation.prepend(rootEntry);
 #endif
 
-	for (int i = 0; i < rawEntries.count(); ++i)
+	m_content = createListingHeader(QFileInfo(request.url().toLocalFile()).canonicalFilePath(), navigation);
+
+	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
+
+	QTimer::singleShot(0, this, [&]()
 	{
-		const QFileInfo rawEntry(rawEntries.at(i));
+		emit readyRead();
+	});
+
+	const QString path(request.url().toLocalFile());
+
+	m_listingFuture = TasksManager::runInBackground([=]()
+	{
+		listEntries(path, isListingDevices);
+	}, TasksManager::InputOutputWorker);
+}
+
+LocalListingNetworkReply::~LocalListingNetworkReply()
+{
+	m_isAborted.storeRelaxed(1);
+	m_listingFuture.waitForFinished();
+}
+
+void LocalListingNetworkReply::listEntries(const QString &path, bool isListingDevices)
+{
+	const int batchSize(250);
+	const QMimeDatabase mimeDatabase;
+	QFileInfoList rawEntries;
+
+#ifdef Q_OS_WIN32
+	if (isListingDevices)
+	{
+		rawEntries = QDir::drives();
+	}
+	else
+#else
+	Q_UNUSED(isListingDevices)
+#endif
+	{
+		QDirIterator iterator(path, (QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot));
+
+		while (iterator.hasNext())
+		{
+			if (m_isAborted.loadRelaxed() != 0)
+			{
+				return;
+			}
+
+			iterator.next();
+
+			rawEntries.append(iterator.fileInfo());
+		}
+
+		std::sort(rawEntries.begin(), rawEntries.end(), [&](const QFileInfo &first, const QFileInfo &second)
+		{
+			if (first.isDir() != second.isDir())
+			{
+				return first.isDir();
+			}
+
+			return (first.fileName() < second.fileName());
+		});
+	}
+
+	QVector<ListingEntry> entries;
+	entries.reserve(batchSize);
 
-		if (rawEntry.fileName() == QLatin1String(".") || rawEntry.fileName() == QLatin1String(".."))
+	for (int i = 0; i < rawEntries.count(); ++i)
+	{
+		if (m_isAborted.loadRelaxed() != 0)
 		{
-			continue;
+			return;
 		}
 
+		const QFileInfo rawEntry(rawEntries.at(i));
 		ListingEntry entry;
 		entry.name = rawEntry.fileName();
 		entry.url = QUrl::fromUserInput(rawEntry.filePath());
 		entry.timeModified = rawEntry.lastModified();
-		entry.mimeType = mimeDatabase.mimeTypeForFile(rawEntry.filePath());
+		entry.mimeType = mimeDatabase.mimeTypeForFile(rawEntry);
 		entry.type = (rawEntry.isRoot() ? ListingEntry::DriveType : (rawEntry.isDir() ? ListingEntry::DirectoryType : ListingEntry::FileType));
 		entry.size = rawEntry.size();
 		entry.isSymlink = rawEntry.isSymLink();
@@ -139,22 +204,65 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 #endif
 
 		entries.append(entry);
+
+		if (entries.count() >= batchSize)
+		{
+			QMetaObject::invokeMethod(this, [=]()
+			{
+				appendEntries(entries);
+			}, Qt::QueuedConnection);
+
+			entries.clear();
+		}
 	}
 
-	m_content = createListing(QFileInfo(request.url().toLocalFile()).canonicalFilePath(), navigation, entries);
+	QMetaObject::invokeMethod(this, [=]()
+	{
+		appendEntries(entries);
+		finishListing();
+	}, Qt::QueuedConnection);
+}
 
-	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
-	setHeader(QNetworkRequest::ContentLengthHeader, QVariant(m_content.size()));
+void LocalListingNetworkReply::appendEntries(const QVector<ListingEntry> &entries)
+{
+	if (entries.isEmpty() || m_isAborted.loadRelaxed() != 0)
+	{
+		return;
+	}
 
-	QTimer::singleShot(0, this, [&]()
+	m_content.append(createListingEntries(entries));
+
+	emit readyRead();
+}
+
+void LocalListingNetworkReply::finishListing()
+{
+	if (m_isAborted.loadRelaxed() != 0)
 	{
-		emit readyRead();
-		emit finished();
-	});
+		return;
+	}
+
+	m_content.append(createListingFooter());
+
+	setFinished(true);
+
+	emit readyRead();
+	emit finished();
 }
 
 void LocalListingNetworkReply::abort()
 {
+	if (isFinished() || m_isAborted.loadRelaxed() != 0)
+	{
+		return;
+	}
+
+	m_isAborted.storeRelaxed(1);
+
+	setError(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+	setFinished(true);
+
+	emit finished();
 }
 
 qint64 LocalListingNetworkReply::bytesAvailable() const
@@ -172,6 +280,13 @@ qint64 LocalListingNetworkReply::readData(char *data, qint64 maxSize)
 
 		m_offset += number;
 
+		if (m_offset == m_content.size())
+		{
+			m_content.clear();
+
+			m_offset = 0;
+		}
+
 		return number;
 	}
 
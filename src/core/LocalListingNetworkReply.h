@@ -23,6 +23,9 @@
 
 #include "ListingNetworkReply.h"
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QFuture>
+
 namespace Otter
 {
 
@@ -32,6 +35,7 @@ class LocalListingNetworkReply final : public ListingNetworkReply
 
 public:
 	explicit LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent);
+	~LocalListingNetworkReply();
 
 	qint64 bytesAvailable() const override;
 	qint64 readData(char *data, qint64 maxSize) override;
@@ -40,9 +44,16 @@ public:
 public slots:
 	void abort() override;
 
+protected:
+	void listEntries(const QString &path, bool isListingDevices);
+	void appendEntries(const QVector<ListingEntry> &entries);
+	void finishListing();
+
 private:
+	QFuture<void> m_listingFuture;
 	QByteArray m_content;
 	qint64 m_offset;
+	QAtomicInt m_isAborted;
 };
 
 }
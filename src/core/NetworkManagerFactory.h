@@ -197,7 +197,7 @@ public:
 	static NetworkManager* getNetworkManager(bool isPrivate = false);
 	static NetworkCache* getCache();
 	static CookieJar* getCookieJar();
-	static QNetworkReply* createRequest(const QUrl &url, QNetworkAccessManager::Operation operation = QNetworkAccessManager::GetOperation, bool isPrivate = false, QIODevice *outgoingData = nullptr);
+	static QNetworkReply* createRequest(const QUrl &url, QNetworkAccessManager::Operation operation = QNetworkAccessManager::GetOperation, bool isPrivate = false, QIODevice *outgoingData = nullptr, const QMap<QByteArray, QByteArray> &headers = {});
 	static QString getAcceptLanguage();
 	static QString getUserAgent();
 	static QStringList getProxies();
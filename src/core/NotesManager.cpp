@@ -20,6 +20,7 @@
 #include "NotesManager.h"
 #include "Application.h"
 #include "SessionsManager.h"
+#include "TasksManager.h"
 
 namespace Otter
 {
@@ -27,8 +28,7 @@ namespace Otter
 NotesManager* NotesManager::m_instance(nullptr);
 BookmarksModel* NotesManager::m_model(nullptr);
 
-NotesManager::NotesManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+NotesManager::NotesManager(QObject *parent) : QObject(parent)
 {
 }
 
@@ -40,40 +40,35 @@ void NotesManager::createInstance()
 	}
 }
 
-void NotesManager::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == m_saveTimer)
-	{
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		if (m_model)
-		{
-			m_model->save(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")));
-		}
-	}
-}
-
 void NotesManager::scheduleSave()
 {
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		if (m_model)
 		{
 			m_model->save(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")));
 		}
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(1000);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			if (!m_model)
+			{
+				return;
+			}
+
+			if (Application::isAboutToQuit())
+			{
+				m_model->save(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")));
+			}
+			else
+			{
+				m_model->saveInBackground(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")));
+			}
+		});
 	}
 }
 
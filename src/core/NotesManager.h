@@ -38,14 +38,10 @@ public:
 protected:
 	explicit NotesManager(QObject *parent);
 
-	void timerEvent(QTimerEvent *event) override;
-
 protected slots:
 	void scheduleSave();
 
 private:
-	int m_saveTimer;
-
 	static NotesManager *m_instance;
 	static BookmarksModel *m_model;
 };
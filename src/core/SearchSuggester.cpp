@@ -25,44 +25,49 @@
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QTimerEvent>
 
 namespace Otter
 {
 
+QHash<QString, SearchSuggester::CacheEntry> SearchSuggester::m_cache;
+QStringList SearchSuggester::m_cacheOrder;
+
 SearchSuggester::SearchSuggester(const QString &searchEngine, QObject *parent) : QObject(parent),
-	m_networkReply(nullptr),
 	m_model(nullptr),
-	m_searchEngine(searchEngine)
+	m_searchEngine(searchEngine),
+	m_requestTimer(0),
+	m_averageResponseTime(200),
+	m_isPrivate(false)
 {
 }
 
-void SearchSuggester::setSearchEngine(const QString &searchEngine)
+SearchSuggester::~SearchSuggester()
 {
-	const QString query(m_query);
+	const QList<QNetworkReply*> networkReplies(m_networkReplies.keys());
 
-	m_searchEngine = searchEngine;
-	m_query.clear();
+	m_networkReplies.clear();
 
-	setQuery(query);
+	for (int i = 0; i < networkReplies.count(); ++i)
+	{
+		abortRequest(networkReplies.at(i));
+	}
 }
 
-void SearchSuggester::setQuery(const QString &query)
+void SearchSuggester::timerEvent(QTimerEvent *event)
 {
-	if (query == m_query)
+	if (event->timerId() == m_requestTimer)
 	{
-		return;
-	}
+		killTimer(m_requestTimer);
 
-	m_query = query;
-	m_suggestions.clear();
+		m_requestTimer = 0;
 
-	if (m_networkReply)
-	{
-		m_networkReply->abort();
-		m_networkReply->deleteLater();
-		m_networkReply = nullptr;
+		sendRequest();
 	}
+}
 
+void SearchSuggester::sendRequest()
+{
 	const SearchEnginesManager::SearchEngineDefinition searchEngine(SearchEnginesManager::getSearchEngine(m_searchEngine));
 
 	if (!searchEngine.isValid() || searchEngine.suggestionsUrl.url.isEmpty())
@@ -70,71 +75,223 @@ void SearchSuggester::setQuery(const QString &query)
 		return;
 	}
 
-	SearchEnginesManager::SearchQuery searchQuery(SearchEnginesManager::setupQuery(query, searchEngine.suggestionsUrl));
+	QList<QNetworkReply*> supersededReplies;
+	QHash<QNetworkReply*, PendingRequest>::iterator iterator(m_networkReplies.begin());
+
+	while (iterator != m_networkReplies.end())
+	{
+		if (iterator.value().searchEngine == m_searchEngine && m_query.startsWith(iterator.value().query))
+		{
+			if (iterator.value().query == m_query)
+			{
+				return;
+			}
+
+			++iterator;
+		}
+		else
+		{
+			supersededReplies.append(iterator.key());
+
+			iterator = m_networkReplies.erase(iterator);
+		}
+	}
+
+	for (int i = 0; i < supersededReplies.count(); ++i)
+	{
+		abortRequest(supersededReplies.at(i));
+	}
+
+	SearchEnginesManager::SearchQuery searchQuery(SearchEnginesManager::setupQuery(m_query, searchEngine.suggestionsUrl));
 	searchQuery.request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
 
+	QNetworkReply *networkReply(nullptr);
+
 	if (searchQuery.method == QNetworkAccessManager::PostOperation)
 	{
-		m_networkReply = NetworkManagerFactory::getNetworkManager()->post(searchQuery.request, searchQuery.body);
+		networkReply = NetworkManagerFactory::getNetworkManager(m_isPrivate)->post(searchQuery.request, searchQuery.body);
 	}
 	else
 	{
-		m_networkReply = NetworkManagerFactory::getNetworkManager()->get(searchQuery.request);
+		networkReply = NetworkManagerFactory::getNetworkManager(m_isPrivate)->get(searchQuery.request);
 	}
 
-	connect(m_networkReply, &QNetworkReply::finished, this, [&]()
+	PendingRequest request;
+	request.searchEngine = m_searchEngine;
+	request.query = m_query;
+	request.time = QDateTime::currentDateTimeUtc();
+
+	m_networkReplies[networkReply] = request;
+
+	connect(networkReply, &QNetworkReply::finished, this, &SearchSuggester::handleReplyFinished);
+}
+
+void SearchSuggester::abortRequest(QNetworkReply *networkReply)
+{
+	disconnect(networkReply, &QNetworkReply::finished, this, &SearchSuggester::handleReplyFinished);
+
+	networkReply->abort();
+	networkReply->deleteLater();
+}
+
+void SearchSuggester::handleReplyFinished()
+{
+	QNetworkReply *networkReply(qobject_cast<QNetworkReply*>(sender()));
+
+	if (!networkReply || !m_networkReplies.contains(networkReply))
 	{
-		if (!m_networkReply)
-		{
-			return;
-		}
+		return;
+	}
 
-		if (m_model)
-		{
-			m_model->clear();
-		}
+	const PendingRequest request(m_networkReplies.take(networkReply));
 
-		m_networkReply->deleteLater();
+	networkReply->deleteLater();
 
-		if (m_networkReply->size() <= 0)
-		{
-			m_networkReply = nullptr;
+	if (networkReply->error() != QNetworkReply::NoError || networkReply->size() <= 0)
+	{
+		return;
+	}
 
-			return;
-		}
+	m_averageResponseTime = static_cast<int>(((m_averageResponseTime * 3) + request.time.msecsTo(QDateTime::currentDateTimeUtc())) / 4);
+
+	addCachedSuggestions(request.searchEngine, request.query, parseSuggestions(networkReply->readAll(), request.query));
 
-		const QJsonDocument document(QJsonDocument::fromJson(m_networkReply->readAll()));
+	if (request.searchEngine != m_searchEngine || !m_query.startsWith(request.query))
+	{
+		return;
+	}
 
-		m_networkReply = nullptr;
+	QVector<SearchSuggestion> suggestions;
+	bool isExact(false);
+
+	if (getCachedSuggestions(m_searchEngine, m_query, suggestions, isExact))
+	{
+		updateSuggestions(suggestions);
+	}
+}
+
+void SearchSuggester::updateSuggestions(const QVector<SearchSuggestion> &suggestions)
+{
+	m_suggestions = suggestions;
+
+	if (m_model)
+	{
+		m_model->clear();
 
-		if (document.isEmpty() || !document.isArray() || document.array().count() < 2 || document.array().at(0).toString() != m_query)
+		for (int i = 0; i < m_suggestions.count(); ++i)
 		{
-			return;
+			m_model->appendRow(new QStandardItem(m_suggestions.at(i).completion));
 		}
+	}
 
-		const QJsonArray completionsArray(document.array().at(1).toArray());
-		const QJsonArray descriptionsArray(document.array().at(2).toArray());
-		const QJsonArray urlsArray(document.array().at(3).toArray());
+	emit suggestionsChanged(m_suggestions);
+}
 
-		m_suggestions.reserve(completionsArray.count());
+void SearchSuggester::addCachedSuggestions(const QString &searchEngine, const QString &query, const QVector<SearchSuggestion> &suggestions)
+{
+	QHash<QString, CacheEntry> &cache(m_isPrivate ? m_privateCache : m_cache);
+	QStringList &cacheOrder(m_isPrivate ? m_privateCacheOrder : m_cacheOrder);
+	const QString key(getCacheKey(searchEngine, query));
+	CacheEntry entry;
+	entry.suggestions = suggestions;
+	entry.time = QDateTime::currentDateTimeUtc();
 
-		for (int i = 0; i < completionsArray.count(); ++i)
-		{
-			SearchSuggestion suggestion;
-			suggestion.completion = completionsArray.at(i).toString();
-			suggestion.description = descriptionsArray.at(i).toString();
-			suggestion.url = urlsArray.at(i).toString();
+	cache[key] = entry;
 
-			m_suggestions.append(suggestion);
+	cacheOrder.removeAll(key);
+	cacheOrder.append(key);
 
-			if (m_model)
-			{
-				m_model->appendRow(new QStandardItem(suggestion.completion));
-			}
+	while (cacheOrder.count() > 100)
+	{
+		cache.remove(cacheOrder.takeFirst());
+	}
+}
+
+void SearchSuggester::setPrivate(bool isPrivate)
+{
+	if (isPrivate == m_isPrivate)
+	{
+		return;
+	}
+
+	const QList<QNetworkReply*> networkReplies(m_networkReplies.keys());
+
+	m_networkReplies.clear();
+
+	for (int i = 0; i < networkReplies.count(); ++i)
+	{
+		abortRequest(networkReplies.at(i));
+	}
+
+	m_isPrivate = isPrivate;
+
+	m_privateCache.clear();
+	m_privateCacheOrder.clear();
+}
+
+void SearchSuggester::setSearchEngine(const QString &searchEngine)
+{
+	const QString query(m_query);
+
+	m_searchEngine = searchEngine;
+	m_query.clear();
+
+	setQuery(query);
+}
+
+void SearchSuggester::setQuery(const QString &query)
+{
+	if (query == m_query)
+	{
+		return;
+	}
+
+	m_query = query;
+
+	if (m_requestTimer != 0)
+	{
+		killTimer(m_requestTimer);
+
+		m_requestTimer = 0;
+	}
+
+	if (m_query.isEmpty())
+	{
+		updateSuggestions({});
+
+		return;
+	}
+
+	QVector<SearchSuggestion> suggestions;
+	bool isExact(false);
+
+	if (getCachedSuggestions(m_searchEngine, m_query, suggestions, isExact))
+	{
+		updateSuggestions(suggestions);
+
+		if (isExact)
+		{
+			return;
 		}
+	}
+	else
+	{
+		m_suggestions.clear();
+	}
+
+	const QDateTime currentTime(QDateTime::currentDateTimeUtc());
+	const bool isTyping(m_lastQueryTime.isValid() && m_lastQueryTime.msecsTo(currentTime) < 1000);
+
+	m_lastQueryTime = currentTime;
 
-		emit suggestionsChanged(m_suggestions);
-	});
+	if (isTyping)
+	{
+		m_requestTimer = startTimer(qBound(50, (m_averageResponseTime / 2), 300));
+	}
+	else
+	{
+		sendRequest();
+	}
 }
 
 QStandardItemModel* SearchSuggester::getModel()
@@ -152,9 +309,95 @@ QStandardItemModel* SearchSuggester::getModel()
 	return m_model;
 }
 
+QString SearchSuggester::getCacheKey(const QString &searchEngine, const QString &query)
+{
+	return searchEngine + QLatin1Char('\n') + query;
+}
+
 QVector<SearchSuggester::SearchSuggestion> SearchSuggester::getSuggestions() const
 {
 	return m_suggestions;
 }
 
+QVector<SearchSuggester::SearchSuggestion> SearchSuggester::parseSuggestions(const QByteArray &data, const QString &query)
+{
+	const QJsonDocument document(QJsonDocument::fromJson(data));
+
+	if (document.isEmpty() || !document.isArray() || document.array().count() < 2 || document.array().at(0).toString() != query)
+	{
+		return {};
+	}
+
+	const QJsonArray completionsArray(document.array().at(1).toArray());
+	const QJsonArray descriptionsArray(document.array().at(2).toArray());
+	const QJsonArray urlsArray(document.array().at(3).toArray());
+	QVector<SearchSuggestion> suggestions;
+	suggestions.reserve(completionsArray.count());
+
+	for (int i = 0; i < completionsArray.count(); ++i)
+	{
+		SearchSuggestion suggestion;
+		suggestion.completion = completionsArray.at(i).toString();
+		suggestion.description = descriptionsArray.at(i).toString();
+		suggestion.url = urlsArray.at(i).toString();
+
+		suggestions.append(suggestion);
+	}
+
+	return suggestions;
+}
+
+bool SearchSuggester::getCachedSuggestions(const QString &searchEngine, const QString &query, QVector<SearchSuggestion> &suggestions, bool &isExact)
+{
+	QHash<QString, CacheEntry> &cache(m_isPrivate ? m_privateCache : m_cache);
+	QStringList &cacheOrder(m_isPrivate ? m_privateCacheOrder : m_cacheOrder);
+	const QDateTime expirationTime(QDateTime::currentDateTimeUtc().addSecs(-600));
+
+	for (int length = query.length(); length > 0; --length)
+	{
+		const QString key(getCacheKey(searchEngine, query.left(length)));
+
+		if (!cache.contains(key))
+		{
+			continue;
+		}
+
+		const CacheEntry &entry(cache[key]);
+
+		if (entry.time < expirationTime)
+		{
+			cache.remove(key);
+			cacheOrder.removeAll(key);
+
+			continue;
+		}
+
+		isExact = (length == query.length());
+
+		if (isExact)
+		{
+			suggestions = entry.suggestions;
+		}
+		else
+		{
+			suggestions.clear();
+
+			for (int i = 0; i < entry.suggestions.count(); ++i)
+			{
+				if (entry.suggestions.at(i).completion.startsWith(query, Qt::CaseInsensitive))
+				{
+					suggestions.append(entry.suggestions.at(i));
+				}
+			}
+		}
+
+		cacheOrder.removeAll(key);
+		cacheOrder.append(key);
+
+		return true;
+	}
+
+	return false;
+}
+
 }
@@ -21,6 +21,7 @@
 #ifndef OTTER_SEARCHSUGGESTER_H
 #define OTTER_SEARCHSUGGESTER_H
 
+#include <QtCore/QDateTime>
 #include <QtCore/QObject>
 #include <QtGui/QStandardItemModel>
 #include <QtNetwork/QNetworkReply>
@@ -41,7 +42,9 @@ public:
 	};
 
 	explicit SearchSuggester(const QString &searchEngine, QObject *parent = nullptr);
+	~SearchSuggester();
 
+	void setPrivate(bool isPrivate);
 	QStandardItemModel* getModel();
 	QVector<SearchSuggestion> getSuggestions() const;
 
@@ -49,12 +52,47 @@ public slots:
 	void setSearchEngine(const QString &searchEngine);
 	void setQuery(const QString &query);
 
+protected:
+	struct CacheEntry final
+	{
+		QVector<SearchSuggestion> suggestions;
+		QDateTime time;
+	};
+
+	struct PendingRequest final
+	{
+		QString searchEngine;
+		QString query;
+		QDateTime time;
+	};
+
+	void timerEvent(QTimerEvent *event) override;
+	void sendRequest();
+	void abortRequest(QNetworkReply *networkReply);
+	void updateSuggestions(const QVector<SearchSuggestion> &suggestions);
+	static QString getCacheKey(const QString &searchEngine, const QString &query);
+	static QVector<SearchSuggestion> parseSuggestions(const QByteArray &data, const QString &query);
+	bool getCachedSuggestions(const QString &searchEngine, const QString &query, QVector<SearchSuggestion> &suggestions, bool &isExact);
+	void addCachedSuggestions(const QString &searchEngine, const QString &query, const QVector<SearchSuggestion> &suggestions);
+
+protected slots:
+	void handleReplyFinished();
+
 private:
-	QNetworkReply *m_networkReply;
 	QStandardItemModel *m_model;
 	QString m_searchEngine;
 	QString m_query;
 	QVector<SearchSuggestion> m_suggestions;
+	QHash<QNetworkReply*, PendingRequest> m_networkReplies;
+	QHash<QString, CacheEntry> m_privateCache;
+	QStringList m_privateCacheOrder;
+	QDateTime m_lastQueryTime;
+	int m_requestTimer;
+	int m_averageResponseTime;
+	bool m_isPrivate;
+
+	static QHash<QString, CacheEntry> m_cache;
+	static QStringList m_cacheOrder;
 
 signals:
 	void suggestionsChanged(const QVector<SearchSuggester::SearchSuggestion> &suggestions);
@@ -22,6 +22,7 @@
 #include "Application.h"
 #include "JsonSettings.h"
 #include "SessionModel.h"
+#include "TasksManager.h"
 #include "../ui/MainWindow.h"
 #include "../ui/Window.h"
 
@@ -49,28 +50,10 @@ bool SessionsManager::m_isDirty(false);
 bool SessionsManager::m_isPrivate(false);
 bool SessionsManager::m_isReadOnly(false);
 
-SessionsManager::SessionsManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+SessionsManager::SessionsManager(QObject *parent) : QObject(parent)
 {
 }
 
-void SessionsManager::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == m_saveTimer)
-	{
-		m_isDirty = false;
-
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		if (!m_isPrivate)
-		{
-			saveSession({}, {}, nullptr, false);
-		}
-	}
-}
-
 void SessionsManager::createInstance(const QString &profilePath, const QString &cachePath, bool isPrivate, bool isReadOnly)
 {
 	if (!m_instance)
@@ -86,10 +69,17 @@ void SessionsManager::createInstance(const QString &profilePath, const QString &
 
 void SessionsManager::scheduleSave()
 {
-	if (m_saveTimer == 0 && !m_isPrivate)
+	if (m_isPrivate)
 	{
-		m_saveTimer = startTimer(1000);
+		return;
 	}
+
+	TasksManager::scheduleFlush(this, [&]()
+	{
+		m_isDirty = false;
+
+		saveSession({}, {}, nullptr, false);
+	});
 }
 
 void SessionsManager::clearClosedWindows()
@@ -586,6 +576,11 @@ bool SessionsManager::saveSession(const QString &path, const QString &title, Mai
 		return false;
 	}
 
+	if (path.isEmpty() && !mainWindow && m_instance)
+	{
+		TasksManager::cancelFlush(m_instance);
+	}
+
 	SessionInformation session;
 	session.path = getSessionPath(path);
 	session.title = (title.isEmpty() ? m_sessionTitle : title);
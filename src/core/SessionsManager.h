@@ -273,12 +273,9 @@ public:
 protected:
 	explicit SessionsManager(QObject *parent);
 
-	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
 
 private:
-	int m_saveTimer;
-
 	static SessionsManager *m_instance;
 	static SessionModel *m_model;
 	static QString m_sessionPath;
@@ -136,6 +136,8 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(History_ClosedWindowsLimitAmountOption, IntegerType, 10);
 	registerOption(History_DownloadsLimitPeriodOption, IntegerType, 7);
 	registerOption(History_ExpandBranchesOption, EnumerationType, QLatin1String("first"), {QLatin1String("first"), QLatin1String("all"), QLatin1String("none")});
+	registerOption(History_FeedEntriesLimitAmountOption, IntegerType, 1000);
+	registerOption(History_FeedEntriesLimitPeriodOption, IntegerType, 0);
 	registerOption(History_ManualClearOptionsOption, ListType, QStringList({QLatin1String("browsing"), QLatin1String("cookies"), QLatin1String("forms"), QLatin1String("downloads"), QLatin1String("caches")}));
 	registerOption(History_ManualClearPeriodOption, IntegerType, 1);
 	registerOption(History_RememberBrowsingOption, BooleanType, true);
@@ -164,11 +166,15 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Network_CookiesPolicyOption, EnumerationType, QLatin1String("acceptAll"), {QLatin1String("acceptAll"), QLatin1String("acceptExisting"), QLatin1String("readOnly"), QLatin1String("ignore")});
 	registerOption(Network_DoNotTrackPolicyOption, EnumerationType, QLatin1String("skip"), {QLatin1String("skip"), QLatin1String("allow"), QLatin1String("doNotAllow")});
 	registerOption(Network_EnableDnsPrefetchOption, BooleanType, true);
+	registerOption(Network_EnableHttp2Option, BooleanType, true);
 	registerOption(Network_EnableReferrerOption, BooleanType, true);
 	registerOption(Network_ProxyOption, EnumerationType, QLatin1String("system"), {QLatin1String("system")});
 	registerOption(Network_ThirdPartyCookiesAcceptedHostsOption, ListType, QStringList());
 	registerOption(Network_ThirdPartyCookiesPolicyOption, EnumerationType, QLatin1String("ignore"), QStringList({QLatin1String("acceptAll"), QLatin1String("acceptExisting"), QLatin1String("ignore")}));
 	registerOption(Network_ThirdPartyCookiesRejectedHostsOption, ListType, QStringList());
+	registerOption(Network_TransfersLimitAmountGlobalOption, IntegerType, 6);
+	registerOption(Network_TransfersLimitAmountHostOption, IntegerType, 2);
+	registerOption(Network_TransfersSpeedLimitOption, IntegerType, 0);
 	registerOption(Network_UserAgentOption, EnumerationType, QLatin1String("default"), QStringList(QLatin1String("default")));
 	registerOption(Network_WorkOfflineOption, BooleanType, false);
 	registerOption(Paths_DownloadsOption, PathType, QStandardPaths::writableLocation(QStandardPaths::DownloadLocation));
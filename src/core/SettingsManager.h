@@ -115,6 +115,8 @@ public:
 		History_ClosedWindowsLimitAmountOption,
 		History_DownloadsLimitPeriodOption,
 		History_ExpandBranchesOption,
+		History_FeedEntriesLimitAmountOption,
+		History_FeedEntriesLimitPeriodOption,
 		History_ManualClearOptionsOption,
 		History_ManualClearPeriodOption,
 		History_RememberBrowsingOption,
@@ -143,11 +145,15 @@ public:
 		Network_CookiesPolicyOption,
 		Network_DoNotTrackPolicyOption,
 		Network_EnableDnsPrefetchOption,
+		Network_EnableHttp2Option,
 		Network_EnableReferrerOption,
 		Network_ProxyOption,
 		Network_ThirdPartyCookiesAcceptedHostsOption,
 		Network_ThirdPartyCookiesPolicyOption,
 		Network_ThirdPartyCookiesRejectedHostsOption,
+		Network_TransfersLimitAmountGlobalOption,
+		Network_TransfersLimitAmountHostOption,
+		Network_TransfersSpeedLimitOption,
 		Network_UserAgentOption,
 		Network_WorkOfflineOption,
 		Paths_DownloadsOption,
@@ -35,6 +35,7 @@ SpellCheckManager* SpellCheckManager::m_instance(nullptr);
 QString SpellCheckManager::m_defaultDictionary;
 QVector<SpellCheckManager::DictionaryInformation> SpellCheckManager::m_dictionaries;
 QSet<QString> SpellCheckManager::m_ignoredWords;
+bool SpellCheckManager::m_isInitialized(false);
 
 SpellCheckManager::SpellCheckManager(QObject *parent) : QObject(parent)
 {
@@ -43,7 +44,7 @@ SpellCheckManager::SpellCheckManager(QObject *parent) : QObject(parent)
 #endif
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, [&](int identifier)
 	{
-		if (identifier == SettingsManager::Browser_SpellCheckIgnoreDctionariesOption)
+		if (identifier == SettingsManager::Browser_SpellCheckIgnoreDctionariesOption && m_isInitialized)
 		{
 			loadDictionaries();
 		}
@@ -55,9 +56,19 @@ void SpellCheckManager::createInstance()
 	if (!m_instance)
 	{
 		m_instance = new SpellCheckManager(QCoreApplication::instance());
+	}
+}
 
-		loadDictionaries();
+void SpellCheckManager::ensureInitialized()
+{
+	if (m_isInitialized || !m_instance)
+	{
+		return;
 	}
+
+	m_isInitialized = true;
+
+	loadDictionaries();
 }
 
 void SpellCheckManager::addIgnoredWord(const QString &word)
@@ -230,6 +241,8 @@ SpellCheckManager* SpellCheckManager::getInstance()
 
 QString SpellCheckManager::getDefaultDictionary()
 {
+	ensureInitialized();
+
 	if (m_defaultDictionary.isEmpty())
 	{
 		updateDefaultDictionary();
@@ -252,6 +265,8 @@ QString SpellCheckManager::getDictionariesPath()
 
 SpellCheckManager::DictionaryInformation SpellCheckManager::getDictionary(const QString &language)
 {
+	ensureInitialized();
+
 	for (int i = 0; i < m_dictionaries.count(); ++i)
 	{
 		const DictionaryInformation dictionary(m_dictionaries.at(i));
@@ -267,6 +282,8 @@ SpellCheckManager::DictionaryInformation SpellCheckManager::getDictionary(const
 
 QVector<SpellCheckManager::DictionaryInformation> SpellCheckManager::getDictionaries()
 {
+	ensureInitialized();
+
 	return m_dictionaries;
 }
 
@@ -44,6 +44,7 @@ public:
 	};
 
 	static void createInstance();
+	static void ensureInitialized();
 	static void addIgnoredWord(const QString &word);
 	static void removeIgnoredWord(const QString &word);
 	static SpellCheckManager* getInstance();
@@ -67,6 +68,7 @@ private:
 	static QString m_defaultDictionary;
 	static QVector<DictionaryInformation> m_dictionaries;
 	static QSet<QString> m_ignoredWords;
+	static bool m_isInitialized;
 
 signals:
 	void dictionariesChanged();
@@ -19,18 +19,34 @@
 
 #include "TasksManager.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QThread>
+#include <QtCore/QTimerEvent>
+
+#include <algorithm>
+#include <limits>
 
 namespace Otter
 {
 
 TasksManager* TasksManager::m_instance = nullptr;
+QThreadPool* TasksManager::m_computationPool = nullptr;
+QThreadPool* TasksManager::m_inputOutputPool = nullptr;
 QMap<quint64, TasksManager::Task> TasksManager::m_tasks;
-QQueue<quint64> TasksManager::m_queue;
+QVector<TasksManager::QueueEntry> TasksManager::m_queue;
+QVector<TasksManager::Flush> TasksManager::m_flushes;
 
 TasksManager::TasksManager(QObject *parent) : QObject(parent),
-	m_tasksTimer(startTimer(60000))
+	m_tasksTimer(0),
+	m_flushTimer(0)
 {
+	m_computationPool = new QThreadPool(this);
+	m_computationPool->setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
+	m_inputOutputPool = new QThreadPool(this);
+	m_inputOutputPool->setMaxThreadCount(2);
 }
 
 void TasksManager::createInstance()
@@ -38,6 +54,13 @@ void TasksManager::createInstance()
 	if (!m_instance)
 	{
 		m_instance = new TasksManager(QCoreApplication::instance());
+
+		if (!m_flushes.isEmpty())
+		{
+			m_instance->m_flushTimer = m_instance->startTimer(1000);
+		}
+
+		updateQueue();
 	}
 }
 
@@ -45,47 +68,115 @@ void TasksManager::timerEvent(QTimerEvent *event)
 {
 	if (event->timerId() == m_tasksTimer)
 	{
+		killTimer(m_tasksTimer);
+
+		m_tasksTimer = 0;
+
 		const QDateTime currentDateTime(QDateTime::currentDateTimeUtc());
 
-		if (m_queue.isEmpty() || !m_tasks.contains(m_queue[0]) || m_tasks[m_queue[0]].nextRun > currentDateTime)
+		while (!m_queue.isEmpty() && m_queue.first().nextRun <= currentDateTime)
 		{
-			return;
-		}
+			std::pop_heap(m_queue.begin(), m_queue.end(), compareQueueEntries);
 
-		while (!m_queue.isEmpty())
-		{
-			if (!m_tasks.contains(m_queue[0]))
-			{
-				m_queue.dequeue();
+			const QueueEntry entry(m_queue.takeLast());
 
+			if (!m_tasks.contains(entry.identifier) || m_tasks[entry.identifier].nextRun != entry.nextRun)
+			{
 				continue;
 			}
 
-			if (m_tasks[m_queue[0]].nextRun > currentDateTime)
+			const Task definition(m_tasks[entry.identifier]);
+
+			if (definition.isBound && !definition.object)
 			{
-				break;
+				m_tasks.remove(entry.identifier);
+
+				continue;
 			}
 
-			const quint64 identifier(m_queue.dequeue());
-			const Task definition(m_tasks[identifier]);
+			if (definition.isRepeating)
+			{
+				scheduleTask(entry.identifier);
+			}
+			else
+			{
+				m_tasks.remove(entry.identifier);
+			}
 
-			if (definition.function && definition.object)
+			if (definition.function)
 			{
 				definition.function();
 			}
 			else
 			{
-				emit timeout(identifier);
+				emit timeout(entry.identifier);
 			}
 		}
 
 		updateQueue();
 	}
+	else if (event->timerId() == m_flushTimer)
+	{
+		flush();
+	}
+}
+
+void TasksManager::scheduleTask(quint64 identifier)
+{
+	if (!m_tasks.contains(identifier))
+	{
+		return;
+	}
+
+	Task &definition(m_tasks[identifier]);
+	qint64 delay(static_cast<qint64>(definition.interval) * 1000);
+
+	if (definition.type == NetworkTask)
+	{
+		delay = qMin((delay << qMin(definition.failures, 5)), qMax(delay, static_cast<qint64>(86400000)));
+
+		if (delay >= 10)
+		{
+			delay += QRandomGenerator::global()->bounded(static_cast<int>(qMin((delay / 10), static_cast<qint64>(std::numeric_limits<int>::max()))));
+		}
+	}
+
+	definition.nextRun = QDateTime::currentDateTimeUtc().addMSecs(delay);
+
+	QueueEntry entry;
+	entry.nextRun = definition.nextRun;
+	entry.identifier = identifier;
+
+	m_queue.append(entry);
+
+	std::push_heap(m_queue.begin(), m_queue.end(), compareQueueEntries);
 }
 
 void TasksManager::updateQueue()
 {
-///TODO
+	while (!m_queue.isEmpty() && (!m_tasks.contains(m_queue.first().identifier) || m_tasks[m_queue.first().identifier].nextRun != m_queue.first().nextRun))
+	{
+		std::pop_heap(m_queue.begin(), m_queue.end(), compareQueueEntries);
+
+		m_queue.removeLast();
+	}
+
+	if (!m_instance)
+	{
+		return;
+	}
+
+	if (m_instance->m_tasksTimer != 0)
+	{
+		m_instance->killTimer(m_instance->m_tasksTimer);
+
+		m_instance->m_tasksTimer = 0;
+	}
+
+	if (!m_queue.isEmpty())
+	{
+		m_instance->m_tasksTimer = m_instance->startTimer(static_cast<int>(qBound(static_cast<qint64>(0), QDateTime::currentDateTimeUtc().msecsTo(m_queue.first().nextRun), static_cast<qint64>(3600000))));
+	}
 }
 
 void TasksManager::updateTask(quint64 identifier, int interval, bool isRepeating)
@@ -95,9 +186,10 @@ void TasksManager::updateTask(quint64 identifier, int interval, bool isRepeating
 		return;
 	}
 
-	m_tasks[identifier].interval = interval;
+	m_tasks[identifier].interval = static_cast<uint>(qMax(0, interval));
 	m_tasks[identifier].isRepeating = isRepeating;
 
+	scheduleTask(identifier);
 	updateQueue();
 }
 
@@ -113,12 +205,103 @@ void TasksManager::removeTask(quint64 identifier)
 	updateQueue();
 }
 
+void TasksManager::reportTaskResult(quint64 identifier, bool isSuccess)
+{
+	if (!m_tasks.contains(identifier))
+	{
+		return;
+	}
+
+	Task &definition(m_tasks[identifier]);
+	const int failures(isSuccess ? 0 : (definition.failures + 1));
+
+	if (failures == definition.failures)
+	{
+		return;
+	}
+
+	definition.failures = failures;
+
+	if (definition.isRepeating)
+	{
+		scheduleTask(identifier);
+		updateQueue();
+	}
+}
+
+void TasksManager::scheduleFlush(QObject *object, const std::function<void()> &function)
+{
+	for (int i = 0; i < m_flushes.count(); ++i)
+	{
+		if (m_flushes.at(i).object == object)
+		{
+			return;
+		}
+	}
+
+	Flush definition;
+	definition.object = object;
+	definition.function = function;
+
+	m_flushes.append(definition);
+
+	if (m_instance && m_instance->m_flushTimer == 0)
+	{
+		m_instance->m_flushTimer = m_instance->startTimer(1000);
+	}
+}
+
+void TasksManager::cancelFlush(QObject *object)
+{
+	for (int i = (m_flushes.count() - 1); i >= 0; --i)
+	{
+		if (m_flushes.at(i).object == object)
+		{
+			m_flushes.removeAt(i);
+		}
+	}
+}
+
+void TasksManager::flush()
+{
+	if (m_instance && m_instance->m_flushTimer != 0)
+	{
+		m_instance->killTimer(m_instance->m_flushTimer);
+
+		m_instance->m_flushTimer = 0;
+	}
+
+	const QVector<Flush> flushes(m_flushes);
+
+	m_flushes.clear();
+
+	for (int i = 0; i < flushes.count(); ++i)
+	{
+		if (flushes.at(i).object && flushes.at(i).function)
+		{
+			flushes.at(i).function();
+		}
+	}
+}
+
 TasksManager* TasksManager::getInstance()
 {
 	return m_instance;
 }
 
-quint64 TasksManager::registerTask(uint interval, bool isRepeating, const std::function<void()> &function, QObject *object)
+QFuture<void> TasksManager::runInBackground(const std::function<void()> &function, WorkerType type)
+{
+	QThreadPool *pool((type == InputOutputWorker) ? m_inputOutputPool : m_computationPool);
+
+	if (!pool)
+	{
+		pool = QThreadPool::globalInstance();
+	}
+
+	return QtConcurrent::run(pool, function);
+}
+
+quint64 TasksManager::registerTask(uint interval, bool isRepeating, const std::function<void()> &function, QObject *object, TaskType type)
 {
 	const quint64 identifier(m_tasks.isEmpty() ? 1 : (m_tasks.lastKey() + 1));
 	Task definition;
@@ -126,13 +309,21 @@ quint64 TasksManager::registerTask(uint interval, bool isRepeating, const std::f
 	definition.function = function;
 	definition.identifier = identifier;
 	definition.interval = interval;
+	definition.type = type;
+	definition.isBound = (object != nullptr);
 	definition.isRepeating = isRepeating;
 
 	m_tasks[identifier] = definition;
 
+	scheduleTask(identifier);
 	updateQueue();
 
 	return identifier;
 }
 
+bool TasksManager::compareQueueEntries(const QueueEntry &first, const QueueEntry &second)
+{
+	return (first.nextRun > second.nextRun);
+}
+
 }
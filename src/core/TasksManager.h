@@ -21,10 +21,11 @@
 #define OTTER_TASKSMANAGER_H
 
 #include <QtCore/QDateTime>
+#include <QtCore/QFuture>
 #include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
-#include <QtCore/QQueue>
+#include <QtCore/QThreadPool>
 
 #include <functional>
 
@@ -36,6 +37,18 @@ class TasksManager final : public QObject
 	Q_OBJECT
 
 public:
+	enum TaskType
+	{
+		GenericTask = 0,
+		NetworkTask
+	};
+
+	enum WorkerType
+	{
+		ComputationWorker = 0,
+		InputOutputWorker
+	};
+
 	struct Task final
 	{
 		QPointer<QObject> object = nullptr;
@@ -43,27 +56,53 @@ public:
 		QDateTime nextRun;
 		quint64 identifier = 0;
 		uint interval = 0;
+		int failures = 0;
+		TaskType type = GenericTask;
+		bool isBound = false;
 		bool isRepeating = true;
 	};
 
 	static void createInstance();
 	static void updateTask(quint64 identifier, int interval, bool isRepeating);
 	static void removeTask(quint64 identifier);
+	static void reportTaskResult(quint64 identifier, bool isSuccess);
+	static void scheduleFlush(QObject *object, const std::function<void()> &function);
+	static void cancelFlush(QObject *object);
+	static void flush();
 	static TasksManager* getInstance();
-	static quint64 registerTask(uint interval, bool isRepeating, const std::function<void()> &function, QObject *object = nullptr);
+	static QFuture<void> runInBackground(const std::function<void()> &function, WorkerType type = ComputationWorker);
+	static quint64 registerTask(uint interval, bool isRepeating, const std::function<void()> &function, QObject *object = nullptr, TaskType type = GenericTask);
 
 protected:
+	struct QueueEntry final
+	{
+		QDateTime nextRun;
+		quint64 identifier = 0;
+	};
+
+	struct Flush final
+	{
+		QPointer<QObject> object;
+		std::function<void()> function = nullptr;
+	};
+
 	explicit TasksManager(QObject *parent = nullptr);
 
 	void timerEvent(QTimerEvent *event) override;
+	static void scheduleTask(quint64 identifier);
 	static void updateQueue();
+	static bool compareQueueEntries(const QueueEntry &first, const QueueEntry &second);
 
 private:
 	int m_tasksTimer;
+	int m_flushTimer;
 
 	static TasksManager *m_instance;
+	static QThreadPool *m_computationPool;
+	static QThreadPool *m_inputOutputPool;
 	static QMap<quint64, Task> m_tasks;
-	static QQueue<quint64> m_queue;
+	static QVector<QueueEntry> m_queue;
+	static QVector<Flush> m_flushes;
 
 signals:
 	void timeout(quint64 identifier);
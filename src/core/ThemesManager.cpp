@@ -121,6 +121,7 @@ ThemesManager* ThemesManager::m_instance(nullptr);
 ColorScheme* ThemesManager::m_colorScheme(nullptr);
 QWidget* ThemesManager::m_probeWidget(nullptr);
 QString ThemesManager::m_iconThemePath(QLatin1String(":/icons/theme/"));
+QHash<QString, QIcon> ThemesManager::m_icons;
 bool ThemesManager::m_useSystemIconTheme(false);
 
 ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
@@ -170,6 +171,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 				{
 					m_iconThemePath = path;
 
+					m_icons.clear();
+
 					emit iconThemeChanged();
 				}
 			}
@@ -180,6 +183,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 			{
 				m_useSystemIconTheme = value.toBool();
 
+				m_icons.clear();
+
 				emit iconThemeChanged();
 			}
 
@@ -276,26 +281,38 @@ QIcon ThemesManager::createIcon(const QString &name, bool fromTheme, IconContext
 		return QIcon(Utils::loadPixmapFromDataUri(name));
 	}
 
-	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
+	const QString key((fromTheme ? QLatin1String("theme:") : QLatin1String("file:")) + name);
+
+	if (m_icons.contains(key))
 	{
-		return QIcon::fromTheme(name);
+		return m_icons[key];
 	}
 
-	const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
-	const QString svgPath(iconPath + QLatin1String(".svg"));
-	const QString rasterPath(iconPath + QLatin1String(".png"));
+	QIcon icon;
 
-	if (QFile::exists(svgPath))
+	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
 	{
-		return QIcon(svgPath);
+		icon = QIcon::fromTheme(name);
 	}
-
-	if (QFile::exists(rasterPath))
+	else
 	{
-		return QIcon(rasterPath);
+		const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
+		const QString svgPath(iconPath + QLatin1String(".svg"));
+		const QString rasterPath(iconPath + QLatin1String(".png"));
+
+		if (QFile::exists(svgPath))
+		{
+			icon = QIcon(svgPath);
+		}
+		else if (QFile::exists(rasterPath))
+		{
+			icon = QIcon(rasterPath);
+		}
 	}
 
-	return {};
+	m_icons[key] = icon;
+
+	return icon;
 }
 
 bool ThemesManager::eventFilter(QObject *object, QEvent *event)
@@ -323,6 +340,8 @@ bool ThemesManager::eventFilter(QObject *object, QEvent *event)
 			}
 		}
 
+		m_icons.clear();
+
 		emit widgetStyleChanged();
 	}
 
@@ -339,6 +358,8 @@ bool ThemesManager::nativeEventFilter(const QByteArray &eventType, void *message
 
 	if (nativeMessage && nativeMessage->message == WM_THEMECHANGED)
 	{
+		m_icons.clear();
+
 		emit widgetStyleChanged();
 	}
 
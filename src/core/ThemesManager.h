@@ -25,7 +25,9 @@
 #ifdef Q_OS_WIN32
 #include <QtCore/QAbstractNativeEventFilter>
 #endif
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtGui/QIcon>
 #include <QtWidgets/QStyle>
 
 namespace Otter
@@ -136,6 +138,7 @@ private:
 	static ColorScheme *m_colorScheme;
 	static QWidget *m_probeWidget;
 	static QString m_iconThemePath;
+	static QHash<QString, QIcon> m_icons;
 	static bool m_useSystemIconTheme;
 
 signals:
@@ -0,0 +1,104 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "ThumbnailsManager.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QCoreApplication>
+
+namespace Otter
+{
+
+ThumbnailsManager* ThumbnailsManager::m_instance(nullptr);
+QHash<quint64, ThumbnailsManager::Thumbnail> ThumbnailsManager::m_thumbnails;
+
+ThumbnailsManager::ThumbnailsManager(QObject *parent) : QObject(parent)
+{
+}
+
+void ThumbnailsManager::createInstance()
+{
+	if (!m_instance)
+	{
+		m_instance = new ThumbnailsManager(QCoreApplication::instance());
+	}
+}
+
+void ThumbnailsManager::setThumbnail(quint64 identifier, const QUrl &url, const QString &title, const QPixmap &pixmap, bool isPrivate)
+{
+	Thumbnail thumbnail;
+	thumbnail.title = title;
+	thumbnail.url = url;
+	thumbnail.pixmap = pixmap;
+	thumbnail.isPrivate = isPrivate;
+	thumbnail.isValid = true;
+
+	m_thumbnails[identifier] = thumbnail;
+
+	if (m_instance)
+	{
+		emit m_instance->thumbnailChanged(identifier);
+	}
+}
+
+void ThumbnailsManager::invalidateThumbnail(quint64 identifier)
+{
+	if (m_thumbnails.contains(identifier))
+	{
+		m_thumbnails[identifier].isValid = false;
+	}
+}
+
+void ThumbnailsManager::removeThumbnail(quint64 identifier)
+{
+	m_thumbnails.remove(identifier);
+}
+
+ThumbnailsManager* ThumbnailsManager::getInstance()
+{
+	return m_instance;
+}
+
+ThumbnailsManager::Thumbnail ThumbnailsManager::getThumbnail(quint64 identifier)
+{
+	return m_thumbnails.value(identifier);
+}
+
+ThumbnailsManager::Thumbnail ThumbnailsManager::getThumbnail(const QUrl &url)
+{
+	const QUrl normalizedUrl(url.adjusted(QUrl::RemoveFragment | QUrl::StripTrailingSlash));
+	QHash<quint64, Thumbnail>::const_iterator iterator;
+
+	for (iterator = m_thumbnails.constBegin(); iterator != m_thumbnails.constEnd(); ++iterator)
+	{
+		if (iterator.value().isValid && !iterator.value().isPrivate && iterator.value().url.adjusted(QUrl::RemoveFragment | QUrl::StripTrailingSlash) == normalizedUrl)
+		{
+			return iterator.value();
+		}
+	}
+
+	return {};
+}
+
+QSize ThumbnailsManager::getThumbnailSize()
+{
+	return {qMax(260, SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt()), qMax(170, SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt())};
+}
+
+}
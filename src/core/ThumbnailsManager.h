@@ -0,0 +1,67 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_THUMBNAILSMANAGER_H
+#define OTTER_THUMBNAILSMANAGER_H
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtGui/QPixmap>
+
+namespace Otter
+{
+
+class ThumbnailsManager final : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct Thumbnail final
+	{
+		QString title;
+		QUrl url;
+		QPixmap pixmap;
+		bool isPrivate = false;
+		bool isValid = false;
+	};
+
+	static void createInstance();
+	static void setThumbnail(quint64 identifier, const QUrl &url, const QString &title, const QPixmap &pixmap, bool isPrivate);
+	static void invalidateThumbnail(quint64 identifier);
+	static void removeThumbnail(quint64 identifier);
+	static ThumbnailsManager* getInstance();
+	static Thumbnail getThumbnail(quint64 identifier);
+	static Thumbnail getThumbnail(const QUrl &url);
+	static QSize getThumbnailSize();
+
+protected:
+	explicit ThumbnailsManager(QObject *parent);
+
+private:
+	static ThumbnailsManager *m_instance;
+	static QHash<quint64, Thumbnail> m_thumbnails;
+
+signals:
+	void thumbnailChanged(quint64 identifier);
+};
+
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include "NetworkManagerFactory.h"
 #include "NotificationsManager.h"
 #include "SessionsManager.h"
+#include "TasksManager.h"
 #include "Utils.h"
 #include "../ui/MainWindow.h"
 
@@ -37,13 +38,19 @@
 #include <QtWidgets/QFileIconProvider>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
+
 namespace Otter
 {
 
 TransfersManager* TransfersManager::m_instance(nullptr);
 QVector<Transfer*> TransfersManager::m_transfers;
 QVector<Transfer*> TransfersManager::m_privateTransfers;
+QVector<QPointer<Transfer> > TransfersManager::m_queuedTransfers;
+QElapsedTimer TransfersManager::m_bandwidthTimer;
+qint64 TransfersManager::m_bandwidthTokens(0);
 bool TransfersManager::m_isInitilized(false);
+bool TransfersManager::m_isQueueUpdateScheduled(false);
 bool TransfersManager::m_hasRunningTransfers(false);
 
 Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
@@ -56,6 +63,7 @@ Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ?
 	m_bytesTotal(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_priority((options.testFlag(CanNotifyOption) || options.testFlag(CanAutoDeleteOption) || options.testFlag(HasToOpenAfterFinishOption)) ? NormalPriority : LowPriority),
 	m_updateTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
@@ -79,6 +87,7 @@ Transfer::Transfer(const QSettings &settings, QObject *parent) : QObject(parent
 	m_bytesTotal(settings.value(QLatin1String("bytesTotal")).toLongLong()),
 	m_options(NoOption),
 	m_state((m_bytesReceived > 0 && m_bytesTotal == m_bytesReceived && QFile::exists(settings.value(QLatin1String("target")).toString())) ? FinishedState : ErrorState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
@@ -101,6 +110,11 @@ void Transfer::timerEvent(QTimerEvent *event)
 {
 	if (event->timerId() == m_updateTimer)
 	{
+		if (m_reply && m_reply->bytesAvailable() > 0)
+		{
+			handleDataAvailable();
+		}
+
 		const qint64 previousSpeed(m_speed);
 
 		m_speed = (m_bytesReceivedDifference * 2);
@@ -213,6 +227,8 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 
 	if (isRunning)
 	{
+		updateReadBufferSize();
+
 		connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
 		connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
 		connect(m_reply, &QNetworkReply::errorOccurred, this, &Transfer::handleDownloadError);
@@ -322,6 +338,128 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 			m_mimeType = mimeDatabase.mimeTypeForFile(m_target);
 		}
 	}
+
+	if (m_priority == HighPriority)
+	{
+		m_priority = NormalPriority;
+	}
+
+	if (m_state == RunningState && !TransfersManager::hasAvailableSlot(this))
+	{
+		m_state = QueuedState;
+
+		if (m_reply->operation() == QNetworkAccessManager::GetOperation)
+		{
+			m_request = m_reply->request();
+			m_request.setUrl(m_reply->url());
+			m_request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+			if (m_device->size() > 0 && m_reply->rawHeader(QByteArrayLiteral("Accept-Ranges")).trimmed().toLower() == QByteArrayLiteral("bytes"))
+			{
+				m_bytesStart = m_device->size();
+
+				m_request.setRawHeader(QByteArrayLiteral("Range"), QStringLiteral("bytes=%1-").arg(m_bytesStart).toLatin1());
+			}
+			else
+			{
+				m_bytesStart = 0;
+
+				m_device->resize(0);
+			}
+
+			m_bytesReceived = m_bytesStart;
+
+			disconnect(m_reply, nullptr, this, nullptr);
+
+			m_reply->abort();
+
+			QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+
+			m_reply = nullptr;
+		}
+		else
+		{
+			m_reply->setReadBufferSize(16384);
+		}
+
+		TransfersManager::enqueueTransfer(this);
+	}
+	else
+	{
+		updateReadBufferSize();
+	}
+}
+
+void Transfer::startQueued()
+{
+	if (m_reply && !m_reply->isFinished())
+	{
+		m_state = RunningState;
+
+		updateReadBufferSize();
+		handleDataAvailable();
+
+		connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable, Qt::UniqueConnection);
+
+		emit changed();
+
+		return;
+	}
+
+	if (!m_device)
+	{
+		const QString target(m_target);
+
+		start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(m_request), target);
+
+		emit changed();
+
+		return;
+	}
+
+	m_state = RunningState;
+	m_timeStarted = QDateTime::currentDateTimeUtc();
+	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(m_request);
+
+	updateReadBufferSize();
+	handleDataAvailable();
+
+	connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
+	connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+	connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
+	connect(m_reply, &QNetworkReply::errorOccurred, this, &Transfer::handleDownloadError);
+
+	if (m_updateTimer == 0 && m_updateInterval > 0)
+	{
+		m_updateTimer = startTimer(m_updateInterval);
+	}
+
+	emit changed();
+}
+
+void Transfer::sendRequest(const QNetworkRequest &request)
+{
+	m_request = request;
+	m_state = QueuedState;
+
+	if (TransfersManager::canStartTransfer(this))
+	{
+		startQueued();
+	}
+	else
+	{
+		TransfersManager::enqueueTransfer(this);
+
+		emit changed();
+	}
+}
+
+void Transfer::updateReadBufferSize()
+{
+	if (m_reply)
+	{
+		m_reply->setReadBufferSize(TransfersManager::getReadBufferSize(this));
+	}
 }
 
 void Transfer::openTarget() const
@@ -355,6 +493,11 @@ void Transfer::cancel()
 
 void Transfer::stop()
 {
+	if (m_state == QueuedState)
+	{
+		m_state = (m_device ? ErrorState : CancelledState);
+	}
+
 	if (m_updateTimer != 0)
 	{
 		killTimer(m_updateTimer);
@@ -413,7 +556,7 @@ void Transfer::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
 
 void Transfer::handleDataAvailable()
 {
-	if (!m_reply || !m_device)
+	if (!m_reply || !m_device || m_state == QueuedState)
 	{
 		return;
 	}
@@ -428,7 +571,7 @@ void Transfer::handleDataAvailable()
 		}
 	}
 
-	m_device->write(m_reply->readAll());
+	m_device->write(m_reply->read(TransfersManager::requestBandwidth(this, m_reply->bytesAvailable())));
 	m_device->seek(m_device->size());
 
 	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && m_device->size() == m_bytesTotal)
@@ -555,6 +698,11 @@ void Transfer::setOpenCommand(const QString &command)
 
 	m_options |= HasToOpenAfterFinishOption;
 
+	if (m_priority == LowPriority)
+	{
+		setPriority(NormalPriority);
+	}
+
 	QTemporaryFile *file(qobject_cast<QTemporaryFile*>(m_device));
 
 	if (file)
@@ -588,6 +736,25 @@ void Transfer::setHash(QCryptographicHash::Algorithm algorithm, const QByteArray
 	}
 }
 
+void Transfer::setPriority(TransferPriority priority)
+{
+	if (priority == m_priority)
+	{
+		return;
+	}
+
+	m_priority = priority;
+
+	if (m_state == QueuedState)
+	{
+		TransfersManager::scheduleQueueUpdate();
+	}
+	else
+	{
+		updateReadBufferSize();
+	}
+}
+
 void Transfer::setUpdateInterval(int interval)
 {
 	m_updateInterval = interval;
@@ -723,6 +890,11 @@ Transfer::TransferState Transfer::getState() const
 	return m_state;
 }
 
+Transfer::TransferPriority Transfer::getPriority() const
+{
+	return m_priority;
+}
+
 int Transfer::getRemainingTime() const
 {
 	return m_remainingTime;
@@ -793,9 +965,7 @@ bool Transfer::resume()
 		return false;
 	}
 
-	m_state = RunningState;
 	m_device = file;
-	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_timeFinished = {};
 	m_bytesStart = file->size();
 
@@ -805,19 +975,7 @@ bool Transfer::resume()
 	request.setRawHeader(QByteArrayLiteral("Range"), QStringLiteral("bytes=%1-").arg(file->size()).toLatin1());
 	request.setUrl(m_source);
 
-	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
-
-	handleDataAvailable();
-
-	connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
-	connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
-	connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
-	connect(m_reply, &QNetworkReply::errorOccurred, this, &Transfer::handleDownloadError);
-
-	if (m_updateTimer == 0 && m_updateInterval > 0)
-	{
-		m_updateTimer = startTimer(m_updateInterval);
-	}
+	sendRequest(request);
 
 	return true;
 }
@@ -837,9 +995,7 @@ bool Transfer::restart()
 		return false;
 	}
 
-	m_state = RunningState;
 	m_device = file;
-	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_timeFinished = {};
 	m_bytesStart = 0;
 
@@ -848,19 +1004,7 @@ bool Transfer::restart()
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
 	request.setUrl(m_source);
 
-	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
-
-	handleDataAvailable();
-
-	connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
-	connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
-	connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
-	connect(m_reply, &QNetworkReply::errorOccurred, this, &Transfer::handleDownloadError);
-
-	if (m_updateTimer == 0 && m_updateInterval > 0)
-	{
-		m_updateTimer = startTimer(m_updateInterval);
-	}
+	sendRequest(request);
 
 	return true;
 }
@@ -937,7 +1081,7 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 
 	if (m_device)
 	{
-		if (m_reply && m_state == RunningState)
+		if (m_reply && (m_state == RunningState || m_state == QueuedState))
 		{
 			disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
 		}
@@ -966,9 +1110,33 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 	return false;
 }
 
-TransfersManager::TransfersManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+TransfersManager::TransfersManager(QObject *parent) : QObject(parent)
 {
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, [&](int identifier)
+	{
+		switch (identifier)
+		{
+			case SettingsManager::Network_TransfersLimitAmountGlobalOption:
+			case SettingsManager::Network_TransfersLimitAmountHostOption:
+				scheduleQueueUpdate();
+
+				break;
+			case SettingsManager::Network_TransfersSpeedLimitOption:
+				m_bandwidthTimer.invalidate();
+
+				for (int i = 0; i < m_transfers.count(); ++i)
+				{
+					if (m_transfers.at(i)->getState() == Transfer::RunningState)
+					{
+						m_transfers.at(i)->updateReadBufferSize();
+					}
+				}
+
+				break;
+			default:
+				break;
+		}
+	});
 }
 
 void TransfersManager::createInstance()
@@ -979,34 +1147,20 @@ void TransfersManager::createInstance()
 	}
 }
 
-void TransfersManager::timerEvent(QTimerEvent *event)
-{
-	if (event->timerId() == m_saveTimer)
-	{
-		killTimer(m_saveTimer);
-
-		m_saveTimer = 0;
-
-		save();
-	}
-}
-
 void TransfersManager::scheduleSave()
 {
 	if (Application::isAboutToQuit())
 	{
-		if (m_saveTimer != 0)
-		{
-			killTimer(m_saveTimer);
-
-			m_saveTimer = 0;
-		}
+		TasksManager::cancelFlush(this);
 
 		save();
 	}
-	else if (m_saveTimer == 0)
+	else
 	{
-		m_saveTimer = startTimer(1000);
+		TasksManager::scheduleFlush(this, [&]()
+		{
+			save();
+		});
 	}
 }
 
@@ -1027,6 +1181,26 @@ void TransfersManager::updateRunningTransfersState()
 	m_hasRunningTransfers = hasRunningTransfers;
 }
 
+void TransfersManager::enqueueTransfer(Transfer *transfer)
+{
+	if (!m_queuedTransfers.contains(transfer))
+	{
+		m_queuedTransfers.append(transfer);
+	}
+
+	scheduleQueueUpdate();
+}
+
+void TransfersManager::scheduleQueueUpdate()
+{
+	if (!m_isQueueUpdateScheduled && m_instance)
+	{
+		m_isQueueUpdateScheduled = true;
+
+		QTimer::singleShot(0, m_instance, &TransfersManager::startQueuedTransfers);
+	}
+}
+
 void TransfersManager::addTransfer(Transfer *transfer)
 {
 	if (!transfer)
@@ -1107,6 +1281,54 @@ void TransfersManager::save()
 	history.sync();
 }
 
+void TransfersManager::startQueuedTransfers()
+{
+	m_isQueueUpdateScheduled = false;
+
+	for (int i = (m_queuedTransfers.count() - 1); i >= 0; --i)
+	{
+		if (!m_queuedTransfers.at(i) || m_queuedTransfers.at(i)->getState() != Transfer::QueuedState)
+		{
+			m_queuedTransfers.removeAt(i);
+		}
+	}
+
+	std::stable_sort(m_queuedTransfers.begin(), m_queuedTransfers.end(), [&](const QPointer<Transfer> &first, const QPointer<Transfer> &second)
+	{
+		return (first->getPriority() > second->getPriority());
+	});
+
+	int i(0);
+
+	while (i < m_queuedTransfers.count())
+	{
+		Transfer *transfer(m_queuedTransfers.at(i));
+
+		if (!transfer || transfer->getState() != Transfer::QueuedState)
+		{
+			m_queuedTransfers.removeAt(i);
+
+			continue;
+		}
+
+		if (!hasAvailableSlot(transfer))
+		{
+			++i;
+
+			continue;
+		}
+
+		m_queuedTransfers.removeAt(i);
+
+		transfer->startQueued();
+
+		if (transfer->getState() == Transfer::CancelledState)
+		{
+			removeTransfer(transfer);
+		}
+	}
+}
+
 void TransfersManager::clearTransfers(int period)
 {
 	for (int i = (m_transfers.count() - 1); i >= 0; --i)
@@ -1143,6 +1365,7 @@ void TransfersManager::handleTransferFinished()
 	Transfer *transfer(qobject_cast<Transfer*>(sender()));
 
 	updateRunningTransfersState();
+	scheduleQueueUpdate();
 
 	if (!transfer)
 	{
@@ -1192,6 +1415,7 @@ void TransfersManager::handleTransferStopped()
 	Transfer *transfer(qobject_cast<Transfer*>(sender()));
 
 	updateRunningTransfersState();
+	scheduleQueueUpdate();
 
 	if (transfer)
 	{
@@ -1215,25 +1439,21 @@ Transfer* TransfersManager::startTransfer(const QUrl &source, const QString &tar
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
 	request.setUrl(QUrl(source));
 
-	Transfer *transfer(new Transfer(options, m_instance));
-	transfer->start(NetworkManagerFactory::getNetworkManager(options.testFlag(Transfer::IsPrivateOption))->get(request), target);
-
-	if (transfer->getState() == Transfer::CancelledState)
-	{
-		transfer->deleteLater();
-
-		return nullptr;
-	}
-
-	addTransfer(transfer);
-
-	return transfer;
+	return startTransfer(request, target, options);
 }
 
 Transfer* TransfersManager::startTransfer(const QNetworkRequest &request, const QString &target, Transfer::TransferOptions options)
 {
 	Transfer *transfer(new Transfer(options, m_instance));
-	transfer->start(NetworkManagerFactory::getNetworkManager(options.testFlag(Transfer::IsPrivateOption))->get(request), target);
+	transfer->m_source = request.url().adjusted(QUrl::RemovePassword | QUrl::PreferLocalFile);
+	transfer->m_target = target;
+
+	if (target.isEmpty() && (options.testFlag(Transfer::CanAskForPathOption) || !options.testFlag(Transfer::IsQuickTransferOption)))
+	{
+		transfer->m_priority = Transfer::HighPriority;
+	}
+
+	transfer->sendRequest(request);
 
 	if (transfer->getState() == Transfer::CancelledState)
 	{
@@ -1250,6 +1470,12 @@ Transfer* TransfersManager::startTransfer(const QNetworkRequest &request, const
 Transfer* TransfersManager::startTransfer(QNetworkReply *reply, const QString &target, Transfer::TransferOptions options)
 {
 	Transfer *transfer(new Transfer(options, m_instance));
+
+	if (target.isEmpty() && (options.testFlag(Transfer::CanAskForPathOption) || !options.testFlag(Transfer::IsQuickTransferOption)))
+	{
+		transfer->m_priority = Transfer::HighPriority;
+	}
+
 	transfer->start(reply, target);
 
 	if (transfer->getState() == Transfer::CancelledState)
@@ -1327,6 +1553,52 @@ TransfersManager::ActiveTransfersInformation TransfersManager::getActiveTransfer
 	return information;
 }
 
+qint64 TransfersManager::getSpeedLimit(const Transfer *transfer)
+{
+	if (transfer->getPriority() == Transfer::HighPriority)
+	{
+		return 0;
+	}
+
+	return (SettingsManager::getOption(SettingsManager::Network_TransfersSpeedLimitOption).toLongLong() * 1024);
+}
+
+qint64 TransfersManager::getReadBufferSize(const Transfer *transfer)
+{
+	const qint64 limit(getSpeedLimit(transfer));
+
+	return ((limit > 0) ? qMax((limit / 2), static_cast<qint64>(16384)) : 0);
+}
+
+qint64 TransfersManager::requestBandwidth(const Transfer *transfer, qint64 bytes)
+{
+	const qint64 limit(getSpeedLimit(transfer));
+
+	if (limit <= 0 || bytes <= 0)
+	{
+		return bytes;
+	}
+
+	if (m_bandwidthTimer.isValid())
+	{
+		const qint64 elapsed(qMin(m_bandwidthTimer.nsecsElapsed(), static_cast<qint64>(1000000000)));
+
+		m_bandwidthTokens = qMin(limit, (m_bandwidthTokens + ((elapsed * limit) / 1000000000)));
+	}
+	else
+	{
+		m_bandwidthTokens = limit;
+	}
+
+	m_bandwidthTimer.start();
+
+	const qint64 allowedBytes(qMin(bytes, m_bandwidthTokens));
+
+	m_bandwidthTokens -= allowedBytes;
+
+	return allowedBytes;
+}
+
 int TransfersManager::getRunningTransfersCount()
 {
 	int runningTransfers(0);
@@ -1353,7 +1625,9 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 
 	m_privateTransfers.removeAll(transfer);
 
-	if (transfer->getState() == Transfer::RunningState)
+	m_queuedTransfers.removeAll(transfer);
+
+	if (transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::QueuedState)
 	{
 		transfer->stop();
 	}
@@ -1406,6 +1680,59 @@ bool TransfersManager::isDownloading(const QString &source, const QString &targe
 	return false;
 }
 
+bool TransfersManager::canStartTransfer(const Transfer *transfer)
+{
+	if (transfer->getPriority() == Transfer::HighPriority)
+	{
+		return true;
+	}
+
+	for (int i = 0; i < m_queuedTransfers.count(); ++i)
+	{
+		const Transfer *queuedTransfer(m_queuedTransfers.at(i));
+
+		if (queuedTransfer && queuedTransfer != transfer && queuedTransfer->getState() == Transfer::QueuedState && queuedTransfer->getPriority() >= transfer->getPriority())
+		{
+			return false;
+		}
+	}
+
+	return hasAvailableSlot(transfer);
+}
+
+bool TransfersManager::hasAvailableSlot(const Transfer *transfer)
+{
+	if (transfer->getPriority() == Transfer::HighPriority)
+	{
+		return true;
+	}
+
+	const QString host(transfer->getSource().host());
+	const int globalLimit(SettingsManager::getOption(SettingsManager::Network_TransfersLimitAmountGlobalOption).toInt());
+	const int hostLimit(SettingsManager::getOption(SettingsManager::Network_TransfersLimitAmountHostOption).toInt());
+	int globalAmount(0);
+	int hostAmount(0);
+
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		const Transfer *runningTransfer(m_transfers.at(i));
+
+		if (runningTransfer == transfer || runningTransfer->getState() != Transfer::RunningState)
+		{
+			continue;
+		}
+
+		++globalAmount;
+
+		if (!host.isEmpty() && runningTransfer->getSource().host() == host)
+		{
+			++hostAmount;
+		}
+	}
+
+	return ((globalLimit <= 0 || globalAmount < globalLimit) && (hostLimit <= 0 || hostAmount < hostLimit));
+}
+
 bool TransfersManager::hasRunningTransfers()
 {
 	return m_hasRunningTransfers;
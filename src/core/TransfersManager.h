@@ -20,6 +20,7 @@
 #ifndef OTTER_TRANSFERSMANAGER_H
 #define OTTER_TRANSFERSMANAGER_H
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QMimeType>
 #include <QtCore/QPointer>
@@ -56,13 +57,22 @@ public:
 		UnknownState = 0,
 		ErrorState,
 		CancelledState,
+		QueuedState,
 		RunningState,
 		FinishedState
 	};
 
+	enum TransferPriority
+	{
+		LowPriority = 0,
+		NormalPriority,
+		HighPriority
+	};
+
 	~Transfer();
 
 	void setHash(QCryptographicHash::Algorithm algorithm, const QByteArray &hash = {});
+	void setPriority(TransferPriority priority);
 	virtual void setUpdateInterval(int interval);
 	virtual QUrl getSource() const;
 	virtual QString getSuggestedFileName();
@@ -76,6 +86,7 @@ public:
 	virtual qint64 getBytesTotal() const;
 	TransferOptions getOptions() const;
 	virtual TransferState getState() const;
+	TransferPriority getPriority() const;
 	virtual int getRemainingTime() const;
 	bool verifyHashes() const;
 	bool isArchived() const;
@@ -95,6 +106,9 @@ protected:
 
 	void timerEvent(QTimerEvent *event) override;
 	void start(QNetworkReply *reply, const QString &target);
+	void startQueued();
+	void sendRequest(const QNetworkRequest &request);
+	void updateReadBufferSize();
 
 protected slots:
 	void markAsStarted();
@@ -114,6 +128,7 @@ private:
 	QDateTime m_timeStarted;
 	QDateTime m_timeFinished;
 	QMimeType m_mimeType;
+	QNetworkRequest m_request;
 	QHash<QCryptographicHash::Algorithm, QByteArray> m_hashes;
 	QQueue<qint64> m_speeds;
 	qint64 m_speed;
@@ -123,6 +138,7 @@ private:
 	qint64 m_bytesTotal;
 	TransferOptions m_options;
 	TransferState m_state;
+	TransferPriority m_priority;
 	int m_updateTimer;
 	int m_updateInterval;
 	int m_remainingTime;
@@ -169,24 +185,33 @@ public:
 protected:
 	explicit TransfersManager(QObject *parent);
 
-	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
 	void updateRunningTransfersState();
+	static void enqueueTransfer(Transfer *transfer);
+	static void scheduleQueueUpdate();
+	static qint64 getSpeedLimit(const Transfer *transfer);
+	static qint64 getReadBufferSize(const Transfer *transfer);
+	static qint64 requestBandwidth(const Transfer *transfer, qint64 bytes);
+	static bool canStartTransfer(const Transfer *transfer);
+	static bool hasAvailableSlot(const Transfer *transfer);
 
 protected slots:
 	void save();
+	void startQueuedTransfers();
 	void handleTransferStarted();
 	void handleTransferFinished();
 	void handleTransferChanged();
 	void handleTransferStopped();
 
 private:
-	int m_saveTimer;
-
 	static TransfersManager *m_instance;
 	static QVector<Transfer*> m_transfers;
 	static QVector<Transfer*> m_privateTransfers;
+	static QVector<QPointer<Transfer> > m_queuedTransfers;
+	static QElapsedTimer m_bandwidthTimer;
+	static qint64 m_bandwidthTokens;
 	static bool m_isInitilized;
+	static bool m_isQueueUpdateScheduled;
 	static bool m_hasRunningTransfers;
 
 signals:
@@ -196,6 +221,8 @@ signals:
 	void transferStopped(Transfer *transfer);
 	void transferRemoved(Transfer *transfer);
 	void transfersChanged();
+
+friend class Transfer;
 };
 
 }
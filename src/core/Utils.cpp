@@ -132,6 +132,38 @@ QString matchUrl(const QUrl &url, const QString &prefix)
 	return {};
 }
 
+QString matchUrl(const UrlKey &url, const QString &prefix)
+{
+	const QString text(url.toString());
+
+	if (text.startsWith(prefix, Qt::CaseInsensitive))
+	{
+		return text;
+	}
+
+	const QUrl normalizedUrl(url.toUrl());
+	const int offset(normalizedUrl.scheme().count());
+
+	if (!text.midRef(offset).startsWith(QLatin1String("://")))
+	{
+		return matchUrl(normalizedUrl, prefix);
+	}
+
+	const QStringRef match(text.midRef(offset + 3));
+
+	if (match.startsWith(prefix, Qt::CaseInsensitive))
+	{
+		return match.toString();
+	}
+
+	if (match.startsWith(QLatin1String("www.")) && normalizedUrl.host().count(QLatin1Char('.')) > 1 && match.mid(4).startsWith(prefix, Qt::CaseInsensitive))
+	{
+		return match.mid(4).toString();
+	}
+
+	return {};
+}
+
 QString createIdentifier(const QString &source, const QStringList &exclude, bool toLowerCase)
 {
 	QString identifier;
@@ -808,6 +840,48 @@ bool isUrlEmpty(const QUrl &url)
 
 }
 
+UrlKey::UrlKey(const QUrl &url) :
+	m_url(Utils::normalizeUrl(url)),
+	m_text(m_url.toString()),
+	m_hash(qHash(m_text))
+{
+}
+
+QString UrlKey::toString() const
+{
+	return m_text;
+}
+
+QUrl UrlKey::toUrl() const
+{
+	return m_url;
+}
+
+uint UrlKey::getHash() const
+{
+	return m_hash;
+}
+
+bool UrlKey::isEmpty() const
+{
+	return m_text.isEmpty();
+}
+
+bool UrlKey::operator==(const UrlKey &other) const
+{
+	return (m_hash == other.m_hash && m_text == other.m_text);
+}
+
+bool UrlKey::operator!=(const UrlKey &other) const
+{
+	return !(*this == other);
+}
+
+uint qHash(const UrlKey &key, uint seed)
+{
+	return (key.getHash() ^ seed);
+}
+
 EnumeratorMapper::EnumeratorMapper(const QMetaEnum &enumeration, const QString &suffix) :
 	m_enumerator(enumeration),
 	m_suffix(suffix)
@@ -113,6 +113,27 @@ private:
 	QString m_suffix;
 };
 
+class UrlKey final
+{
+public:
+	UrlKey() = default;
+	explicit UrlKey(const QUrl &url);
+
+	QString toString() const;
+	QUrl toUrl() const;
+	uint getHash() const;
+	bool isEmpty() const;
+	bool operator==(const UrlKey &other) const;
+	bool operator!=(const UrlKey &other) const;
+
+private:
+	QUrl m_url;
+	QString m_text;
+	uint m_hash = 0;
+};
+
+uint qHash(const UrlKey &key, uint seed = 0);
+
 namespace Utils
 {
 
@@ -120,6 +141,7 @@ void removeFiles(const QStringList &paths);
 void runApplication(const QString &command, const QUrl &url = {});
 void startLinkDrag(const QUrl &url, const QString &title, const QPixmap &pixmap, QObject *parent = nullptr);
 QString matchUrl(const QUrl &url, const QString &prefix);
+QString matchUrl(const UrlKey &url, const QString &prefix);
 QString createIdentifier(const QString &source, const QStringList &exclude = {}, bool toLowerCase = true);
 QString createErrorPage(const ErrorPageInformation &information);
 QString appendShortcut(const QString &text, const QKeySequence &shortcut);
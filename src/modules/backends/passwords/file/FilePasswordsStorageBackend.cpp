@@ -25,12 +25,13 @@
 #include <QtCore/QFile>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
-#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
 
 namespace Otter
 {
 
 FilePasswordsStorageBackend::FilePasswordsStorageBackend(QObject *parent) : PasswordsStorageBackend(parent),
+	m_journalEntries(0),
 	m_isInitialized(false)
 {
 }
@@ -46,66 +47,95 @@ void FilePasswordsStorageBackend::ensureInitialized()
 
 	const QString path(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
 
-	if (!QFile::exists(path))
+	if (QFile::exists(path))
 	{
-		return;
+		QFile file(path);
+
+		if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			const QJsonObject hostsObject(QJsonDocument::fromJson(file.readAll()).object());
+			QJsonObject::const_iterator hostsIterator;
+
+			for (hostsIterator = hostsObject.constBegin(); hostsIterator != hostsObject.constEnd(); ++hostsIterator)
+			{
+				const QJsonArray passwordsArray(hostsIterator.value().toArray());
+				QVector<PasswordsManager::PasswordInformation> hostPasswords;
+				hostPasswords.reserve(passwordsArray.count());
+
+				for (int i = 0; i < passwordsArray.count(); ++i)
+				{
+					hostPasswords.append(deserializePassword(passwordsArray.at(i).toObject()));
+				}
+
+				m_passwords[hostsIterator.key()] = hostPasswords;
+
+				updateIndex(hostsIterator.key());
+			}
+		}
+		else
+		{
+			Console::addMessage(tr("Failed to open passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+		}
 	}
 
-	QFile file(path);
+	QFile journalFile(SessionsManager::getWritableDataPath(QLatin1String("passwords.journal")));
 
-	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	if (!journalFile.exists())
 	{
-		Console::addMessage(tr("Failed to open passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
-
 		return;
 	}
 
-	QHash<QString, QVector<PasswordsManager::PasswordInformation> > passwords;
-	const QJsonObject hostsObject(QJsonDocument::fromJson(file.readAll()).object());
-	QJsonObject::const_iterator hostsIterator;
+	if (!journalFile.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		Console::addMessage(tr("Failed to open passwords journal file: %1").arg(journalFile.errorString()), Console::OtherCategory, Console::ErrorLevel, journalFile.fileName());
+
+		return;
+	}
 
-	for (hostsIterator = hostsObject.constBegin(); hostsIterator != hostsObject.constEnd(); ++hostsIterator)
+	while (!journalFile.atEnd())
 	{
-		const QJsonArray passwordsArray(hostsIterator.value().toArray());
-		QVector<PasswordsManager::PasswordInformation> hostPasswords;
-		hostPasswords.reserve(passwordsArray.count());
+		const QJsonObject entryObject(QJsonDocument::fromJson(journalFile.readLine()).object());
+		const QString action(entryObject.value(QLatin1String("action")).toString());
 
-		for (int i = 0; i < passwordsArray.count(); ++i)
+		if (action == QLatin1String("add"))
 		{
-			const QJsonObject passwordObject(passwordsArray.at(i).toObject());
-			const QJsonArray fieldsArray(passwordObject.value(QLatin1String("fields")).toArray());
-			PasswordsManager::PasswordInformation password;
-			password.url = QUrl(passwordObject.value(QLatin1String("url")).toString());
-			password.timeAdded = QDateTime::fromString(passwordObject.value(QLatin1String("timeAdded")).toString(), Qt::ISODate);
-			password.timeAdded.setTimeSpec(Qt::UTC);
-			password.timeUsed = QDateTime::fromString(passwordObject.value(QLatin1String("timeUsed")).toString(), Qt::ISODate);
-			password.timeUsed.setTimeSpec(Qt::UTC);
-			password.type = ((passwordObject.value(QLatin1String("type")).toString() == QLatin1String("auth")) ? PasswordsManager::AuthPassword : PasswordsManager::FormPassword);
-			password.fields.reserve(fieldsArray.count());
-
-			for (int j = 0; j < fieldsArray.count(); ++j)
-			{
-				const QJsonObject fieldObject(fieldsArray.at(j).toObject());
-				PasswordsManager::PasswordInformation::Field field;
-				field.name = fieldObject.value(fieldObject.contains(QLatin1String("name")) ? QLatin1String("name") : QLatin1String("key")).toString();
-				field.value = fieldObject.value(QLatin1String("value")).toString();
-				field.type = ((fieldObject.value(QLatin1String("type")).toString() == QLatin1String("password")) ? PasswordsManager::PasswordField : PasswordsManager::TextField);
-
-				password.fields.append(field);
-			}
+			applyAddPassword(deserializePassword(entryObject.value(QLatin1String("password")).toObject()));
+		}
+		else if (action == QLatin1String("remove"))
+		{
+			applyRemovePassword(deserializePassword(entryObject.value(QLatin1String("password")).toObject()));
+		}
+		else if (action == QLatin1String("clear"))
+		{
+			const QString host(entryObject.value(QLatin1String("host")).toString());
 
-			hostPasswords.append(password);
+			m_passwords.remove(host);
+			m_types.remove(host);
+		}
+		else
+		{
+			continue;
 		}
 
-		passwords[hostsIterator.key()] = hostPasswords;
+		++m_journalEntries;
 	}
 
-	m_passwords = passwords;
+	journalFile.close();
+
+	if (m_journalEntries >= 100)
+	{
+		save();
+	}
 }
 
 void FilePasswordsStorageBackend::save()
 {
-	QFile file(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+	if (SessionsManager::isReadOnly())
+	{
+		return;
+	}
+
+	QSaveFile file(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
 
 	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
 	{
@@ -129,39 +159,194 @@ void FilePasswordsStorageBackend::save()
 
 		for (int i = 0; i < passwords.count(); ++i)
 		{
-			const PasswordsManager::PasswordInformation password(passwords.at(i));
-			QJsonArray fieldsArray;
+			passwordsArray.append(serializePassword(passwords.at(i)));
+		}
 
-			for (int j = 0; j < password.fields.count(); ++j)
-			{
-				const PasswordsManager::PasswordInformation::Field field(password.fields.at(j));
+		hostsObject.insert(hostsIterator.key(), passwordsArray);
+	}
 
-				fieldsArray.append(QJsonObject({{QLatin1String("name"), field.name}, {QLatin1String("value"), field.value}, {QLatin1String("type"), ((field.type == PasswordsManager::PasswordField) ? QLatin1String("password") : QLatin1String("text"))}}));
-			}
+	file.write(QJsonDocument(hostsObject).toJson(QJsonDocument::Compact));
 
-			QJsonObject passwordObject({{QLatin1String("url"), password.url.toString()}});
+	if (!file.commit())
+	{
+		Console::addMessage(tr("Failed to save passwords file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
 
-			if (password.timeAdded.isValid())
-			{
-				passwordObject.insert(QLatin1String("timeAdded"), password.timeAdded.toString(Qt::ISODate));
-			}
+		return;
+	}
 
-			if (password.timeUsed.isValid())
-			{
-				passwordObject.insert(QLatin1String("timeUsed"), password.timeUsed.toString(Qt::ISODate));
-			}
+	const QString journalPath(SessionsManager::getWritableDataPath(QLatin1String("passwords.journal")));
 
-			passwordObject.insert(QLatin1String("type"), ((password.type == PasswordsManager::AuthPassword) ? QLatin1String("auth") : QLatin1String("form")));
-			passwordObject.insert(QLatin1String("fields"), fieldsArray);
+	if (QFile::exists(journalPath) && !QFile::remove(journalPath))
+	{
+		Console::addMessage(tr("Failed to remove passwords journal file"), Console::OtherCategory, Console::ErrorLevel, journalPath);
+	}
 
-			passwordsArray.append(passwordObject);
-		}
+	m_journalEntries = 0;
+}
 
-		hostsObject.insert(hostsIterator.key(), passwordsArray);
+void FilePasswordsStorageBackend::appendJournal(const QJsonObject &entryObject)
+{
+	if (SessionsManager::isReadOnly())
+	{
+		return;
 	}
 
-	file.write(QJsonDocument(hostsObject).toJson(QJsonDocument::Compact));
+	if (m_journalEntries >= 100)
+	{
+		save();
+
+		return;
+	}
+
+	QFile file(SessionsManager::getWritableDataPath(QLatin1String("passwords.journal")));
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+	{
+		Console::addMessage(tr("Failed to open passwords journal file: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		save();
+
+		return;
+	}
+
+	file.write(QJsonDocument(entryObject).toJson(QJsonDocument::Compact) + QByteArrayLiteral("\n"));
 	file.close();
+
+	++m_journalEntries;
+}
+
+void FilePasswordsStorageBackend::updateIndex(const QString &host)
+{
+	const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords.value(host));
+
+	if (passwords.isEmpty())
+	{
+		m_passwords.remove(host);
+		m_types.remove(host);
+
+		return;
+	}
+
+	PasswordsManager::PasswordTypes types;
+
+	for (int i = 0; i < passwords.count(); ++i)
+	{
+		types |= passwords.at(i).type;
+	}
+
+	m_types[host] = types;
+}
+
+QJsonObject FilePasswordsStorageBackend::serializePassword(const PasswordsManager::PasswordInformation &password)
+{
+	QJsonArray fieldsArray;
+
+	for (int i = 0; i < password.fields.count(); ++i)
+	{
+		const PasswordsManager::PasswordInformation::Field field(password.fields.at(i));
+
+		fieldsArray.append(QJsonObject({{QLatin1String("name"), field.name}, {QLatin1String("value"), field.value}, {QLatin1String("type"), ((field.type == PasswordsManager::PasswordField) ? QLatin1String("password") : QLatin1String("text"))}}));
+	}
+
+	QJsonObject passwordObject({{QLatin1String("url"), password.url.toString()}});
+
+	if (password.timeAdded.isValid())
+	{
+		passwordObject.insert(QLatin1String("timeAdded"), password.timeAdded.toString(Qt::ISODate));
+	}
+
+	if (password.timeUsed.isValid())
+	{
+		passwordObject.insert(QLatin1String("timeUsed"), password.timeUsed.toString(Qt::ISODate));
+	}
+
+	passwordObject.insert(QLatin1String("type"), ((password.type == PasswordsManager::AuthPassword) ? QLatin1String("auth") : QLatin1String("form")));
+	passwordObject.insert(QLatin1String("fields"), fieldsArray);
+
+	return passwordObject;
+}
+
+PasswordsManager::PasswordInformation FilePasswordsStorageBackend::deserializePassword(const QJsonObject &passwordObject)
+{
+	const QJsonArray fieldsArray(passwordObject.value(QLatin1String("fields")).toArray());
+	PasswordsManager::PasswordInformation password;
+	password.url = QUrl(passwordObject.value(QLatin1String("url")).toString());
+	password.timeAdded = QDateTime::fromString(passwordObject.value(QLatin1String("timeAdded")).toString(), Qt::ISODate);
+	password.timeAdded.setTimeSpec(Qt::UTC);
+	password.timeUsed = QDateTime::fromString(passwordObject.value(QLatin1String("timeUsed")).toString(), Qt::ISODate);
+	password.timeUsed.setTimeSpec(Qt::UTC);
+	password.type = ((passwordObject.value(QLatin1String("type")).toString() == QLatin1String("auth")) ? PasswordsManager::AuthPassword : PasswordsManager::FormPassword);
+	password.fields.reserve(fieldsArray.count());
+
+	for (int i = 0; i < fieldsArray.count(); ++i)
+	{
+		const QJsonObject fieldObject(fieldsArray.at(i).toObject());
+		PasswordsManager::PasswordInformation::Field field;
+		field.name = fieldObject.value(fieldObject.contains(QLatin1String("name")) ? QLatin1String("name") : QLatin1String("key")).toString();
+		field.value = fieldObject.value(QLatin1String("value")).toString();
+		field.type = ((fieldObject.value(QLatin1String("type")).toString() == QLatin1String("password")) ? PasswordsManager::PasswordField : PasswordsManager::TextField);
+
+		password.fields.append(field);
+	}
+
+	return password;
+}
+
+bool FilePasswordsStorageBackend::applyAddPassword(const PasswordsManager::PasswordInformation &password)
+{
+	const QString host(Utils::extractHost(password.url));
+	QVector<PasswordsManager::PasswordInformation> &passwords(m_passwords[host]);
+
+	for (int i = 0; i < passwords.count(); ++i)
+	{
+		const PasswordsManager::PasswordMatch match(comparePasswords(password, passwords.at(i)));
+
+		if (match == PasswordsManager::FullMatch)
+		{
+			return false;
+		}
+
+		if (match == PasswordsManager::PartialMatch)
+		{
+			passwords.replace(i, password);
+
+			updateIndex(host);
+
+			return true;
+		}
+	}
+
+	passwords.append(password);
+
+	updateIndex(host);
+
+	return true;
+}
+
+bool FilePasswordsStorageBackend::applyRemovePassword(const PasswordsManager::PasswordInformation &password)
+{
+	const QString host(Utils::extractHost(password.url));
+
+	if (!m_passwords.contains(host))
+	{
+		return false;
+	}
+
+	QVector<PasswordsManager::PasswordInformation> &passwords(m_passwords[host]);
+
+	for (int i = 0; i < passwords.count(); ++i)
+	{
+		if (comparePasswords(password, passwords.at(i)) != PasswordsManager::NoMatch)
+		{
+			passwords.removeAt(i);
+
+			updateIndex(host);
+
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void FilePasswordsStorageBackend::clearPasswords(const QString &host)
@@ -181,10 +366,11 @@ void FilePasswordsStorageBackend::clearPasswords(const QString &host)
 	if (m_passwords.contains(host))
 	{
 		m_passwords.remove(host);
+		m_types.remove(host);
 
 		emit passwordsModified();
 
-		save();
+		appendJournal(QJsonObject({{QLatin1String("action"), QLatin1String("clear")}, {QLatin1String("host"), host}}));
 	}
 }
 
@@ -192,17 +378,44 @@ void FilePasswordsStorageBackend::clearPasswords(int period)
 {
 	if (period <= 0)
 	{
-		const QString path(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+		bool isRemoved(true);
 
-		if (!QFile::remove(path))
+		if (!SessionsManager::isReadOnly())
 		{
-			Console::addMessage(tr("Failed to remove passwords file"), Console::OtherCategory, Console::ErrorLevel, path);
+			const QString path(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
+			const QString journalPath(SessionsManager::getWritableDataPath(QLatin1String("passwords.journal")));
+
+			if (QFile::exists(journalPath) && !QFile::remove(journalPath))
+			{
+				Console::addMessage(tr("Failed to remove passwords journal file"), Console::OtherCategory, Console::ErrorLevel, journalPath);
+
+				isRemoved = false;
+			}
+
+			if (QFile::exists(path) && !QFile::remove(path))
+			{
+				Console::addMessage(tr("Failed to remove passwords file"), Console::OtherCategory, Console::ErrorLevel, path);
+
+				isRemoved = false;
+			}
 		}
-		else if (!m_passwords.isEmpty())
+
+		if (isRemoved)
 		{
+			const bool wasEmpty(m_passwords.isEmpty());
+
 			m_passwords.clear();
+			m_types.clear();
 
-			emit passwordsModified();
+			m_journalEntries = 0;
+			m_isInitialized = true;
+
+			if (!wasEmpty)
+			{
+				emit passwordsModified();
+			}
+
+			return;
 		}
 	}
 
@@ -219,6 +432,7 @@ void FilePasswordsStorageBackend::clearPasswords(int period)
 	while (iterator != m_passwords.end())
 	{
 		QVector<PasswordsManager::PasswordInformation> passwords(iterator.value());
+		bool wasHostModified(false);
 
 		for (int i = (passwords.count() - 1); i >= 0; --i)
 		{
@@ -226,20 +440,29 @@ void FilePasswordsStorageBackend::clearPasswords(int period)
 			{
 				passwords.removeAt(i);
 
-				wasModified = true;
+				wasHostModified = true;
 			}
 		}
 
 		if (passwords.isEmpty())
 		{
+			m_types.remove(iterator.key());
+
 			iterator = m_passwords.erase(iterator);
 		}
 		else
 		{
-			m_passwords[iterator.key()] = passwords;
+			if (wasHostModified)
+			{
+				iterator.value() = passwords;
+
+				updateIndex(iterator.key());
+			}
 
 			++iterator;
 		}
+
+		wasModified |= wasHostModified;
 	}
 
 	if (wasModified)
@@ -254,70 +477,23 @@ void FilePasswordsStorageBackend::addPassword(const PasswordsManager::PasswordIn
 {
 	ensureInitialized();
 
-	const QString host(Utils::extractHost(password.url));
-
-	if (m_passwords.contains(host))
+	if (applyAddPassword(password))
 	{
-		const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-		for (int i = 0; i < passwords.count(); ++i)
-		{
-			const PasswordsManager::PasswordInformation existingPassword(passwords.at(i));
-
-			if (comparePasswords(password, existingPassword) == PasswordsManager::FullMatch)
-			{
-				return;
-			}
-
-			if (comparePasswords(password, existingPassword) == PasswordsManager::PartialMatch)
-			{
-				m_passwords[host].replace(i, password);
-
-				emit passwordsModified();
-
-				save();
+		emit passwordsModified();
 
-				return;
-			}
-		}
-	}
-	else
-	{
-		m_passwords[host] = {};
+		appendJournal(QJsonObject({{QLatin1String("action"), QLatin1String("add")}, {QLatin1String("password"), serializePassword(password)}}));
 	}
-
-	m_passwords[host].append(password);
-
-	emit passwordsModified();
-
-	save();
 }
 
 void FilePasswordsStorageBackend::removePassword(const PasswordsManager::PasswordInformation &password)
 {
 	ensureInitialized();
 
-	const QString host(Utils::extractHost(password.url));
-
-	if (!m_passwords.contains(host))
+	if (applyRemovePassword(password))
 	{
-		return;
-	}
-
-	const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-	for (int i = 0; i < passwords.count(); ++i)
-	{
-		if (comparePasswords(password, passwords.at(i)) != PasswordsManager::NoMatch)
-		{
-			m_passwords[host].removeAt(i);
-
-			emit passwordsModified();
-
-			save();
+		emit passwordsModified();
 
-			return;
-		}
+		appendJournal(QJsonObject({{QLatin1String("action"), QLatin1String("remove")}, {QLatin1String("password"), serializePassword(password)}}));
 	}
 }
 
@@ -359,44 +535,37 @@ QVector<PasswordsManager::PasswordInformation> FilePasswordsStorageBackend::getP
 
 	const QString host(Utils::extractHost(url));
 
-	if (m_passwords.contains(host))
+	if ((m_types.value(host) & types) == 0)
 	{
-		if (types == PasswordsManager::AnyPassword)
-		{
-			return m_passwords[host];
-		}
+		return {};
+	}
+
+	if (types == PasswordsManager::AnyPassword || (m_types.value(host) & ~types) == 0)
+	{
+		return m_passwords.value(host);
+	}
 
-		const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-		QVector<PasswordsManager::PasswordInformation> matchingPasswords;
+	const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords.value(host));
+	QVector<PasswordsManager::PasswordInformation> matchingPasswords;
 
-		for (int i = 0; i < passwords.count(); ++i)
-		{
-			const PasswordsManager::PasswordInformation password(passwords.at(i));
+	for (int i = 0; i < passwords.count(); ++i)
+	{
+		const PasswordsManager::PasswordInformation password(passwords.at(i));
 
-			if (types.testFlag(password.type))
-			{
-				matchingPasswords.append(password);
-			}
+		if (types.testFlag(password.type))
+		{
+			matchingPasswords.append(password);
 		}
-
-		return matchingPasswords;
 	}
 
-	return {};
+	return matchingPasswords;
 }
 
 PasswordsManager::PasswordMatch FilePasswordsStorageBackend::hasPassword(const PasswordsManager::PasswordInformation &password)
 {
 	ensureInitialized();
 
-	const QString host(Utils::extractHost(password.url));
-
-	if (!m_passwords.contains(host))
-	{
-		return PasswordsManager::NoMatch;
-	}
-
-	const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
+	const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords.value(Utils::extractHost(password.url)));
 
 	for (int i = 0; i < passwords.count(); ++i)
 	{
@@ -415,28 +584,7 @@ bool FilePasswordsStorageBackend::hasPasswords(const QUrl &url, PasswordsManager
 {
 	ensureInitialized();
 
-	const QString host(Utils::extractHost(url));
-	const bool hasAnyPasswords(m_passwords.contains(host));
-
-	if (types == PasswordsManager::AnyPassword)
-	{
-		return hasAnyPasswords;
-	}
-
-	if (hasAnyPasswords)
-	{
-		const QVector<PasswordsManager::PasswordInformation> passwords(m_passwords[host]);
-
-		for (int i = 0; i < passwords.count(); ++i)
-		{
-			if (types.testFlag(passwords.at(i).type))
-			{
-				return true;
-			}
-		}
-	}
-
-	return false;
+	return ((m_types.value(Utils::extractHost(url)) & types) != 0);
 }
 
 }
@@ -23,6 +23,8 @@
 
 #include "../../../../core/PasswordsStorageBackend.h"
 
+#include <QtCore/QJsonObject>
+
 namespace Otter
 {
 
@@ -50,9 +52,17 @@ public:
 protected:
 	void ensureInitialized();
 	void save();
+	void appendJournal(const QJsonObject &entryObject);
+	void updateIndex(const QString &host);
+	static QJsonObject serializePassword(const PasswordsManager::PasswordInformation &password);
+	static PasswordsManager::PasswordInformation deserializePassword(const QJsonObject &passwordObject);
+	bool applyAddPassword(const PasswordsManager::PasswordInformation &password);
+	bool applyRemovePassword(const PasswordsManager::PasswordInformation &password);
 
 private:
 	QHash<QString, QVector<PasswordsManager::PasswordInformation> > m_passwords;
+	QHash<QString, PasswordsManager::PasswordTypes> m_types;
+	int m_journalEntries;
 	bool m_isInitialized;
 };
 
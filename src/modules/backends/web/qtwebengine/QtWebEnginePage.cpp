@@ -32,10 +32,14 @@
 #include "../../../../ui/LineEditWidget.h"
 
 #include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QRegularExpression>
+#ifdef OTTER_ENABLE_QTWEBCHANNEL
+#include <QtWebChannel/QWebChannel>
+#endif
 #include <QtWebEngineWidgets/QWebEngineHistory>
 #include <QtWebEngineWidgets/QWebEngineProfile>
-#include <QtWebEngineWidgets/QWebEngineScript>
 #include <QtWebEngineWidgets/QWebEngineScriptCollection>
 #include <QtWebEngineWidgets/QWebEngineSettings>
 #include <QtWidgets/QMessageBox>
@@ -43,8 +47,33 @@
 namespace Otter
 {
 
+QtWebEngineWatchedDataBridge::QtWebEngineWatchedDataBridge(QObject *parent) : QObject(parent)
+{
+}
+
+void QtWebEngineWatchedDataBridge::addCategory(const QString &category)
+{
+	if (!m_categories.contains(category))
+	{
+		m_categories.append(category);
+
+		emit categoriesChanged(m_categories);
+	}
+}
+
+void QtWebEngineWatchedDataBridge::updateData(const QVariantMap &data)
+{
+	emit dataChanged(data);
+}
+
+QStringList QtWebEngineWatchedDataBridge::getCategories() const
+{
+	return m_categories;
+}
+
 QtWebEnginePage::QtWebEnginePage(bool isPrivate, QtWebEngineWebWidget *parent) : QWebEnginePage((isPrivate ? new QWebEngineProfile(parent) : QWebEngineProfile::defaultProfile()), parent),
 	m_widget(parent),
+	m_watchedDataBridge(new QtWebEngineWatchedDataBridge(this)),
 	m_previousNavigationType(QtWebEnginePage::NavigationTypeOther),
 	m_isIgnoringJavaScriptPopups(false),
 	m_isViewingMedia(false),
@@ -55,6 +84,15 @@ QtWebEnginePage::QtWebEnginePage(bool isPrivate, QtWebEngineWebWidget *parent) :
 		connect(profile(), &QWebEngineProfile::downloadRequested, qobject_cast<QtWebEngineWebBackend*>(m_widget->getBackend()), &QtWebEngineWebBackend::handleDownloadRequested);
 	}
 
+#ifdef OTTER_ENABLE_QTWEBCHANNEL
+	QWebChannel *channel(new QWebChannel(this));
+	channel->registerObject(QLatin1String("otterWatchedData"), m_watchedDataBridge);
+
+	setWebChannel(channel, QWebEngineScript::ApplicationWorld);
+
+	scripts().insert(createWatchedDataScript());
+#endif
+
 	connect(this, &QtWebEnginePage::loadFinished, this, &QtWebEnginePage::handleLoadFinished);
 }
 
@@ -176,21 +214,6 @@ void QtWebEnginePage::handleLoadFinished()
 	{
 		if (m_widget)
 		{
-			const QUrl url(m_widget->getUrl());
-			const ContentFiltersManager::CosmeticFiltersResult cosmeticFilters(ContentFiltersManager::getCosmeticFilters(ContentFiltersManager::getProfileIdentifiers(m_widget->getOption(SettingsManager::ContentBlocking_ProfilesOption).toStringList()), url));
-
-			if (!cosmeticFilters.rules.isEmpty() || !cosmeticFilters.exceptions.isEmpty())
-			{
-				QFile file(QLatin1String(":/modules/backends/web/qtwebengine/resources/hideElements.js"));
-
-				if (file.open(QIODevice::ReadOnly))
-				{
-					runJavaScript(QString::fromLatin1(file.readAll()).arg(createJavaScriptList(cosmeticFilters.exceptions), createJavaScriptList(cosmeticFilters.rules)));
-
-					file.close();
-				}
-			}
-
 			const QStringList blockedRequests(m_widget->getBlockedElements());
 
 			if (!blockedRequests.isEmpty())
@@ -293,6 +316,11 @@ QtWebEngineWebWidget* QtWebEnginePage::getWebWidget() const
 	return m_widget;
 }
 
+QtWebEngineWatchedDataBridge* QtWebEnginePage::getWatchedDataBridge() const
+{
+	return m_watchedDataBridge;
+}
+
 QWebEnginePage* QtWebEnginePage::createWindow(WebWindowType type)
 {
 	if (type == WebDialog)
@@ -385,6 +413,32 @@ QString QtWebEnginePage::createScriptSource(const QString &path, const QStringLi
 	return script;
 }
 
+#ifdef OTTER_ENABLE_QTWEBCHANNEL
+QWebEngineScript QtWebEnginePage::createWatchedDataScript() const
+{
+	QString source;
+	QFile file(QLatin1String(":/qtwebchannel/qwebchannel.js"));
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		source = QString::fromUtf8(file.readAll());
+
+		file.close();
+	}
+
+	source.append(createScriptSource(QLatin1String("collectWatchedData"), {QLatin1String("null")}));
+
+	QWebEngineScript script;
+	script.setName(QLatin1String("otterWatchedData"));
+	script.setSourceCode(source);
+	script.setInjectionPoint(QWebEngineScript::DocumentReady);
+	script.setWorldId(QWebEngineScript::ApplicationWorld);
+	script.setRunsOnSubFrames(false);
+
+	return script;
+}
+#endif
+
 QVariant QtWebEnginePage::runScriptSource(const QString &script)
 {
 	QVariant result;
@@ -570,6 +624,9 @@ bool QtWebEnginePage::acceptNavigationRequest(const QUrl &url, NavigationType ty
 	}
 
 	scripts().clear();
+#ifdef OTTER_ENABLE_QTWEBCHANNEL
+	scripts().insert(createWatchedDataScript());
+#endif
 
 	const QVector<UserScript*> userScripts(UserScript::getUserScriptsForUrl(url));
 
@@ -598,6 +655,20 @@ bool QtWebEnginePage::acceptNavigationRequest(const QUrl &url, NavigationType ty
 		scripts().insert(script);
 	}
 
+	const QString styleSheet((m_widget && m_widget->getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption, url).toBool()) ? ContentFiltersManager::getCosmeticFiltersStyleSheet(ContentFiltersManager::getProfileIdentifiers(m_widget->getOption(SettingsManager::ContentBlocking_ProfilesOption, url).toStringList()), url) : QString());
+
+	if (!styleSheet.isEmpty())
+	{
+		QWebEngineScript script;
+		script.setName(QLatin1String("otterContentBlocking"));
+		script.setSourceCode(createScriptSource(QLatin1String("applyContentBlockingStyleSheet"), {QString::fromUtf8(QJsonDocument(QJsonArray({styleSheet})).toJson(QJsonDocument::Compact))}));
+		script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+		script.setWorldId(QWebEngineScript::ApplicationWorld);
+		script.setRunsOnSubFrames(false);
+
+		scripts().insert(script);
+	}
+
 	emit aboutToNavigate(url, type);
 
 	return true;
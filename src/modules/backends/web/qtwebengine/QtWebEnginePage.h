@@ -26,6 +26,7 @@
 
 #include <QtWebEngineWidgets/QWebEngineCertificateError>
 #include <QtWebEngineWidgets/QWebEnginePage>
+#include <QtWebEngineWidgets/QWebEngineScript>
 
 namespace Otter
 {
@@ -33,6 +34,28 @@ namespace Otter
 class QtWebEngineWebWidget;
 class WebWidget;
 
+class QtWebEngineWatchedDataBridge final : public QObject
+{
+	Q_OBJECT
+	Q_PROPERTY(QStringList categories READ getCategories NOTIFY categoriesChanged)
+
+public:
+	explicit QtWebEngineWatchedDataBridge(QObject *parent = nullptr);
+
+	void addCategory(const QString &category);
+	QStringList getCategories() const;
+
+public slots:
+	void updateData(const QVariantMap &data);
+
+private:
+	QStringList m_categories;
+
+signals:
+	void categoriesChanged(const QStringList &categories);
+	void dataChanged(const QVariantMap &data);
+};
+
 class QtWebEnginePage final : public QWebEnginePage
 {
 	Q_OBJECT
@@ -52,6 +75,7 @@ public:
 
 	void setHistory(const Session::Window::History &history);
 	QtWebEngineWebWidget* getWebWidget() const;
+	QtWebEngineWatchedDataBridge* getWatchedDataBridge() const;
 	QString createScriptSource(const QString &path, const QStringList &parameters = {}) const;
 	QVariant runScriptSource(const QString &script);
 	QVariant runScriptFile(const QString &path, const QStringList &parameters = {});
@@ -67,6 +91,9 @@ protected:
 	QWebEnginePage* createWindow(WebWindowType type) override;
 	QtWebEngineWebWidget* createWidget(SessionsManager::OpenHints hints);
 	QString createJavaScriptList(const QStringList &rules) const;
+#ifdef OTTER_ENABLE_QTWEBCHANNEL
+	QWebEngineScript createWatchedDataScript() const;
+#endif
 	QStringList chooseFiles(FileSelectionMode mode, const QStringList &oldFiles, const QStringList &acceptedMimeTypes) override;
 	bool acceptNavigationRequest(const QUrl &url, NavigationType type, bool isMainFrame) override;
 	bool certificateError(const QWebEngineCertificateError &error) override;
@@ -79,6 +106,7 @@ protected slots:
 
 private:
 	QtWebEngineWebWidget *m_widget;
+	QtWebEngineWatchedDataBridge *m_watchedDataBridge;
 	WebWidget::SslInformation m_sslInformation;
 	QVector<QtWebEnginePage*> m_popups;
 	QVector<HistoryEntryInformation> m_history;
@@ -45,6 +45,7 @@
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
 #include <QtCore/QMimeData>
+#include <QtCore/QSet>
 #include <QtCore/QTimer>
 #include <QtCore/QtMath>
 #include <QtGui/QClipboard>
@@ -60,6 +61,8 @@
 #include <QtWidgets/QAction>
 #include <QtWidgets/QVBoxLayout>
 
+#include <algorithm>
+
 namespace Otter
 {
 
@@ -95,6 +98,7 @@ QtWebEngineWebWidget::QtWebEngineWebWidget(const QVariantMap &parameters, WebBac
 	m_focusProxyTimer(0),
 	m_updateNavigationActionsTimer(0),
 	m_isClosing(false),
+	m_isCreatingThumbnail(false),
 	m_isEditing(false),
 	m_isFullScreen(false),
 	m_isTypedIn(false)
@@ -138,6 +142,7 @@ QtWebEngineWebWidget::QtWebEngineWebWidget(const QVariantMap &parameters, WebBac
 	connect(m_page, &QtWebEnginePage::titleChanged, this, &QtWebEngineWebWidget::notifyTitleChanged);
 	connect(m_page, &QtWebEnginePage::urlChanged, this, &QtWebEngineWebWidget::notifyUrlChanged);
 	connect(m_page, &QtWebEnginePage::renderProcessTerminated, this, &QtWebEngineWebWidget::notifyRenderProcessTerminated);
+	connect(m_page->getWatchedDataBridge(), &QtWebEngineWatchedDataBridge::dataChanged, this, &QtWebEngineWebWidget::handleWatchedDataChanged);
 	connect(m_page->action(QWebEnginePage::Redo), &QAction::changed, this, &QtWebEngineWebWidget::notifyRedoActionStateChanged);
 	connect(m_page->action(QWebEnginePage::Undo), &QAction::changed, this, &QtWebEngineWebWidget::notifyUndoActionStateChanged);
 	connect(m_page, &QtWebEnginePage::aboutToNavigate, m_requestInterceptor, &QtWebEngineUrlRequestInterceptor::resetStatistics);
@@ -970,16 +975,10 @@ void QtWebEngineWebWidget::handleLoadFinished()
 
 			emit arbitraryActionsStateChanged({ActionsManager::FastForwardAction});
 		});
+#ifndef OTTER_ENABLE_QTWEBCHANNEL
 
-		const QVector<ChangeWatcher> watchers({FeedsWatcher, LinksWatcher, MetaDataWatcher, SearchEnginesWatcher, StylesheetsWatcher});
-
-		for (int i = 0; i < watchers.count(); ++i)
-		{
-			if (isWatchingChanges(watchers.at(i)))
-			{
-				updateWatchedData(watchers.at(i));
-			}
-		}
+		collectWatchedData();
+#endif
 	});
 
 	emit contentStateChanged(getContentState());
@@ -1096,6 +1095,53 @@ void QtWebEngineWebWidget::handleFullScreenRequest(QWebEngineFullScreenRequest r
 	emit isFullScreenChanged(m_isFullScreen);
 }
 
+void QtWebEngineWebWidget::handleWatchedDataChanged(const QVariantMap &data)
+{
+	if (data.contains(QLatin1String("feeds")))
+	{
+		updateLinks(m_feeds, data.value(QLatin1String("feeds")).toMap());
+
+		notifyWatchedDataChanged(FeedsWatcher);
+	}
+
+	if (data.contains(QLatin1String("links")))
+	{
+		updateLinks(m_links, data.value(QLatin1String("links")).toMap());
+
+		notifyWatchedDataChanged(LinksWatcher);
+	}
+
+	if (data.contains(QLatin1String("metaData")))
+	{
+		const QVariantList rawMetaData(data.value(QLatin1String("metaData")).toList());
+
+		m_metaData.clear();
+
+		for (int i = 0; i < rawMetaData.count(); ++i)
+		{
+			const QVariantMap entry(rawMetaData.at(i).toMap());
+
+			m_metaData.insert(entry.value(QLatin1String("key")).toString(), entry.value(QLatin1String("value")).toString());
+		}
+
+		notifyWatchedDataChanged(MetaDataWatcher);
+	}
+
+	if (data.contains(QLatin1String("searchEngines")))
+	{
+		updateLinks(m_searchEngines, data.value(QLatin1String("searchEngines")).toMap());
+
+		notifyWatchedDataChanged(SearchEnginesWatcher);
+	}
+
+	if (data.contains(QLatin1String("styleSheets")))
+	{
+		m_styleSheets = data.value(QLatin1String("styleSheets")).toStringList();
+
+		notifyWatchedDataChanged(StylesheetsWatcher);
+	}
+}
+
 void QtWebEngineWebWidget::notifyTitleChanged()
 {
 	emit titleChanged(getTitle());
@@ -1196,6 +1242,23 @@ void QtWebEngineWebWidget::notifyNavigationActionsChanged()
 	}
 }
 
+#ifndef OTTER_ENABLE_QTWEBCHANNEL
+void QtWebEngineWebWidget::collectWatchedData()
+{
+	const QStringList categories(m_page->getWatchedDataBridge()->getCategories());
+
+	if (categories.isEmpty())
+	{
+		return;
+	}
+
+	m_page->runJavaScript(m_page->createScriptSource(QLatin1String("collectWatchedData"), {QLatin1String("['") + categories.join(QLatin1String("', '")) + QLatin1String("']")}), QWebEngineScript::ApplicationWorld, [&](const QVariant &result)
+	{
+		handleWatchedDataChanged(result.toMap());
+	});
+}
+#endif
+
 void QtWebEngineWebWidget::notifyWatchedDataChanged(ChangeWatcher watcher)
 {
 	if (m_isClosing)
@@ -1240,66 +1303,65 @@ void QtWebEngineWebWidget::updateOptions(const QUrl &url)
 
 void QtWebEngineWebWidget::updateWatchedData(ChangeWatcher watcher)
 {
+	QtWebEngineWatchedDataBridge *bridge(m_page->getWatchedDataBridge());
+
 	switch (watcher)
 	{
 		case FeedsWatcher:
-			m_page->runJavaScript(m_page->createScriptSource(QLatin1String("getLinks"), {QLatin1String(R"(a[type=\'application/atom+xml\'], a[type=\'application/rss+xml\'], link[type=\'application/atom+xml\'], link[type=\'application/rss+xml\'])")}), [&](const QVariant &result)
-			{
-				m_feeds = processLinks(result.toList());
-
-				notifyWatchedDataChanged(FeedsWatcher);
-			});
+			bridge->addCategory(QLatin1String("feeds"));
 
 			break;
 		case LinksWatcher:
-			m_page->runJavaScript(m_page->createScriptSource(QLatin1String("getLinks"), {QLatin1String("a[href]")}), [&](const QVariant &result)
-			{
-				m_links = processLinks(result.toList());
-
-				notifyWatchedDataChanged(LinksWatcher);
-			});
+			bridge->addCategory(QLatin1String("links"));
 
 			break;
 		case MetaDataWatcher:
-			m_page->runJavaScript(QLatin1String("var elements = document.querySelectorAll('meta'); var metaData = []; for (var i = 0; i < elements.length; ++i) { if (elements[i].name !== '') { metaData.push({key: elements[i].name, value: elements[i].content}); } } metaData;"), [&](const QVariant &result)
-			{
-				QMultiMap<QString, QString> metaData;
-				const QVariantList rawMetaData(result.toList());
-
-				for (int i = 0; i < rawMetaData.count(); ++i)
-				{
-					const QVariantHash entry(rawMetaData.at(i).toHash());
-
-					metaData.insert(entry.value(QLatin1String("key")).toString(), entry.value(QLatin1String("value")).toString());
-				}
-
-				m_metaData = metaData;
-
-				notifyWatchedDataChanged(MetaDataWatcher);
-			});
+			bridge->addCategory(QLatin1String("metaData"));
 
 			break;
 		case SearchEnginesWatcher:
-			m_page->runJavaScript(m_page->createScriptSource(QLatin1String("getLinks"), {QLatin1String("link[type=\\'application/opensearchdescription+xml\\']")}), [&](const QVariant &result)
-			{
-				m_searchEngines = processLinks(result.toList());
-
-				notifyWatchedDataChanged(SearchEnginesWatcher);
-			});
+			bridge->addCategory(QLatin1String("searchEngines"));
 
 			break;
 		case StylesheetsWatcher:
-			m_page->runJavaScript(m_page->createScriptSource(QLatin1String("getStyleSheets")), [&](const QVariant &result)
-			{
-				m_styleSheets = result.toStringList();
-
-				notifyWatchedDataChanged(StylesheetsWatcher);
-			});
+			bridge->addCategory(QLatin1String("styleSheets"));
 
 			break;
 		default:
 			break;
 	}
+
+#ifndef OTTER_ENABLE_QTWEBCHANNEL
+	collectWatchedData();
+#endif
+}
+
+void QtWebEngineWebWidget::updateLinks(QVector<LinkUrl> &links, const QVariantMap &changes) const
+{
+	if (changes.value(QLatin1String("reset")).toBool())
+	{
+		links.clear();
+	}
+
+	const QVariantList removedUrls(changes.value(QLatin1String("removed")).toList());
+
+	if (!removedUrls.isEmpty())
+	{
+		QSet<QUrl> urls;
+		urls.reserve(removedUrls.count());
+
+		for (int i = 0; i < removedUrls.count(); ++i)
+		{
+			urls.insert(QUrl(removedUrls.at(i).toString()));
+		}
+
+		links.erase(std::remove_if(links.begin(), links.end(), [&](const LinkUrl &link)
+		{
+			return urls.contains(link.url);
+		}), links.end());
+	}
+
+	links.append(processLinks(changes.value(QLatin1String("added")).toList()));
 }
 
 void QtWebEngineWebWidget::setScrollPosition(const QPoint &position)
@@ -1591,43 +1653,40 @@ QIcon QtWebEngineWebWidget::getIcon() const
 
 QPixmap QtWebEngineWebWidget::createThumbnail(const QSize &size)
 {
-	if (!m_webView)
+	if (!m_webView || m_loadingState == OngoingLoadingState)
 	{
 		return {};
 	}
 
-	if ((size.isNull() || size == m_thumbnail.size()) && ((!m_thumbnail.isNull() && qFuzzyCompare(m_thumbnail.devicePixelRatio(), devicePixelRatio())) || m_loadingState == OngoingLoadingState))
-	{
-		return m_thumbnail;
-	}
-
 	const QSize thumbnailSize(size.isValid() ? size : QSize(260, 170));
 	const qreal thumbnailAspectRatio(static_cast<qreal>(thumbnailSize.width()) / thumbnailSize.height());
 	const QSize contentsSize(m_webView->size());
+
+	if (contentsSize.isEmpty())
+	{
+		return {};
+	}
+
 	const qreal contentsAspectRatio(static_cast<qreal>(contentsSize.width()) / contentsSize.height());
-	QPixmap pixmap(m_webView->grab(QRect({0, 0}, contentsSize)));
+	QRect rectangle({0, 0}, contentsSize);
 
-	if (!qFuzzyCompare(thumbnailAspectRatio, contentsAspectRatio))
+	if (thumbnailAspectRatio > contentsAspectRatio)
 	{
-		if (thumbnailAspectRatio > contentsAspectRatio)
-		{
-			pixmap = pixmap.copy({{0, 0}, QSize(pixmap.width(), qFloor(pixmap.width() / thumbnailAspectRatio))});
-		}
-		else
-		{
-			const int offset((pixmap.width() - qFloor(pixmap.height() * thumbnailAspectRatio)) / 2);
+		rectangle.setHeight(qFloor(contentsSize.width() / thumbnailAspectRatio));
+	}
+	else if (thumbnailAspectRatio < contentsAspectRatio)
+	{
+		const int width(qFloor(contentsSize.height() * thumbnailAspectRatio));
 
-			pixmap = pixmap.copy({{offset, 0}, QSize((pixmap.width() - (offset * 2)), pixmap.height())});
-		}
+		rectangle = QRect(((contentsSize.width() - width) / 2), 0, width, contentsSize.height());
 	}
 
-	pixmap = pixmap.scaled((thumbnailSize * devicePixelRatio()), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	m_isCreatingThumbnail = true;
+
+	QPixmap pixmap(m_webView->grab(rectangle).scaled((thumbnailSize * devicePixelRatio()), Qt::KeepAspectRatio, Qt::SmoothTransformation));
 	pixmap.setDevicePixelRatio(devicePixelRatio());
 
-	if (size.isNull())
-	{
-		m_thumbnail = pixmap;
-	}
+	m_isCreatingThumbnail = false;
 
 	return pixmap;
 }
@@ -1907,6 +1966,14 @@ bool QtWebEngineWebWidget::eventFilter(QObject *object, QEvent *event)
 				}
 			}
 
+			break;
+		case QEvent::Paint:
+		case QEvent::UpdateRequest:
+			if (!m_isCreatingThumbnail)
+			{
+				emit contentsDamaged();
+			}
+
 			break;
 		case QEvent::ContextMenu:
 			if (object == m_webView)
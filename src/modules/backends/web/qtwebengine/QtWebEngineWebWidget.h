@@ -109,7 +109,11 @@ protected:
 	void hideEvent(QHideEvent *event) override;
 	void focusInEvent(QFocusEvent *event) override;
 	void ensureInitialized();
+#ifndef OTTER_ENABLE_QTWEBCHANNEL
+	void collectWatchedData();
+#endif
 	void notifyWatchedDataChanged(ChangeWatcher watcher);
+	void updateLinks(QVector<LinkUrl> &links, const QVariantMap &changes) const;
 	void updateOptions(const QUrl &url);
 	void updateWatchedData(ChangeWatcher watcher) override;
 	void setHistory(QDataStream &stream);
@@ -140,6 +144,7 @@ protected slots:
 	void handleAuthenticationRequired(const QUrl &url, QAuthenticator *authenticator);
 	void handleProxyAuthenticationRequired(const QUrl &url, QAuthenticator *authenticator, const QString &proxy);
 	void handleFullScreenRequest(QWebEngineFullScreenRequest request);
+	void handleWatchedDataChanged(const QVariantMap &data);
 	void notifyTitleChanged();
 	void notifyUrlChanged();
 	void notifyIconChanged();
@@ -154,7 +159,6 @@ private:
 	QtWebEngineUrlRequestInterceptor *m_requestInterceptor;
 	QString m_findInPageText;
 	QDateTime m_lastUrlClickTime;
-	QPixmap m_thumbnail;
 	HitTestResult m_hitResult;
 	QHash<QNetworkReply*, QPointer<SourceViewerWebWidget> > m_viewSourceReplies;
 	QMultiMap<QString, QString> m_metaData;
@@ -169,6 +173,7 @@ private:
 	int m_focusProxyTimer;
 	int m_updateNavigationActionsTimer;
 	bool m_isClosing;
+	bool m_isCreatingThumbnail;
 	bool m_isEditing;
 	bool m_isFullScreen;
 	bool m_isTypedIn;
@@ -0,0 +1,317 @@
+(function(requestedCategories)
+{
+	const linkCategories = ['feeds', 'links', 'searchEngines'];
+	const linkSelector = 'a[href], link[href]';
+	let bridge = null;
+	let categories = (requestedCategories || []);
+	let countedElements = new WeakSet();
+	let entries = {};
+	let changes = {};
+	let sentData = {};
+	let isResetPending = true;
+	let isOtherDataChanged = true;
+	let updateTimeout = null;
+
+	function createLink(element)
+	{
+		let link = {
+			title: element.title.trim(),
+			mimeType: element.type,
+			url: element.href
+		};
+
+		if (link.title == '')
+		{
+			link.title = element.textContent.trim();
+		}
+
+		if (link.title == '')
+		{
+			let imageElement = element.querySelector('img[alt]:not([alt=\'\'])');
+
+			if (imageElement)
+			{
+				link.title = imageElement.alt;
+			}
+		}
+
+		return link;
+	}
+
+	function getLinkCategories(element)
+	{
+		let tagName = element.tagName.toLowerCase();
+		let type = element.getAttribute('type');
+		let elementCategories = [];
+
+		if (type == 'application/atom+xml' || type == 'application/rss+xml')
+		{
+			elementCategories.push('feeds');
+		}
+
+		if (tagName == 'a')
+		{
+			elementCategories.push('links');
+		}
+		else if (type == 'application/opensearchdescription+xml')
+		{
+			elementCategories.push('searchEngines');
+		}
+
+		return elementCategories.filter(function(category)
+		{
+			return categories.includes(category);
+		});
+	}
+
+	function addElement(element)
+	{
+		if (countedElements.has(element) || !element.isConnected)
+		{
+			return;
+		}
+
+		let elementCategories = getLinkCategories(element);
+
+		countedElements.add(element);
+
+		for (let i = 0; i < elementCategories.length; ++i)
+		{
+			let category = elementCategories[i];
+			let entry = entries[category].get(element.href);
+
+			if (entry)
+			{
+				++entry.count;
+
+				continue;
+			}
+
+			entry = {count: 1, link: createLink(element)};
+
+			entries[category].set(element.href, entry);
+
+			changes[category].added.set(element.href, entry.link);
+		}
+	}
+
+	function removeElement(element)
+	{
+		if (!countedElements.has(element) || element.isConnected)
+		{
+			return;
+		}
+
+		let elementCategories = getLinkCategories(element);
+
+		countedElements.delete(element);
+
+		for (let i = 0; i < elementCategories.length; ++i)
+		{
+			let category = elementCategories[i];
+			let entry = entries[category].get(element.href);
+
+			if (!entry || --entry.count > 0)
+			{
+				continue;
+			}
+
+			entries[category].delete(element.href);
+
+			changes[category].added.delete(element.href);
+			changes[category].removed.add(element.href);
+		}
+	}
+
+	function forEachLinkElement(node, callback)
+	{
+		if (node.nodeType != Node.ELEMENT_NODE)
+		{
+			return;
+		}
+
+		if (node.matches(linkSelector))
+		{
+			callback(node);
+		}
+
+		let elements = node.querySelectorAll(linkSelector);
+
+		for (let i = 0; i < elements.length; ++i)
+		{
+			callback(elements[i]);
+		}
+	}
+
+	function resetLinks()
+	{
+		countedElements = new WeakSet();
+
+		for (let i = 0; i < linkCategories.length; ++i)
+		{
+			entries[linkCategories[i]] = new Map();
+			changes[linkCategories[i]] = {reset: true, added: new Map(), removed: new Set()};
+		}
+
+		forEachLinkElement(document.documentElement, addElement);
+
+		isResetPending = false;
+	}
+
+	function collectOtherData()
+	{
+		let data = {metaData: [], styleSheets: []};
+		let elements = document.querySelectorAll('meta[name], link[rel]');
+
+		for (let i = 0; i < elements.length; ++i)
+		{
+			let element = elements[i];
+
+			if (element.tagName.toLowerCase() == 'meta')
+			{
+				if (element.name !== '')
+				{
+					data.metaData.push({key: element.name, value: element.content});
+				}
+			}
+			else if (element.getAttribute('rel') == 'alternate stylesheet' && element.title !== '' && !data.styleSheets.includes(element.title))
+			{
+				data.styleSheets.push(element.title);
+			}
+		}
+
+		isOtherDataChanged = false;
+
+		return data;
+	}
+
+	function takeChanges()
+	{
+		let result = {};
+		let hasChanges = false;
+
+		if (isResetPending)
+		{
+			resetLinks();
+		}
+
+		for (let i = 0; i < linkCategories.length; ++i)
+		{
+			let category = linkCategories[i];
+			let categoryChanges = changes[category];
+
+			if (categories.includes(category) && (categoryChanges.reset || categoryChanges.added.size > 0 || categoryChanges.removed.size > 0))
+			{
+				result[category] = {reset: categoryChanges.reset, added: Array.from(categoryChanges.added.values()), removed: Array.from(categoryChanges.removed)};
+				hasChanges = true;
+			}
+
+			changes[category] = {reset: false, added: new Map(), removed: new Set()};
+		}
+
+		if (isOtherDataChanged)
+		{
+			let data = collectOtherData();
+			let otherCategories = ['metaData', 'styleSheets'];
+
+			for (let i = 0; i < otherCategories.length; ++i)
+			{
+				let category = otherCategories[i];
+				let serializedData = JSON.stringify(data[category]);
+
+				if (categories.includes(category) && sentData[category] !== serializedData)
+				{
+					sentData[category] = serializedData;
+					result[category] = data[category];
+					hasChanges = true;
+				}
+			}
+		}
+
+		return (hasChanges ? result : null);
+	}
+
+	function sendChanges()
+	{
+		updateTimeout = null;
+
+		if (!bridge || categories.length == 0)
+		{
+			return;
+		}
+
+		let result = takeChanges();
+
+		if (result)
+		{
+			bridge.updateData(result);
+		}
+	}
+
+	function scheduleUpdate()
+	{
+		if (updateTimeout === null)
+		{
+			updateTimeout = setTimeout(sendChanges, 500);
+		}
+	}
+
+	function handleMutations(mutations)
+	{
+		for (let i = 0; i < mutations.length && !isResetPending; ++i)
+		{
+			let mutation = mutations[i];
+
+			if (mutation.type == 'attributes')
+			{
+				if (mutation.target.matches(linkSelector))
+				{
+					isResetPending = true;
+				}
+
+				isOtherDataChanged = true;
+
+				continue;
+			}
+
+			for (let j = 0; j < mutation.removedNodes.length; ++j)
+			{
+				forEachLinkElement(mutation.removedNodes[j], removeElement);
+			}
+
+			for (let j = 0; j < mutation.addedNodes.length; ++j)
+			{
+				forEachLinkElement(mutation.addedNodes[j], addElement);
+			}
+
+			isOtherDataChanged = true;
+		}
+
+		scheduleUpdate();
+	}
+
+	if (typeof QWebChannel === 'undefined' || typeof qt === 'undefined')
+	{
+		return takeChanges();
+	}
+
+	new QWebChannel(qt.webChannelTransport, function(channel)
+	{
+		bridge = channel.objects.otterWatchedData;
+		categories = bridge.categories;
+
+		bridge.categoriesChanged.connect(function(updatedCategories)
+		{
+			categories = updatedCategories;
+			isResetPending = true;
+			isOtherDataChanged = true;
+			sentData = {};
+
+			scheduleUpdate();
+		});
+
+		sendChanges();
+
+		new MutationObserver(handleMutations).observe(document.documentElement, {attributes: true, attributeFilter: ['content', 'href', 'name', 'rel', 'title', 'type'], childList: true, subtree: true});
+	});
+})(%1);
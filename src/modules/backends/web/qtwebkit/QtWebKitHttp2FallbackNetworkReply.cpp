@@ -0,0 +1,200 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+
+#include "QtWebKitHttp2FallbackNetworkReply.h"
+#include "QtWebKitNetworkManager.h"
+
+#include <QtCore/QVector>
+
+namespace Otter
+{
+
+QtWebKitHttp2FallbackNetworkReply::QtWebKitHttp2FallbackNetworkReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QNetworkReply *reply, QtWebKitNetworkManager *parent) : QNetworkReply(parent),
+	m_networkManager(parent),
+	m_hasMetaData(false),
+	m_hasFallenBack(false)
+{
+	setOperation(operation);
+	setRequest(request);
+	setUrl(request.url());
+	open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+	setReply(reply);
+}
+
+QtWebKitHttp2FallbackNetworkReply::~QtWebKitHttp2FallbackNetworkReply()
+{
+	if (m_reply)
+	{
+		m_reply->deleteLater();
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::abort()
+{
+	if (m_reply)
+	{
+		m_reply->abort();
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::ignoreSslErrors()
+{
+	if (m_reply)
+	{
+		m_reply->ignoreSslErrors();
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::ignoreSslErrorsImplementation(const QList<QSslError> &errors)
+{
+	if (m_reply)
+	{
+		m_reply->ignoreSslErrors(errors);
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::sslConfigurationImplementation(QSslConfiguration &configuration) const
+{
+	if (m_reply)
+	{
+		configuration = m_reply->sslConfiguration();
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::handleMetaDataChanged()
+{
+	m_hasMetaData = true;
+
+	updateMetaData();
+
+	emit metaDataChanged();
+}
+
+void QtWebKitHttp2FallbackNetworkReply::handleReplyFinished()
+{
+	if (!m_reply)
+	{
+		return;
+	}
+
+	if (!m_hasFallenBack && !m_hasMetaData && m_reply->error() == QNetworkReply::ProtocolFailure && m_networkManager)
+	{
+		QNetworkReply *reply(m_reply);
+
+		m_hasFallenBack = true;
+
+		m_networkManager->markAsHttp2Incompatible(reply->url(), reply->errorString());
+
+		disconnect(reply, nullptr, this, nullptr);
+
+		reply->deleteLater();
+
+		setReply(m_networkManager->createHttp1Request(operation(), request()));
+
+		return;
+	}
+
+	updateMetaData();
+
+	if (m_reply->error() != QNetworkReply::NoError)
+	{
+		setError(m_reply->error(), m_reply->errorString());
+
+		emit errorOccurred(m_reply->error());
+	}
+
+	setFinished(true);
+
+	emit finished();
+}
+
+void QtWebKitHttp2FallbackNetworkReply::setReply(QNetworkReply *reply)
+{
+	m_reply = reply;
+
+	if (!reply)
+	{
+		return;
+	}
+
+	if (readBufferSize() > 0)
+	{
+		reply->setReadBufferSize(readBufferSize());
+	}
+
+	connect(reply, &QNetworkReply::metaDataChanged, this, &QtWebKitHttp2FallbackNetworkReply::handleMetaDataChanged);
+	connect(reply, &QNetworkReply::readyRead, this, &QtWebKitHttp2FallbackNetworkReply::readyRead);
+	connect(reply, &QNetworkReply::downloadProgress, this, &QtWebKitHttp2FallbackNetworkReply::downloadProgress);
+	connect(reply, &QNetworkReply::uploadProgress, this, &QtWebKitHttp2FallbackNetworkReply::uploadProgress);
+	connect(reply, &QNetworkReply::encrypted, this, &QtWebKitHttp2FallbackNetworkReply::encrypted);
+	connect(reply, &QNetworkReply::sslErrors, this, &QtWebKitHttp2FallbackNetworkReply::sslErrors);
+	connect(reply, &QNetworkReply::redirected, this, &QtWebKitHttp2FallbackNetworkReply::redirected);
+	connect(reply, &QNetworkReply::finished, this, &QtWebKitHttp2FallbackNetworkReply::handleReplyFinished);
+}
+
+void QtWebKitHttp2FallbackNetworkReply::setReadBufferSize(qint64 size)
+{
+	QNetworkReply::setReadBufferSize(size);
+
+	if (m_reply)
+	{
+		m_reply->setReadBufferSize(size);
+	}
+}
+
+void QtWebKitHttp2FallbackNetworkReply::updateMetaData()
+{
+	const QVector<QNetworkRequest::Attribute> attributes({QNetworkRequest::HttpStatusCodeAttribute, QNetworkRequest::HttpReasonPhraseAttribute, QNetworkRequest::RedirectionTargetAttribute, QNetworkRequest::ConnectionEncryptedAttribute, QNetworkRequest::SourceIsFromCacheAttribute, QNetworkRequest::HTTP2WasUsedAttribute});
+	const QList<QByteArray> headers(m_reply->rawHeaderList());
+
+	setUrl(m_reply->url());
+
+	for (int i = 0; i < attributes.count(); ++i)
+	{
+		setAttribute(attributes.at(i), m_reply->attribute(attributes.at(i)));
+	}
+
+	for (int i = 0; i < headers.count(); ++i)
+	{
+		setRawHeader(headers.at(i), m_reply->rawHeader(headers.at(i)));
+	}
+}
+
+QNetworkReply* QtWebKitHttp2FallbackNetworkReply::getReply() const
+{
+	return m_reply.data();
+}
+
+qint64 QtWebKitHttp2FallbackNetworkReply::readData(char *data, qint64 maxSize)
+{
+	return (m_reply ? m_reply->read(data, maxSize) : -1);
+}
+
+qint64 QtWebKitHttp2FallbackNetworkReply::bytesAvailable() const
+{
+	return ((m_reply ? m_reply->bytesAvailable() : 0) + QNetworkReply::bytesAvailable());
+}
+
+bool QtWebKitHttp2FallbackNetworkReply::isSequential() const
+{
+	return true;
+}
+
+}
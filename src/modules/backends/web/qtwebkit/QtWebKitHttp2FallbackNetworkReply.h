@@ -0,0 +1,70 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+
+#ifndef OTTER_QTWEBKITHTTP2FALLBACKNETWORKREPLY_H
+#define OTTER_QTWEBKITHTTP2FALLBACKNETWORKREPLY_H
+
+#include <QtCore/QPointer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+namespace Otter
+{
+
+class QtWebKitNetworkManager;
+
+class QtWebKitHttp2FallbackNetworkReply final : public QNetworkReply
+{
+	Q_OBJECT
+
+public:
+	explicit QtWebKitHttp2FallbackNetworkReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request, QNetworkReply *reply, QtWebKitNetworkManager *parent);
+	~QtWebKitHttp2FallbackNetworkReply();
+
+	void setReadBufferSize(qint64 size) override;
+	QNetworkReply* getReply() const;
+	qint64 bytesAvailable() const override;
+	bool isSequential() const override;
+
+public slots:
+	void abort() override;
+	void ignoreSslErrors() override;
+
+protected:
+	void setReply(QNetworkReply *reply);
+	void updateMetaData();
+	void ignoreSslErrorsImplementation(const QList<QSslError> &errors) override;
+	void sslConfigurationImplementation(QSslConfiguration &configuration) const override;
+	qint64 readData(char *data, qint64 maxSize) override;
+
+protected slots:
+	void handleMetaDataChanged();
+	void handleReplyFinished();
+
+private:
+	QtWebKitNetworkManager *m_networkManager;
+	QPointer<QNetworkReply> m_reply;
+	bool m_hasMetaData;
+	bool m_hasFallenBack;
+};
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include "QtWebKitNetworkManager.h"
 #include "QtWebKitCookieJar.h"
 #include "QtWebKitFtpListingNetworkReply.h"
+#include "QtWebKitHttp2FallbackNetworkReply.h"
 #include "QtWebKitPage.h"
 #include "../../../../core/AddonsManager.h"
 #include "../../../../core/Console.h"
@@ -51,6 +52,7 @@ namespace Otter
 {
 
 WebBackend* QtWebKitNetworkManager::m_backend(nullptr);
+QSet<QString> QtWebKitNetworkManager::m_http2IncompatibleHosts;
 
 QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar *cookieJarProxy, QtWebKitWebWidget *parent) : QNetworkAccessManager(parent),
 	m_widget(parent),
@@ -60,11 +62,14 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_baseReply(nullptr),
 	m_contentState(WebWidget::UnknownContentState),
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
+	m_loadingMessage(NoMessage),
 	m_isSecureValue(UnknownValue),
 	m_bytesReceivedDifference(0),
 	m_loadingSpeedTimer(0),
+	m_pageInformationTimer(0),
 	m_areImagesEnabled(true),
 	m_canSendReferrer(true),
+	m_isHttp2Enabled(true),
 	m_isWorkingOffline(false)
 {
 	NetworkManagerFactory::initialize();
@@ -117,6 +122,10 @@ void QtWebKitNetworkManager::timerEvent(QTimerEvent *event)
 	{
 		updateLoadingSpeed();
 	}
+	else if (event->timerId() == m_pageInformationTimer)
+	{
+		updatePageInformation();
+	}
 	else
 	{
 		QNetworkAccessManager::timerEvent(event);
@@ -136,11 +145,15 @@ void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, Networ
 void QtWebKitNetworkManager::resetStatistics()
 {
 	killTimer(m_loadingSpeedTimer);
+	killTimer(m_pageInformationTimer);
 
 	const QList<WebWidget::PageInformation> keys(m_pageInformation.keys());
 
 	m_sslInformation = {};
 	m_loadingSpeedTimer = 0;
+	m_pageInformationTimer = 0;
+	m_changedPageInformation.clear();
+	m_loadingMessage = NoMessage;
 	m_blockedElements.clear();
 	m_contentBlockingProfiles.clear();
 	m_contentBlockingExceptions.clear();
@@ -204,16 +217,17 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Receiving data from %1…").arg(Utils::extractHost(reply->url())));
+		setLoadingMessage(ReceivingDataMessage, url);
 	}
 
-	const qint64 difference(bytesReceived - m_replies[reply].bytesReceived);
+	ReplyInformation &information(m_replies[reply]);
+	const qint64 difference(bytesReceived - information.bytesReceived);
 
-	m_replies[reply].bytesReceived = bytesReceived;
+	information.bytesReceived = bytesReceived;
 
-	if (!m_replies[reply].hasTotalBytes && bytesTotal > 0)
+	if (!information.hasTotalBytes && bytesTotal > 0)
 	{
-		m_replies[reply].hasTotalBytes = true;
+		information.hasTotalBytes = true;
 
 		m_pageInformation[WebWidget::TotalBytesTotalInformation] = (m_pageInformation[WebWidget::TotalBytesTotalInformation].toLongLong() + bytesTotal);
 	}
@@ -278,7 +292,7 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 
 	if (url.isValid() && url.scheme() != QLatin1String("data"))
 	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Completed request to %1").arg(Utils::extractHost(url)));
+		setLoadingMessage(CompletedRequestMessage, url);
 	}
 
 	disconnect(reply, &QNetworkReply::downloadProgress, this, &QtWebKitNetworkManager::handleDownloadProgress);
@@ -408,7 +422,9 @@ void QtWebKitNetworkManager::handleSslErrors(QNetworkReply *reply, const QList<Q
 		reply->ignoreSslErrors(errorsToIgnore);
 	}
 
-	if (reply == m_baseReply)
+	const QtWebKitHttp2FallbackNetworkReply *fallbackReply(qobject_cast<QtWebKitHttp2FallbackNetworkReply*>(m_baseReply));
+
+	if (reply == m_baseReply || (fallbackReply && fallbackReply->getReply() == reply))
 	{
 		m_isSecureValue = FalseValue;
 
@@ -430,6 +446,8 @@ void QtWebKitNetworkManager::handleLoadFinished(bool result)
 
 	m_loadingSpeedTimer = 0;
 
+	updatePageInformation();
+
 	if (result && (m_isSecureValue == TrueValue || (m_isSecureValue == UnknownValue && m_contentState.testFlag(WebWidget::SecureContentState))) && m_sslInformation.errors.isEmpty())
 	{
 		m_contentState = WebWidget::SecureContentState;
@@ -485,6 +503,7 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 
 	m_areImagesEnabled = (getOption(SettingsManager::Permissions_EnableImagesOption, url).toString() != QLatin1String("disabled"));
 	m_canSendReferrer = getOption(SettingsManager::Network_EnableReferrerOption, url).toBool();
+	m_isHttp2Enabled = getOption(SettingsManager::Network_EnableHttp2Option, url).toBool();
 	m_isWorkingOffline = getOption(SettingsManager::Network_WorkOfflineOption, url).toBool();
 
 	const QString generalCookiesPolicyValue(getOption(SettingsManager::Network_CookiesPolicyOption, url).toString());
@@ -546,13 +565,69 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	}
 }
 
+void QtWebKitNetworkManager::schedulePageInformationUpdate(WebWidget::PageInformation key)
+{
+	if (!m_changedPageInformation.contains(key))
+	{
+		m_changedPageInformation.append(key);
+	}
+
+	if (m_pageInformationTimer == 0)
+	{
+		m_pageInformationTimer = startTimer(16);
+	}
+}
+
+void QtWebKitNetworkManager::updatePageInformation()
+{
+	if (m_pageInformationTimer != 0)
+	{
+		killTimer(m_pageInformationTimer);
+
+		m_pageInformationTimer = 0;
+	}
+
+	if (m_loadingMessage != NoMessage)
+	{
+		m_pageInformation[WebWidget::LoadingMessageInformation] = getLoadingMessage();
+		m_loadingMessage = NoMessage;
+	}
+
+	const QVector<WebWidget::PageInformation> keys(m_changedPageInformation);
+
+	m_changedPageInformation.clear();
+
+	for (int i = 0; i < keys.count(); ++i)
+	{
+		const WebWidget::PageInformation key(keys.at(i));
+
+		emit pageInformationChanged(key, m_pageInformation.value(key));
+	}
+}
+
 void QtWebKitNetworkManager::setPageInformation(WebWidget::PageInformation key, const QVariant &value)
 {
 	if (m_loadingSpeedTimer != 0 || key != WebWidget::LoadingMessageInformation)
 	{
 		m_pageInformation[key] = value;
 
-		emit pageInformationChanged(key, value);
+		if (key == WebWidget::LoadingMessageInformation)
+		{
+			m_loadingMessage = NoMessage;
+		}
+
+		schedulePageInformationUpdate(key);
+	}
+}
+
+void QtWebKitNetworkManager::setLoadingMessage(LoadingMessage message, const QUrl &url)
+{
+	if (m_loadingSpeedTimer != 0)
+	{
+		m_loadingMessage = message;
+		m_loadingMessageUrl = url;
+
+		schedulePageInformationUpdate(WebWidget::LoadingMessageInformation);
 	}
 }
 
@@ -578,6 +653,20 @@ void QtWebKitNetworkManager::setWidget(QtWebKitWebWidget *widget)
 	m_cookieJarProxy->setWidget(widget);
 }
 
+void QtWebKitNetworkManager::markAsHttp2Incompatible(const QUrl &url, const QString &reason)
+{
+	if (cache())
+	{
+		m_http2IncompatibleHosts.insert(url.host());
+	}
+	else
+	{
+		m_privateHttp2IncompatibleHosts.insert(url.host());
+	}
+
+	Console::addMessage(QStringLiteral("HTTP/2 disabled for %1 after protocol error: %2").arg(url.host(), reason), Console::NetworkCategory, Console::WarningLevel, url.toString(), -1, (m_widget ? m_widget->getWindowIdentifier() : 0));
+}
+
 QtWebKitNetworkManager* QtWebKitNetworkManager::clone() const
 {
 	return new QtWebKitNetworkManager((cache() == nullptr), m_cookieJarProxy->clone(nullptr), nullptr);
@@ -730,9 +819,9 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 
 	mutableRequest.setRawHeader(QByteArrayLiteral("Accept-Language"), (m_acceptLanguage.isEmpty() ? NetworkManagerFactory::getAcceptLanguage().toLatin1() : m_acceptLanguage.toLatin1()));
 	mutableRequest.setHeader(QNetworkRequest::UserAgentHeader, m_userAgent);
-	mutableRequest.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+	mutableRequest.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, (m_isHttp2Enabled && request.url().scheme() == QLatin1String("https") && isHttp2Compatible(request.url().host())));
 
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Sending request to %1…").arg(request.url().host()));
+	setLoadingMessage(SendingRequestMessage, request.url());
 
 	QNetworkReply *reply(nullptr);
 
@@ -772,6 +861,17 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 			}
 		}
 	}
+	else if ((operation == GetOperation || operation == HeadOperation) && mutableRequest.attribute(QNetworkRequest::HTTP2AllowedAttribute).toBool())
+	{
+		QtWebKitHttp2FallbackNetworkReply *fallbackReply(new QtWebKitHttp2FallbackNetworkReply(operation, mutableRequest, QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData), this));
+
+		reply = fallbackReply;
+
+		connect(fallbackReply, &QtWebKitHttp2FallbackNetworkReply::finished, this, [=]()
+		{
+			handleRequestFinished(fallbackReply);
+		});
+	}
 	else
 	{
 		reply = QNetworkAccessManager::createRequest(operation, mutableRequest, outgoingData);
@@ -815,6 +915,14 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(Operation operation, const
 	return reply;
 }
 
+QNetworkReply* QtWebKitNetworkManager::createHttp1Request(Operation operation, const QNetworkRequest &request)
+{
+	QNetworkRequest mutableRequest(request);
+	mutableRequest.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
+
+	return QNetworkAccessManager::createRequest(operation, mutableRequest);
+}
+
 CookieJar* QtWebKitNetworkManager::getCookieJar() const
 {
 	return m_cookieJar;
@@ -830,6 +938,23 @@ QVariant QtWebKitNetworkManager::getOption(int identifier, const QUrl &url) cons
 	return (m_widget ? m_widget->getOption(identifier, url) : SettingsManager::getOption(identifier, Utils::extractHost(url)));
 }
 
+QString QtWebKitNetworkManager::getLoadingMessage() const
+{
+	switch (m_loadingMessage)
+	{
+		case SendingRequestMessage:
+			return tr("Sending request to %1…").arg(m_loadingMessageUrl.host());
+		case ReceivingDataMessage:
+			return tr("Receiving data from %1…").arg(Utils::extractHost(m_loadingMessageUrl));
+		case CompletedRequestMessage:
+			return tr("Completed request to %1").arg(Utils::extractHost(m_loadingMessageUrl));
+		default:
+			break;
+	}
+
+	return m_pageInformation.value(WebWidget::LoadingMessageInformation).toString();
+}
+
 QVariant QtWebKitNetworkManager::getPageInformation(WebWidget::PageInformation key) const
 {
 	if (key == WebWidget::RequestsBlockedInformation)
@@ -837,6 +962,11 @@ QVariant QtWebKitNetworkManager::getPageInformation(WebWidget::PageInformation k
 		return m_blockedRequests.count();
 	}
 
+	if (key == WebWidget::LoadingMessageInformation && m_loadingMessage != NoMessage)
+	{
+		return getLoadingMessage();
+	}
+
 	return m_pageInformation.value(key);
 }
 
@@ -865,4 +995,9 @@ WebWidget::ContentStates QtWebKitNetworkManager::getContentState() const
 	return m_contentState;
 }
 
+bool QtWebKitNetworkManager::isHttp2Compatible(const QString &host) const
+{
+	return !(cache() ? m_http2IncompatibleHosts.contains(host) : m_privateHttp2IncompatibleHosts.contains(host));
+}
+
 }
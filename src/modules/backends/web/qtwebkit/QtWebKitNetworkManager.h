@@ -51,6 +51,14 @@ public:
 	WebWidget::ContentStates getContentState() const;
 
 protected:
+	enum LoadingMessage
+	{
+		NoMessage = 0,
+		SendingRequestMessage,
+		ReceivingDataMessage,
+		CompletedRequestMessage
+	};
+
 	struct ReplyInformation final
 	{
 		qint64 bytesReceived = 0;
@@ -63,14 +71,21 @@ protected:
 	void registerTransfer(QNetworkReply *reply);
 	void updateLoadingSpeed();
 	void updateOptions(const QUrl &url);
+	void schedulePageInformationUpdate(WebWidget::PageInformation key);
+	void updatePageInformation();
 	void setPageInformation(WebWidget::PageInformation key, const QVariant &value);
+	void setLoadingMessage(LoadingMessage message, const QUrl &url);
 	void setFormRequest(const QUrl &url);
 	void setMainRequest(const QUrl &url);
 	void setWidget(QtWebKitWebWidget *widget);
+	void markAsHttp2Incompatible(const QUrl &url, const QString &reason);
 	QtWebKitNetworkManager* clone() const;
 	QNetworkReply* createRequest(Operation operation, const QNetworkRequest &request, QIODevice *outgoingData) override;
+	QNetworkReply* createHttp1Request(Operation operation, const QNetworkRequest &request);
 	QString getUserAgent() const;
+	QString getLoadingMessage() const;
 	QVariant getOption(int identifier, const QUrl &url) const;
+	bool isHttp2Compatible(const QString &host) const;
 
 protected slots:
 	void handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -91,6 +106,7 @@ private:
 	QString m_userAgent;
 	QUrl m_formRequestUrl;
 	QUrl m_mainRequestUrl;
+	QUrl m_loadingMessageUrl;
 	WebWidget::SslInformation m_sslInformation;
 	QStringList m_blockedElements;
 	QStringList m_unblockedHosts;
@@ -98,25 +114,32 @@ private:
 	QVector<NetworkManager::ResourceInformation> m_blockedRequests;
 	QVector<int> m_contentBlockingProfiles;
 	QSet<QUrl> m_contentBlockingExceptions;
+	QSet<QString> m_privateHttp2IncompatibleHosts;
 	QHash<QNetworkReply*, ReplyInformation> m_replies;
 	QMap<QByteArray, QByteArray> m_headers;
 	QMap<WebWidget::PageInformation, QVariant> m_pageInformation;
+	QVector<WebWidget::PageInformation> m_changedPageInformation;
 	WebWidget::ContentStates m_contentState;
 	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
+	LoadingMessage m_loadingMessage;
 	TrileanValue m_isSecureValue;
 	qint64 m_bytesReceivedDifference;
 	int m_loadingSpeedTimer;
+	int m_pageInformationTimer;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
+	bool m_isHttp2Enabled;
 	bool m_isWorkingOffline;
 
 	static WebBackend *m_backend;
+	static QSet<QString> m_http2IncompatibleHosts;
 
 signals:
 	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
 	void requestBlocked(const NetworkManager::ResourceInformation &request);
 	void contentStateChanged(WebWidget::ContentStates state);
 
+friend class QtWebKitHttp2FallbackNetworkReply;
 friend class QtWebKitPage;
 friend class QtWebKitWebWidget;
 };
@@ -37,6 +37,8 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
 #include <QtGui/QGuiApplication>
 #include <QtGui/QWheelEvent>
 #include <QtWebKit/QWebHistory>
@@ -52,6 +54,7 @@ QtWebKitFrame::QtWebKitFrame(QWebFrame *frame, QtWebKitWebWidget *parent) : QObj
 	m_isDisplayingErrorPage(false)
 {
 	connect(frame, &QWebFrame::destroyed, this, &QtWebKitFrame::deleteLater);
+	connect(frame, &QWebFrame::initialLayoutCompleted, this, &QtWebKitFrame::applyContentBlockingStyleSheet);
 	connect(frame, &QWebFrame::loadFinished, this, &QtWebKitFrame::handleLoadFinished);
 }
 
@@ -65,18 +68,50 @@ void QtWebKitFrame::runUserScripts(const QUrl &url) const
 	}
 }
 
-void QtWebKitFrame::applyContentBlockingRules(const QStringList &rules, bool isHiding)
+void QtWebKitFrame::applyContentBlockingStyleSheet()
 {
-	const QString value(isHiding ? QLatin1String("none !important") : QString());
-	const QWebElementCollection elements(m_frame->documentElement().findAll(rules.join(QLatin1Char(','))));
+	if (!m_widget)
+	{
+		return;
+	}
+
+	const QString styleSheet(m_widget->getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption).toBool() ? ContentFiltersManager::getCosmeticFiltersStyleSheet(ContentFiltersManager::getProfileIdentifiers(m_widget->getOption(SettingsManager::ContentBlocking_ProfilesOption).toStringList()), m_widget->getUrl()) : QString());
+
+	if (styleSheet.isEmpty() && m_frame->findFirstElement(QLatin1String("style[data-otter-content-blocking]")).isNull())
+	{
+		return;
+	}
+
+	QFile file(QLatin1String(":/modules/backends/web/qtwebkit/resources/applyContentBlockingStyleSheet.js"));
+
+	if (file.open(QIODevice::ReadOnly))
+	{
+		m_frame->documentElement().evaluateJavaScript(QString::fromLatin1(file.readAll()).arg(QString::fromUtf8(QJsonDocument(QJsonArray({styleSheet})).toJson(QJsonDocument::Compact))));
+
+		file.close();
+	}
+}
+
+void QtWebKitFrame::hideBlockedElements()
+{
+	const QStringList blockedRequests(m_widget->getBlockedElements());
+
+	if (blockedRequests.isEmpty())
+	{
+		return;
+	}
+
+	const QSet<QString> blockedUrls(blockedRequests.begin(), blockedRequests.end());
+	const QUrl baseUrl(m_frame->baseUrl());
+	const QWebElementCollection elements(m_frame->documentElement().findAll(QLatin1String("[src]")));
 
 	for (int i = 0; i < elements.count(); ++i)
 	{
 		QWebElement element(elements.at(i));
 
-		if (!element.isNull())
+		if (blockedUrls.contains(baseUrl.resolved(QUrl(element.attribute(QLatin1String("src")))).url()))
 		{
-			element.setStyleProperty(QLatin1String("display"), value);
+			element.setStyleProperty(QLatin1String("display"), QLatin1String("none !important"));
 		}
 	}
 }
@@ -123,39 +158,11 @@ void QtWebKitFrame::handleLoadFinished()
 		}
 	}
 
-	if (!m_widget->getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption).toBool())
-	{
-		return;
-	}
+	applyContentBlockingStyleSheet();
 
-	const ContentFiltersManager::CosmeticFiltersResult cosmeticFilters(ContentFiltersManager::getCosmeticFilters(ContentFiltersManager::getProfileIdentifiers(m_widget->getOption(SettingsManager::ContentBlocking_ProfilesOption).toStringList()), m_widget->getUrl()));
-
-	applyContentBlockingRules(cosmeticFilters.rules, true);
-	applyContentBlockingRules(cosmeticFilters.exceptions, false);
-
-	const QStringList blockedRequests(m_widget->getBlockedElements());
-
-	if (!blockedRequests.isEmpty())
+	if (m_widget->getOption(SettingsManager::ContentBlocking_EnableContentBlockingOption).toBool())
 	{
-		const QWebElementCollection elements(m_frame->documentElement().findAll(QLatin1String("[src]")));
-
-		for (int i = 0; i < elements.count(); ++i)
-		{
-			QWebElement element(elements.at(i));
-			const QUrl url(element.attribute(QLatin1String("src")));
-
-			for (int j = 0; j < blockedRequests.count(); ++j)
-			{
-				const QString blockedRequest(blockedRequests.at(j));
-
-				if (url.matches(QUrl(blockedRequest), QUrl::None) || blockedRequest.endsWith(url.url()))
-				{
-					element.setStyleProperty(QLatin1String("display"), QLatin1String("none !important"));
-
-					break;
-				}
-			}
-		}
+		hideBlockedElements();
 	}
 }
 
@@ -48,9 +48,10 @@ public slots:
 	void handleIsDisplayingErrorPageChanged(QWebFrame *frame, bool isDisplayingErrorPage);
 
 protected:
-	void applyContentBlockingRules(const QStringList &rules, bool isHiding);
+	void hideBlockedElements();
 
 protected slots:
+	void applyContentBlockingStyleSheet();
 	void handleLoadFinished();
 
 private:
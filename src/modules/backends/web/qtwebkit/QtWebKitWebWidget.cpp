@@ -113,6 +113,7 @@ QtWebKitWebWidget::QtWebKitWebWidget(const QVariantMap &parameters, WebBackend *
 	m_canLoadPlugins(false),
 #endif
 	m_isAudioMuted(false),
+	m_isCreatingThumbnail(false),
 	m_isFullScreen(false),
 	m_isTypedIn(false),
 	m_isNavigating(false)
@@ -1399,8 +1400,8 @@ void QtWebKitWebWidget::handleLoadStarted()
 		return;
 	}
 
-	m_thumbnail = {};
 	m_messageToken = QUuid::createUuid().toString();
+	m_linksCollectionTimer.invalidate();
 #ifdef OTTER_QTWEBKIT_PLUGINS_AVAILABLE
 	m_canLoadPlugins = (getOption(SettingsManager::Permissions_EnablePluginsOption, getUrl()).toString() == QLatin1String("enabled"));
 #endif
@@ -1433,8 +1434,8 @@ void QtWebKitWebWidget::handleLoadFinished(bool result)
 
 	m_networkManager->handleLoadFinished(result);
 
-	m_thumbnail = {};
 	m_loadingState = FinishedLoadingState;
+	m_linksCollectionTimer.invalidate();
 
 #ifdef OTTER_QTWEBKIT_PLUGINS_AVAILABLE
 	updateAmountOfDeferredPlugins();
@@ -2080,6 +2081,93 @@ QVariant QtWebKitWebWidget::getPageInformation(PageInformation key) const
 	return m_networkManager->getPageInformation(key);
 }
 
+void QtWebKitWebWidget::collectLinks() const
+{
+	if (m_linksCollectionTimer.isValid() && !m_linksCollectionTimer.hasExpired(1000))
+	{
+		return;
+	}
+
+	const QWebElementCollection elements(m_page->mainFrame()->findAllElements(QLatin1String("a[href], link[href]")));
+	QSet<QUrl> feedUrls;
+	QSet<QUrl> linkUrls;
+	QSet<QUrl> searchEngineUrls;
+
+	m_feeds.clear();
+	m_links.clear();
+	m_links.reserve(elements.count());
+	m_searchEngines.clear();
+
+	for (int i = 0; i < elements.count(); ++i)
+	{
+		const QWebElement element(elements.at(i));
+		const QString mimeType(element.attribute(QLatin1String("type")));
+		const bool isAnchor(element.tagName().compare(QLatin1String("a"), Qt::CaseInsensitive) == 0);
+		const bool isFeed(mimeType == QLatin1String("application/atom+xml") || mimeType == QLatin1String("application/rss+xml"));
+		const bool isSearchEngine(!isAnchor && mimeType == QLatin1String("application/opensearchdescription+xml"));
+
+		if (!isAnchor && !isFeed && !isSearchEngine)
+		{
+			continue;
+		}
+
+		const QUrl url(resolveUrl(m_page->mainFrame(), QUrl(element.attribute(QLatin1String("href")))));
+		const bool needsFeed(isFeed && !feedUrls.contains(url));
+		const bool needsLink(isAnchor && !linkUrls.contains(url));
+		const bool needsSearchEngine(isSearchEngine && !searchEngineUrls.contains(url));
+
+		if (!needsFeed && !needsLink && !needsSearchEngine)
+		{
+			continue;
+		}
+
+		LinkUrl link;
+		link.title = element.attribute(QLatin1String("title"));
+		link.mimeType = mimeType;
+		link.url = url;
+
+		if (link.title.isEmpty())
+		{
+			link.title = element.toPlainText().simplified();
+		}
+
+		if (link.title.isEmpty())
+		{
+			const QWebElement imageElement(element.findFirst(QLatin1String("img[alt]:not([alt=''])")));
+
+			if (!imageElement.isNull())
+			{
+				link.title = imageElement.attribute(QLatin1String("alt"));
+			}
+		}
+
+		if (needsFeed)
+		{
+			feedUrls.insert(url);
+
+			m_feeds.append(link);
+		}
+
+		if (needsLink)
+		{
+			linkUrls.insert(url);
+
+			m_links.append(link);
+		}
+
+		if (needsSearchEngine)
+		{
+			searchEngineUrls.insert(url);
+
+			m_searchEngines.append(link);
+		}
+	}
+
+	m_links.squeeze();
+
+	m_linksCollectionTimer.start();
+}
+
 QUrl QtWebKitWebWidget::resolveUrl(QWebFrame *frame, const QUrl &url) const
 {
 	if (url.isRelative())
@@ -2111,54 +2199,34 @@ QIcon QtWebKitWebWidget::getIcon() const
 
 QPixmap QtWebKitWebWidget::createThumbnail(const QSize &size)
 {
-	if ((size.isNull() || size == m_thumbnail.size()) && ((!m_thumbnail.isNull() && qFuzzyCompare(m_thumbnail.devicePixelRatio(), devicePixelRatio())) || m_loadingState == OngoingLoadingState))
+	if (m_loadingState == OngoingLoadingState)
 	{
-		return m_thumbnail;
+		return {};
 	}
 
 	const QSize thumbnailSize(size.isValid() ? size : QSize(260, 170));
-	const QSize oldViewportSize(m_page->viewportSize());
-	const QPoint position(m_page->mainFrame()->scrollPosition());
-	const qreal zoom(m_page->mainFrame()->zoomFactor());
-	QSize contentsSize(m_page->mainFrame()->contentsSize());
-	QWidget *newView(new QWidget());
-	QWidget *oldView(m_page->view());
+	const QSize viewportSize(m_page->viewportSize());
 
-	m_page->setView(newView);
-	m_page->setViewportSize(contentsSize);
-	m_page->mainFrame()->setZoomFactor(1);
-
-	if (contentsSize.width() > 2000)
+	if (viewportSize.isEmpty())
 	{
-		contentsSize.setWidth(2000);
+		return {};
 	}
 
-	contentsSize.setHeight(qRound(thumbnailSize.height() * (static_cast<qreal>(contentsSize.width()) / thumbnailSize.width())));
-
-	m_page->setViewportSize(contentsSize);
-
-	QPixmap pixmap(contentsSize);
+	const qreal scale(qMax((static_cast<qreal>(thumbnailSize.width()) / viewportSize.width()), (static_cast<qreal>(thumbnailSize.height()) / viewportSize.height())));
+	const QRect sourceRectangle(QPoint(0, 0), (thumbnailSize / scale));
+	QPixmap pixmap(thumbnailSize * devicePixelRatio());
+	pixmap.setDevicePixelRatio(devicePixelRatio());
 	pixmap.fill(Qt::white);
 
 	QPainter painter(&pixmap);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	painter.scale(scale, scale);
 
-	m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion({{0, 0}, contentsSize}));
-	m_page->mainFrame()->setZoomFactor(zoom);
-	m_page->setView(oldView);
-	m_page->setViewportSize(oldViewportSize);
-	m_page->mainFrame()->setScrollPosition(position);
-
-	painter.end();
-
-	pixmap = pixmap.scaled((thumbnailSize * devicePixelRatio()), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-	pixmap.setDevicePixelRatio(devicePixelRatio());
+	m_isCreatingThumbnail = true;
 
-	newView->deleteLater();
+	m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(sourceRectangle));
 
-	if (size.isNull())
-	{
-		m_thumbnail = pixmap;
-	}
+	m_isCreatingThumbnail = false;
 
 	return pixmap;
 }
@@ -2461,65 +2529,23 @@ QStringList QtWebKitWebWidget::getStyleSheets() const
 
 QVector<WebWidget::LinkUrl> QtWebKitWebWidget::getFeeds() const
 {
-	return getLinks(QLatin1String("a[type='application/atom+xml'], a[type='application/rss+xml'], link[type='application/atom+xml'], link[type='application/rss+xml']"));
-}
-
-QVector<WebWidget::LinkUrl> QtWebKitWebWidget::getLinks(const QString &query) const
-{
-	const QWebElementCollection elements(m_page->mainFrame()->findAllElements(query));
-	QSet<QUrl> urls;
-	urls.reserve(elements.count());
-
-	QVector<LinkUrl> links;
-	links.reserve(elements.count());
-
-	for (int i = 0; i < elements.count(); ++i)
-	{
-		const QUrl url(resolveUrl(m_page->mainFrame(), QUrl(elements.at(i).attribute(QLatin1String("href")))));
-
-		if (urls.contains(url))
-		{
-			continue;
-		}
-
-		urls.insert(url);
+	collectLinks();
 
-		LinkUrl link;
-		link.title = elements.at(i).attribute(QLatin1String("title"));
-		link.mimeType = elements.at(i).attribute(QLatin1String("type"));
-		link.url = url;
-
-		if (link.title.isEmpty())
-		{
-			link.title = elements.at(i).toPlainText().simplified();
-		}
-
-		if (link.title.isEmpty())
-		{
-			const QWebElement imageElement(elements.at(i).findFirst(QLatin1String("img[alt]:not([alt=''])")));
-
-			if (!imageElement.isNull())
-			{
-				link.title = imageElement.attribute(QLatin1String("alt"));
-			}
-		}
-
-		links.append(link);
-	}
-
-	links.squeeze();
-
-	return links;
+	return m_feeds;
 }
 
 QVector<WebWidget::LinkUrl> QtWebKitWebWidget::getLinks() const
 {
-	return getLinks(QLatin1String("a[href]"));
+	collectLinks();
+
+	return m_links;
 }
 
 QVector<WebWidget::LinkUrl> QtWebKitWebWidget::getSearchEngines() const
 {
-	return getLinks(QLatin1String("link[type='application/opensearchdescription+xml']"));
+	collectLinks();
+
+	return m_searchEngines;
 }
 
 QVector<NetworkManager::ResourceInformation> QtWebKitWebWidget::getBlockedRequests() const
@@ -2760,6 +2786,13 @@ bool QtWebKitWebWidget::eventFilter(QObject *object, QEvent *event)
 
 				break;
 #endif
+			case QEvent::Paint:
+				if (!m_isCreatingThumbnail)
+				{
+					emit contentsDamaged();
+				}
+
+				break;
 			case QEvent::ContextMenu:
 				{
 					const QContextMenuEvent *contextMenuEvent(static_cast<QContextMenuEvent*>(event));
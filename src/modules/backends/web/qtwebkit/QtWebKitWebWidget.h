@@ -23,6 +23,7 @@
 
 #include "../../../../ui/WebWidget.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QQueue>
 #include <QtNetwork/QNetworkReply>
 #include <QtWebKitWidgets/QWebInspector>
@@ -134,8 +135,8 @@ protected:
 #ifdef OTTER_QTWEBKIT_PLUGINS_AVAILABLE
 	QString getPluginToken() const;
 #endif
+	void collectLinks() const;
 	QUrl resolveUrl(QWebFrame *frame, const QUrl &url) const;
-	QVector<LinkUrl> getLinks(const QString &query) const;
 #ifdef OTTER_QTWEBKIT_PLUGINS_AVAILABLE
 	int getAmountOfDeferredPlugins() const override;
 	bool canLoadPlugins() const;
@@ -185,10 +186,13 @@ private:
 #ifdef OTTER_QTWEBKIT_PLUGINS_AVAILABLE
 	QString m_pluginToken;
 #endif
-	QPixmap m_thumbnail;
 	QNetworkRequest m_formRequest;
 	QByteArray m_formRequestBody;
 	QQueue<Transfer*> m_transfers;
+	mutable QVector<LinkUrl> m_feeds;
+	mutable QVector<LinkUrl> m_links;
+	mutable QVector<LinkUrl> m_searchEngines;
+	mutable QElapsedTimer m_linksCollectionTimer;
 	QHash<QNetworkReply*, QPointer<SourceViewerWebWidget> > m_viewSourceReplies;
 	QNetworkAccessManager::Operation m_formRequestOperation;
 	LoadingState m_loadingState;
@@ -200,6 +204,7 @@ private:
 	bool m_canLoadPlugins;
 #endif
 	bool m_isAudioMuted;
+	bool m_isCreatingThumbnail;
 	bool m_isFullScreen;
 	bool m_isTypedIn;
 	bool m_isNavigating;
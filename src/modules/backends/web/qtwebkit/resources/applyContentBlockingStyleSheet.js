@@ -0,0 +1,54 @@
+(function(styleSheet)
+{
+	let styleElement = document.querySelector('style[data-otter-content-blocking]');
+
+	if (styleElement && styleElement.otterStyleSheet !== undefined)
+	{
+		styleElement.otterStyleSheet = styleSheet;
+		styleElement.textContent = styleSheet;
+
+		return;
+	}
+
+	if (styleSheet === '')
+	{
+		return;
+	}
+
+	styleElement = document.createElement('style');
+	styleElement.setAttribute('data-otter-content-blocking', '');
+	styleElement.otterStyleSheet = styleSheet;
+
+	function applyStyleSheet()
+	{
+		const attributes = ['media', 'type'];
+		let parentElement = (document.head || document.documentElement);
+
+		for (let i = 0; i < attributes.length; ++i)
+		{
+			if (styleElement.hasAttribute(attributes[i]))
+			{
+				styleElement.removeAttribute(attributes[i]);
+			}
+		}
+
+		if (styleElement.textContent !== styleElement.otterStyleSheet)
+		{
+			styleElement.textContent = styleElement.otterStyleSheet;
+		}
+
+		if (styleElement.disabled)
+		{
+			styleElement.disabled = false;
+		}
+
+		if (parentElement && !document.documentElement.contains(styleElement))
+		{
+			parentElement.appendChild(styleElement);
+		}
+	}
+
+	applyStyleSheet();
+
+	new MutationObserver(applyStyleSheet).observe(document, {attributes: true, attributeFilter: ['media', 'type'], characterData: true, childList: true, subtree: true});
+})(%1[0]);
@@ -19,11 +19,13 @@
 **************************************************************************/
 
 #include "HtmlBookmarksImportDataExchanger.h"
-#include "../../../core/WebBackend.h"
+#include "../../../core/BookmarksManager.h"
 #include "../../../ui/BookmarksImportOptionsWidget.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QTextStream>
 
 namespace Otter
 {
@@ -100,15 +102,6 @@ bool HtmlBookmarksImportDataExchanger::hasOptions() const
 
 bool HtmlBookmarksImportDataExchanger::importData(const QString &path)
 {
-	WebBackend *webBackend(AddonsManager::getWebBackend());
-
-	if (!webBackend)
-	{
-		emit exchangeFinished(BookmarksExchange, FailedOperation, 0);
-
-		return false;
-	}
-
 	BookmarksModel::Bookmark *folder(nullptr);
 	bool areDuplicatesAllowed(false);
 
@@ -130,22 +123,509 @@ bool HtmlBookmarksImportDataExchanger::importData(const QString &path)
 		}
 	}
 
-	BookmarksImportJob *job(webBackend->createBookmarksImportJob(folder, getSuggestedPath(path), areDuplicatesAllowed));
+	HtmlBookmarksImportJob *job(new HtmlBookmarksImportJob(folder, getSuggestedPath(path), areDuplicatesAllowed, this));
 
-	if (!job)
+	connect(job, &HtmlBookmarksImportJob::importStarted, this, &HtmlBookmarksImportDataExchanger::exchangeStarted);
+	connect(job, &HtmlBookmarksImportJob::importProgress, this, &HtmlBookmarksImportDataExchanger::exchangeProgress);
+	connect(job, &HtmlBookmarksImportJob::importFinished, this, &HtmlBookmarksImportDataExchanger::exchangeFinished);
+
+	job->start();
+
+	return true;
+}
+
+HtmlBookmarksImportJob::HtmlBookmarksImportJob(BookmarksModel::Bookmark *folder, const QString &path, bool areDuplicatesAllowed, QObject *parent) : BookmarksImportJob(folder, areDuplicatesAllowed, parent),
+	m_path(path),
+	m_lastBookmark(0),
+	m_pendingFolder(0),
+	m_position(0),
+	m_parseTimer(0),
+	m_currentAmount(0),
+	m_totalAmount(-1),
+	m_isRunning(false)
+{
+}
+
+void HtmlBookmarksImportJob::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_parseTimer)
 	{
-		emit exchangeFinished(BookmarksExchange, FailedOperation, 0);
+		BookmarksImportJob::timerEvent(event);
 
-		return false;
+		return;
 	}
 
-	connect(job, &BookmarksImportJob::importStarted, this, &HtmlBookmarksImportDataExchanger::exchangeStarted);
-	connect(job, &BookmarksImportJob::importProgress, this, &HtmlBookmarksImportDataExchanger::exchangeProgress);
-	connect(job, &BookmarksImportJob::importFinished, this, &HtmlBookmarksImportDataExchanger::exchangeFinished);
+	if (hasRemovedFolder())
+	{
+		finishImport(DataExchanger::FailedOperation);
 
-	job->start();
+		return;
+	}
+
+	const bool isFinished(parseContent());
+
+	setProgress(m_content.isEmpty() ? 100 : static_cast<int>((static_cast<qint64>(m_position) * 100) / m_content.length()));
+
+	emit importProgress(DataExchanger::BookmarksExchange, m_totalAmount, m_currentAmount);
+
+	if (isFinished)
+	{
+		finishImport(DataExchanger::SuccessfullOperation);
+	}
+}
+
+void HtmlBookmarksImportJob::start()
+{
+	QFile file(m_path);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		emit importFinished(DataExchanger::BookmarksExchange, DataExchanger::FailedOperation, 0);
+		emit jobFinished(false);
+
+		deleteLater();
+
+		return;
+	}
+
+	m_isRunning = true;
+
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+
+	m_content = stream.readAll();
+
+	file.close();
+
+	m_totalAmount = (m_content.count(QLatin1String("<dt>"), Qt::CaseInsensitive) + m_content.count(QLatin1String("<hr"), Qt::CaseInsensitive));
+
+	emit importStarted(DataExchanger::BookmarksExchange, m_totalAmount);
+
+	BookmarksManager::getModel()->beginImport(getImportFolder(), m_content.count(QLatin1String(" href="), Qt::CaseInsensitive), m_content.count(QLatin1String(" shortcuturl="), Qt::CaseInsensitive));
+
+	m_parseTimer = startTimer(0);
+}
+
+void HtmlBookmarksImportJob::cancel()
+{
+	if (m_isRunning)
+	{
+		finishImport(DataExchanger::CancelledOperation);
+	}
+}
+
+void HtmlBookmarksImportJob::finishImport(DataExchanger::OperationResult result)
+{
+	if (m_parseTimer != 0)
+	{
+		killTimer(m_parseTimer);
+
+		m_parseTimer = 0;
+	}
+
+	BookmarksManager::getModel()->endImport();
+
+	m_content.clear();
+
+	m_isRunning = false;
+
+	emit importFinished(DataExchanger::BookmarksExchange, result, m_currentAmount);
+	emit jobFinished(result == DataExchanger::SuccessfullOperation);
+
+	deleteLater();
+}
+
+quint64 HtmlBookmarksImportJob::addBookmark(BookmarksModel::BookmarkType type, const QHash<QString, QString> &attributes, const QString &title)
+{
+	QMap<int, QVariant> metaData;
+	const bool isUrlBookmark(type == BookmarksModel::UrlBookmark || type == BookmarksModel::FeedBookmark);
+
+	if (type != BookmarksModel::SeparatorBookmark)
+	{
+		metaData[BookmarksModel::TitleRole] = title;
+	}
+
+	if (isUrlBookmark)
+	{
+		const QUrl url(attributes.value(QLatin1String("href")));
+
+		if (!areDuplicatesAllowed() && BookmarksManager::hasBookmark(url))
+		{
+			return 0;
+		}
+
+		metaData[BookmarksModel::UrlRole] = url;
+	}
+
+	const QString keyword(attributes.value(QLatin1String("shortcuturl")));
+
+	if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
+	{
+		metaData[BookmarksModel::KeywordRole] = keyword;
+	}
+
+	if (attributes.contains(QLatin1String("add_date")))
+	{
+		const QDateTime dateTime(getDateTime(attributes.value(QLatin1String("add_date"))));
+
+		if (dateTime.isValid())
+		{
+			metaData[BookmarksModel::TimeAddedRole] = dateTime;
+			metaData[BookmarksModel::TimeModifiedRole] = dateTime;
+		}
+	}
+
+	if (attributes.contains(QLatin1String("last_modified")))
+	{
+		const QDateTime dateTime(getDateTime(attributes.value(QLatin1String("last_modified"))));
+
+		if (dateTime.isValid())
+		{
+			metaData[BookmarksModel::TimeModifiedRole] = dateTime;
+		}
+	}
+
+	if (isUrlBookmark && attributes.contains(QLatin1String("last_visited")))
+	{
+		const QDateTime dateTime(getDateTime(attributes.value(QLatin1String("last_visited"))));
+
+		if (dateTime.isValid())
+		{
+			metaData[BookmarksModel::TimeVisitedRole] = dateTime;
+		}
+	}
+
+	const BookmarksModel::Bookmark *bookmark(BookmarksManager::addBookmark(type, metaData, getCurrentFolder()));
+
+	++m_currentAmount;
+
+	return (bookmark ? bookmark->getIdentifier() : 0);
+}
+
+bool HtmlBookmarksImportJob::parseContent()
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	while (m_position < m_content.length())
+	{
+		if (timer.elapsed() >= 20)
+		{
+			return false;
+		}
+
+		const int tagStart(m_content.indexOf(QLatin1Char('<'), m_position));
+
+		if (!m_element.isEmpty())
+		{
+			m_text.append(m_content.midRef(m_position, (((tagStart < 0) ? m_content.length() : tagStart) - m_position)));
+		}
+
+		if (tagStart < 0)
+		{
+			m_position = m_content.length();
+
+			break;
+		}
+
+		if (m_content.midRef((tagStart + 1), 3) == QLatin1String("!--"))
+		{
+			const int commentEnd(m_content.indexOf(QLatin1String("-->"), (tagStart + 4)));
+
+			m_position = ((commentEnd < 0) ? m_content.length() : (commentEnd + 3));
+
+			continue;
+		}
+
+		const bool isClosing(m_content.midRef((tagStart + 1), 1) == QLatin1String("/"));
+		const int nameStart(tagStart + (isClosing ? 2 : 1));
+		int nameEnd(nameStart);
+
+		while (nameEnd < m_content.length() && (m_content.at(nameEnd).isLetter() || (nameEnd > nameStart && m_content.at(nameEnd).isDigit())))
+		{
+			++nameEnd;
+		}
+
+		const int tagEnd((nameEnd > nameStart) ? findTagEnd(m_content, nameEnd) : -1);
+
+		if (tagEnd < 0)
+		{
+			if (!m_element.isEmpty())
+			{
+				m_text.append(QLatin1Char('<'));
+			}
+
+			m_position = (tagStart + 1);
+
+			continue;
+		}
+
+		m_position = (tagEnd + 1);
+
+		const QString name(m_content.mid(nameStart, (nameEnd - nameStart)).toLower());
+
+		if (m_element == QLatin1String("dd") && (name == QLatin1String("dt") || name == QLatin1String("dd") || name == QLatin1String("dl") || name == QLatin1String("hr")))
+		{
+			BookmarksModel::Bookmark *bookmark((m_lastBookmark > 0) ? BookmarksManager::getBookmark(m_lastBookmark) : nullptr);
+
+			if (bookmark)
+			{
+				bookmark->setItemData(decodeEntities(m_text).trimmed(), BookmarksModel::DescriptionRole);
+			}
+
+			m_element.clear();
+		}
+
+		if (isClosing)
+		{
+			if (name == m_element && (name == QLatin1String("a") || name == QLatin1String("h3")))
+			{
+				if (name == QLatin1String("h3"))
+				{
+					m_lastBookmark = addBookmark(BookmarksModel::FolderBookmark, m_attributes, decodeEntities(m_text).simplified());
+					m_pendingFolder = m_lastBookmark;
+				}
+				else
+				{
+					m_lastBookmark = addBookmark((m_attributes.contains(QLatin1String("feedurl")) ? BookmarksModel::FeedBookmark : BookmarksModel::UrlBookmark), m_attributes, decodeEntities(m_text).simplified());
+				}
+
+				m_element.clear();
+			}
+			else if (name == QLatin1String("dl"))
+			{
+				if (!m_lists.isEmpty() && m_lists.takeLast())
+				{
+					goToParent();
+				}
+
+				m_lastBookmark = 0;
+				m_pendingFolder = 0;
+			}
+		}
+		else if (name == QLatin1String("a") || name == QLatin1String("h3"))
+		{
+			m_attributes = parseAttributes(m_content.mid(nameEnd, (tagEnd - nameEnd)));
+			m_element = name;
+
+			m_text.clear();
+		}
+		else if (name == QLatin1String("dd"))
+		{
+			m_element = name;
+
+			m_text.clear();
+		}
+		else if (name == QLatin1String("dt"))
+		{
+			m_pendingFolder = 0;
+		}
+		else if (name == QLatin1String("hr"))
+		{
+			m_lastBookmark = addBookmark(BookmarksModel::SeparatorBookmark, {}, {});
+			m_pendingFolder = 0;
+		}
+		else if (name == QLatin1String("dl"))
+		{
+			BookmarksModel::Bookmark *folder((m_pendingFolder > 0) ? BookmarksManager::getBookmark(m_pendingFolder) : nullptr);
+
+			m_lists.append(folder != nullptr);
+
+			if (folder)
+			{
+				setCurrentFolder(folder);
+			}
+
+			m_lastBookmark = 0;
+			m_pendingFolder = 0;
+		}
+	}
 
 	return true;
 }
 
+QString HtmlBookmarksImportJob::decodeEntities(const QString &text)
+{
+	if (!text.contains(QLatin1Char('&')))
+	{
+		return text;
+	}
+
+	QString result;
+	result.reserve(text.length());
+
+	for (int i = 0; i < text.length(); ++i)
+	{
+		const int entityEnd((text.at(i) == QLatin1Char('&')) ? text.indexOf(QLatin1Char(';'), (i + 1)) : -1);
+
+		if (entityEnd < 0 || (entityEnd - i) > 10)
+		{
+			result.append(text.at(i));
+
+			continue;
+		}
+
+		const QString entity(text.mid((i + 1), (entityEnd - i - 1)));
+
+		if (entity.startsWith(QLatin1Char('#')))
+		{
+			bool isValid(false);
+			const uint codePoint((entity.startsWith(QLatin1String("#x"), Qt::CaseInsensitive)) ? entity.mid(2).toUInt(&isValid, 16) : entity.mid(1).toUInt(&isValid));
+
+			if (!isValid || codePoint == 0 || codePoint > 0x10FFFF)
+			{
+				result.append(text.at(i));
+
+				continue;
+			}
+
+			result.append(QString::fromUcs4(&codePoint, 1));
+		}
+		else if (entity == QLatin1String("amp"))
+		{
+			result.append(QLatin1Char('&'));
+		}
+		else if (entity == QLatin1String("lt"))
+		{
+			result.append(QLatin1Char('<'));
+		}
+		else if (entity == QLatin1String("gt"))
+		{
+			result.append(QLatin1Char('>'));
+		}
+		else if (entity == QLatin1String("quot"))
+		{
+			result.append(QLatin1Char('"'));
+		}
+		else if (entity == QLatin1String("apos"))
+		{
+			result.append(QLatin1Char('\''));
+		}
+		else if (entity == QLatin1String("nbsp"))
+		{
+			result.append(QChar(0xA0));
+		}
+		else
+		{
+			result.append(text.at(i));
+
+			continue;
+		}
+
+		i = entityEnd;
+	}
+
+	return result;
+}
+
+QHash<QString, QString> HtmlBookmarksImportJob::parseAttributes(const QString &text)
+{
+	QHash<QString, QString> attributes;
+	int position(0);
+
+	while (position < text.length())
+	{
+		while (position < text.length() && (text.at(position).isSpace() || text.at(position) == QLatin1Char('/')))
+		{
+			++position;
+		}
+
+		const int nameStart(position);
+
+		while (position < text.length() && !text.at(position).isSpace() && text.at(position) != QLatin1Char('=') && text.at(position) != QLatin1Char('/'))
+		{
+			++position;
+		}
+
+		if (position == nameStart)
+		{
+			break;
+		}
+
+		const QString name(text.mid(nameStart, (position - nameStart)).toLower());
+
+		while (position < text.length() && text.at(position).isSpace())
+		{
+			++position;
+		}
+
+		if (position >= text.length() || text.at(position) != QLatin1Char('='))
+		{
+			attributes[name] = QString();
+
+			continue;
+		}
+
+		++position;
+
+		while (position < text.length() && text.at(position).isSpace())
+		{
+			++position;
+		}
+
+		int valueStart(position);
+		int valueEnd(position);
+
+		if (position < text.length() && (text.at(position) == QLatin1Char('"') || text.at(position) == QLatin1Char('\'')))
+		{
+			++valueStart;
+
+			valueEnd = text.indexOf(text.at(position), valueStart);
+
+			if (valueEnd < 0)
+			{
+				valueEnd = text.length();
+			}
+
+			position = (valueEnd + 1);
+		}
+		else
+		{
+			while (valueEnd < text.length() && !text.at(valueEnd).isSpace())
+			{
+				++valueEnd;
+			}
+
+			position = valueEnd;
+		}
+
+		attributes[name] = decodeEntities(text.mid(valueStart, (valueEnd - valueStart)));
+	}
+
+	return attributes;
+}
+
+int HtmlBookmarksImportJob::findTagEnd(const QString &content, int position)
+{
+	QChar quote;
+
+	for (int i = position; i < content.length(); ++i)
+	{
+		const QChar character(content.at(i));
+
+		if (!quote.isNull())
+		{
+			if (character == quote)
+			{
+				quote = QChar();
+			}
+		}
+		else if (character == QLatin1Char('"') || character == QLatin1Char('\''))
+		{
+			quote = character;
+		}
+		else if (character == QLatin1Char('>'))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool HtmlBookmarksImportJob::isRunning() const
+{
+	return m_isRunning;
+}
+
 }
@@ -54,6 +54,43 @@ private:
 	BookmarksImportOptionsWidget *m_optionsWidget;
 };
 
+class HtmlBookmarksImportJob final : public BookmarksImportJob
+{
+	Q_OBJECT
+
+public:
+	explicit HtmlBookmarksImportJob(BookmarksModel::Bookmark *folder, const QString &path, bool areDuplicatesAllowed, QObject *parent = nullptr);
+	bool isRunning() const override;
+
+public slots:
+	void start() override;
+	void cancel() override;
+
+protected:
+	void timerEvent(QTimerEvent *event) override;
+	void finishImport(DataExchanger::OperationResult result);
+	quint64 addBookmark(BookmarksModel::BookmarkType type, const QHash<QString, QString> &attributes, const QString &title);
+	static QString decodeEntities(const QString &text);
+	static QHash<QString, QString> parseAttributes(const QString &text);
+	static int findTagEnd(const QString &content, int position);
+	bool parseContent();
+
+private:
+	QString m_path;
+	QString m_content;
+	QString m_element;
+	QString m_text;
+	QHash<QString, QString> m_attributes;
+	QVector<bool> m_lists;
+	quint64 m_lastBookmark;
+	quint64 m_pendingFolder;
+	int m_position;
+	int m_parseTimer;
+	int m_currentAmount;
+	int m_totalAmount;
+	bool m_isRunning;
+};
+
 }
 
 #endif
@@ -27,18 +27,29 @@
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QFileInfo>
 #include <QtCore/QMimeDatabase>
 #include <QtWidgets/QFileIconProvider>
 
+#include <algorithm>
+
 namespace Otter
 {
 
 AddressCompletionModel::AddressCompletionModel(QObject *parent) : QAbstractListModel(parent),
+	m_suggester(nullptr),
+	m_fileSystemWatcher(nullptr),
+	m_directoryWatcher(nullptr),
 	m_types(NoCompletionType),
 	m_updateTimer(0),
-	m_showCompletionCategories(true)
+	m_suggestionsRow(-1),
+	m_suggestionsAmount(0),
+	m_localPathsRow(-1),
+	m_showCompletionCategories(true),
+	m_isPrivate(false)
 {
 }
 
@@ -64,6 +75,13 @@ void AddressCompletionModel::updateModel()
 	QVector<CompletionEntry> completions;
 	completions.reserve(10);
 
+	QString suggestionsSearchEngine;
+	QString suggestionsQuery;
+
+	m_suggestionsRow = -1;
+	m_suggestionsAmount = 0;
+	m_localPathsRow = -1;
+
 	if (m_types.testFlag(SearchSuggestionsCompletionType))
 	{
 		const QString keyword(m_filter.section(QLatin1Char(' '), 0, 0));
@@ -100,6 +118,16 @@ void AddressCompletionModel::updateModel()
 		completionEntry.keyword = keyword;
 
 		completions.append(completionEntry);
+
+		const QString suggestionsMode(SettingsManager::getOption(SettingsManager::Search_SearchEnginesSuggestionsModeOption).toString());
+
+		if (!text.isEmpty() && (suggestionsMode == QLatin1String("enabled") || (suggestionsMode == QLatin1String("nonPrivateTabsOnly") && !m_isPrivate)))
+		{
+			suggestionsSearchEngine = (searchEngine.isValid() ? searchEngine.identifier : m_defaultSearchEngine.identifier);
+			suggestionsQuery = text;
+
+			m_suggestionsRow = completions.count();
+		}
 	}
 
 	if (m_types.testFlag(BookmarksCompletionType))
@@ -128,30 +156,22 @@ void AddressCompletionModel::updateModel()
 
 	if (m_types.testFlag(LocalPathSuggestionsCompletionType) && (m_filter == QString(QLatin1Char('~')) || m_filter.contains(QDir::separator())))
 	{
-		const QString directory((m_filter == QString(QLatin1Char('~'))) ? QDir::homePath() : m_filter.section(QDir::separator(), 0, -2) + QDir::separator());
-		const QString prefix(m_filter.contains(QDir::separator()) ? m_filter.section(QDir::separator(), -1, -1) : QString());
-		const QList<QFileInfo> entries(QDir(Utils::normalizePath(directory)).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot));
-		const QFileIconProvider iconProvider;
-		const QMimeDatabase mimeDatabase;
-		bool headerWasAdded(!m_showCompletionCategories);
+		m_localPathsDirectory = ((m_filter == QString(QLatin1Char('~'))) ? QDir::homePath() : m_filter.section(QDir::separator(), 0, -2) + QDir::separator());
+		m_localPathsPath = Utils::normalizePath(m_localPathsDirectory);
+		m_localPathsPrefix = (m_filter.contains(QDir::separator()) ? m_filter.section(QDir::separator(), -1, -1) : QString());
 
-		for (int i = 0; i < entries.count(); ++i)
+		if (m_directories.contains(m_localPathsPath))
 		{
-			const QFileInfo entry(entries.at(i));
+			m_directoriesOrder.removeAll(m_localPathsPath);
+			m_directoriesOrder.append(m_localPathsPath);
 
-			if (entry.fileName().startsWith(prefix, Qt::CaseInsensitive))
-			{
-				const QString path(directory + entry.fileName());
-
-				if (!headerWasAdded)
-				{
-					completions.append(CompletionEntry({}, tr("Local files"), {}, {}, {}, CompletionEntry::HeaderType));
-
-					headerWasAdded = true;
-				}
+			completions.append(createLocalPathEntries(m_directories[m_localPathsPath]));
+		}
+		else
+		{
+			m_localPathsRow = completions.count();
 
-				completions.append(CompletionEntry(QUrl::fromLocalFile(QDir::toNativeSeparators(path)), path, path, QIcon::fromTheme(mimeDatabase.mimeTypeForFile(entry, QMimeDatabase::MatchExtension).iconName(), iconProvider.icon(entry)), {}, CompletionEntry::LocalPathType));
-			}
+			listDirectory(m_localPathsPath);
 		}
 	}
 
@@ -219,6 +239,252 @@ void AddressCompletionModel::updateModel()
 	m_completions = completions;
 
 	endResetModel();
+
+	if (m_suggestionsRow >= 0)
+	{
+		if (!m_suggester)
+		{
+			m_suggester = new SearchSuggester(suggestionsSearchEngine, this);
+			m_suggester->setPrivate(m_isPrivate);
+
+			connect(m_suggester, &SearchSuggester::suggestionsChanged, this, &AddressCompletionModel::handleSearchSuggestionsChanged);
+		}
+
+		m_suggester->setSearchEngine(suggestionsSearchEngine);
+		m_suggester->setQuery(suggestionsQuery);
+
+		handleSearchSuggestionsChanged(m_suggester->getSuggestions());
+	}
+}
+
+void AddressCompletionModel::listDirectory(const QString &path)
+{
+	if (m_directoryWatcher)
+	{
+		if (m_directoryWatcher->property("path").toString() == path)
+		{
+			return;
+		}
+
+		m_isDirectoryListingAborted->storeRelaxed(1);
+
+		m_directoryWatcher->disconnect(this);
+		m_directoryWatcher->deleteLater();
+	}
+
+	const QSharedPointer<QAtomicInt> isAborted(new QAtomicInt(0));
+
+	m_isDirectoryListingAborted = isAborted;
+	m_directoryWatcher = new QFutureWatcher<QVector<LocalPathEntry> >(this);
+	m_directoryWatcher->setProperty("path", path);
+	m_directoryWatcher->setFuture(QtConcurrent::run([=]()
+	{
+		const QMimeDatabase mimeDatabase;
+		QVector<LocalPathEntry> entries;
+		QDirIterator iterator(path, (QDir::AllEntries | QDir::NoDotAndDotDot));
+
+		while (iterator.hasNext())
+		{
+			if (isAborted->loadRelaxed() != 0)
+			{
+				break;
+			}
+
+			iterator.next();
+
+			const QFileInfo information(iterator.fileInfo());
+			const QMimeType mimeType(information.isDir() ? mimeDatabase.mimeTypeForName(QLatin1String("inode/directory")) : mimeDatabase.mimeTypeForFile(information, QMimeDatabase::MatchExtension));
+			LocalPathEntry entry;
+			entry.name = information.fileName();
+			entry.mimeType = mimeType.name();
+			entry.iconName = mimeType.iconName();
+			entry.isDirectory = information.isDir();
+
+			entries.append(entry);
+		}
+
+		std::sort(entries.begin(), entries.end(), [&](const LocalPathEntry &first, const LocalPathEntry &second)
+		{
+			return (first.name.compare(second.name, Qt::CaseInsensitive) < 0);
+		});
+
+		return entries;
+	}));
+
+	connect(m_directoryWatcher, &QFutureWatcher<QVector<LocalPathEntry> >::finished, this, &AddressCompletionModel::handleDirectoryListed);
+}
+
+void AddressCompletionModel::handleDirectoryListed()
+{
+	if (!m_directoryWatcher)
+	{
+		return;
+	}
+
+	const QString path(m_directoryWatcher->property("path").toString());
+	const QVector<LocalPathEntry> entries(m_directoryWatcher->result());
+
+	m_directoryWatcher->deleteLater();
+	m_directoryWatcher = nullptr;
+
+	if (!m_fileSystemWatcher)
+	{
+		m_fileSystemWatcher = new QFileSystemWatcher(this);
+
+		connect(m_fileSystemWatcher, &QFileSystemWatcher::directoryChanged, this, &AddressCompletionModel::handleDirectoryChanged);
+	}
+
+	m_directories[path] = entries;
+
+	m_directoriesOrder.removeAll(path);
+	m_directoriesOrder.append(path);
+
+	m_fileSystemWatcher->addPath(path);
+
+	while (m_directoriesOrder.count() > 20)
+	{
+		const QString removedPath(m_directoriesOrder.takeFirst());
+
+		m_directories.remove(removedPath);
+
+		m_fileSystemWatcher->removePath(removedPath);
+	}
+
+	if (m_localPathsRow < 0 || m_localPathsRow > m_completions.count() || path != m_localPathsPath)
+	{
+		return;
+	}
+
+	const QVector<CompletionEntry> completions(createLocalPathEntries(entries));
+
+	if (!completions.isEmpty())
+	{
+		beginInsertRows({}, m_localPathsRow, (m_localPathsRow + completions.count() - 1));
+
+		for (int i = 0; i < completions.count(); ++i)
+		{
+			m_completions.insert((m_localPathsRow + i), completions.at(i));
+		}
+
+		endInsertRows();
+	}
+
+	m_localPathsRow = -1;
+
+	if (!completions.isEmpty())
+	{
+		emit completionReady(m_filter);
+	}
+}
+
+void AddressCompletionModel::handleDirectoryChanged(const QString &path)
+{
+	m_directories.remove(path);
+	m_directoriesOrder.removeAll(path);
+
+	m_fileSystemWatcher->removePath(path);
+
+	if (path == m_localPathsPath && !m_filter.isEmpty() && m_updateTimer == 0)
+	{
+		updateModel();
+	}
+}
+
+void AddressCompletionModel::handleSearchSuggestionsChanged(const QVector<SearchSuggester::SearchSuggestion> &suggestions)
+{
+	if (m_suggestionsRow < 0 || m_suggestionsRow > m_completions.count())
+	{
+		return;
+	}
+
+	if (m_suggestionsAmount > 0)
+	{
+		beginRemoveRows({}, m_suggestionsRow, (m_suggestionsRow + m_suggestionsAmount - 1));
+
+		m_completions.remove(m_suggestionsRow, m_suggestionsAmount);
+
+		endRemoveRows();
+
+		if (m_localPathsRow >= m_suggestionsRow)
+		{
+			m_localPathsRow -= m_suggestionsAmount;
+		}
+
+		m_suggestionsAmount = 0;
+	}
+
+	const CompletionEntry searchEntry(m_completions.at(m_suggestionsRow - 1));
+	QVector<CompletionEntry> completions;
+	completions.reserve(qMin(suggestions.count(), 5));
+
+	for (int i = 0; i < suggestions.count() && completions.count() < 5; ++i)
+	{
+		if (suggestions.at(i).completion.isEmpty() || suggestions.at(i).completion == searchEntry.text)
+		{
+			continue;
+		}
+
+		CompletionEntry completionEntry({}, searchEntry.title, {}, searchEntry.icon, {}, CompletionEntry::SearchSuggestionType);
+		completionEntry.text = suggestions.at(i).completion;
+		completionEntry.keyword = searchEntry.keyword;
+
+		completions.append(completionEntry);
+	}
+
+	if (completions.isEmpty())
+	{
+		return;
+	}
+
+	beginInsertRows({}, m_suggestionsRow, (m_suggestionsRow + completions.count() - 1));
+
+	for (int i = 0; i < completions.count(); ++i)
+	{
+		m_completions.insert((m_suggestionsRow + i), completions.at(i));
+	}
+
+	m_suggestionsAmount = completions.count();
+
+	if (m_localPathsRow >= m_suggestionsRow)
+	{
+		m_localPathsRow += m_suggestionsAmount;
+	}
+
+	endInsertRows();
+}
+
+QVector<AddressCompletionModel::CompletionEntry> AddressCompletionModel::createLocalPathEntries(const QVector<LocalPathEntry> &entries)
+{
+	QVector<CompletionEntry> completions;
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		const LocalPathEntry &entry(entries.at(i));
+
+		if (entry.name.startsWith(m_localPathsPrefix, Qt::CaseInsensitive))
+		{
+			const QString path(m_localPathsDirectory + entry.name);
+
+			if (completions.isEmpty() && m_showCompletionCategories)
+			{
+				completions.append(CompletionEntry({}, tr("Local files"), {}, {}, {}, CompletionEntry::HeaderType));
+			}
+
+			completions.append(CompletionEntry(QUrl::fromLocalFile(QDir::toNativeSeparators(path)), path, path, getLocalPathIcon(entry), {}, CompletionEntry::LocalPathType));
+		}
+	}
+
+	return completions;
+}
+
+QIcon AddressCompletionModel::getLocalPathIcon(const LocalPathEntry &entry)
+{
+	if (!m_icons.contains(entry.mimeType))
+	{
+		m_icons[entry.mimeType] = QIcon::fromTheme(entry.iconName, QFileIconProvider().icon(entry.isDirectory ? QFileIconProvider::Folder : QFileIconProvider::File));
+	}
+
+	return m_icons[entry.mimeType];
 }
 
 void AddressCompletionModel::setFilter(const QString &filter)
@@ -241,6 +507,10 @@ void AddressCompletionModel::setFilter(const QString &filter)
 
 		endResetModel();
 
+		m_suggestionsRow = -1;
+		m_suggestionsAmount = 0;
+		m_localPathsRow = -1;
+
 		emit completionReady({});
 	}
 	else if (m_updateTimer == 0)
@@ -271,6 +541,16 @@ void AddressCompletionModel::setTypes(CompletionTypes types, bool force)
 	updateModel();
 }
 
+void AddressCompletionModel::setPrivate(bool isPrivate)
+{
+	m_isPrivate = isPrivate;
+
+	if (m_suggester)
+	{
+		m_suggester->setPrivate(isPrivate);
+	}
+}
+
 QVariant AddressCompletionModel::data(const QModelIndex &index, int role) const
 {
 	if (index.column() != 0 || !(index.row() >= 0 && index.row() < m_completions.count()))
@@ -23,8 +23,13 @@
 #define OTTER_ADDRESSCOMPLETIONMODEL_H
 
 #include "../../../core/SearchEnginesManager.h"
+#include "../../../core/SearchSuggester.h"
 
 #include <QtCore/QAbstractListModel>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QUrl>
 
 namespace Otter
@@ -95,6 +100,7 @@ public:
 	explicit AddressCompletionModel(QObject *parent = nullptr);
 
 	void setTypes(CompletionTypes types, bool force = false);
+	void setPrivate(bool isPrivate);
 	QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 	Qt::ItemFlags flags(const QModelIndex &index) const override;
@@ -105,16 +111,46 @@ public slots:
 	void setFilter(const QString &filter = {});
 
 protected:
+	struct LocalPathEntry final
+	{
+		QString name;
+		QString mimeType;
+		QString iconName;
+		bool isDirectory = false;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void updateModel();
+	void listDirectory(const QString &path);
+	QVector<CompletionEntry> createLocalPathEntries(const QVector<LocalPathEntry> &entries);
+	QIcon getLocalPathIcon(const LocalPathEntry &entry);
+
+protected slots:
+	void handleSearchSuggestionsChanged(const QVector<SearchSuggester::SearchSuggestion> &suggestions);
+	void handleDirectoryListed();
+	void handleDirectoryChanged(const QString &path);
 
 private:
+	SearchSuggester *m_suggester;
+	QFileSystemWatcher *m_fileSystemWatcher;
+	QFutureWatcher<QVector<LocalPathEntry> > *m_directoryWatcher;
+	QSharedPointer<QAtomicInt> m_isDirectoryListingAborted;
 	QVector<CompletionEntry> m_completions;
+	QHash<QString, QVector<LocalPathEntry> > m_directories;
+	QHash<QString, QIcon> m_icons;
+	QStringList m_directoriesOrder;
 	QString m_filter;
+	QString m_localPathsDirectory;
+	QString m_localPathsPath;
+	QString m_localPathsPrefix;
 	SearchEnginesManager::SearchEngineDefinition m_defaultSearchEngine;
 	AddressCompletionModel::CompletionTypes m_types;
 	int m_updateTimer;
+	int m_suggestionsRow;
+	int m_suggestionsAmount;
+	int m_localPathsRow;
 	bool m_showCompletionCategories;
+	bool m_isPrivate;
 
 signals:
 	void completionReady(const QString &filter);
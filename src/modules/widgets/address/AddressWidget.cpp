@@ -1444,6 +1444,8 @@ void AddressWidget::setWindow(Window *window)
 		connect(this, &AddressWidget::requestedSearch, mainWindow, &MainWindow::search);
 	}
 
+	m_completionModel->setPrivate(SessionsManager::isPrivate() || (mainWindow && mainWindow->isPrivate()) || (window && window->isPrivate()));
+
 	updateEntries({FaviconEntry});
 	setUrl(window ? window->getUrl() : QUrl());
 }
@@ -494,6 +494,7 @@ void SearchWidget::handleOptionChanged(int identifier, const QVariant &value)
 				else if (!m_suggester && suggestionsMode != QLatin1String("disabled"))
 				{
 					m_suggester = new SearchSuggester(m_searchEngine, this);
+					m_suggester->setPrivate(m_isPrivate);
 
 					connect(m_suggester, &SearchSuggester::suggestionsChanged, this, &SearchWidget::showSearchSuggestions);
 				}
@@ -807,6 +808,11 @@ void SearchWidget::setWindow(Window *window)
 
 	m_isPrivate = (SessionsManager::isPrivate() || (mainWindow && mainWindow->isPrivate()) || (window && window->isPrivate()));
 
+	if (m_suggester)
+	{
+		m_suggester->setPrivate(m_isPrivate);
+	}
+
 	updateGeometries();
 }
 
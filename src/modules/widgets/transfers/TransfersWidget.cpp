@@ -250,6 +250,7 @@ void TransferActionWidget::updateState()
 	QVector<QPair<QString, QString> > detailsValues({{tr("From:"), Utils::extractHost(m_transfer->getSource())}});
 	const bool isIndeterminate(m_transfer->getBytesTotal() <= 0);
 	const bool hasError(m_transfer->getState() == Transfer::UnknownState || m_transfer->getState() == Transfer::ErrorState);
+	const bool isQueued(m_transfer->getState() == Transfer::QueuedState);
 
 	if (m_transfer->getState() == Transfer::FinishedState)
 	{
@@ -276,9 +277,9 @@ void TransferActionWidget::updateState()
 	m_detailsLabel->setText(QLatin1String("<small>") + details + QLatin1String("</small>"));
 	m_iconLabel->setPixmap(m_transfer->getIcon().pixmap(32, 32));
 	m_progressBar->setHasError(hasError);
-	m_progressBar->setRange(0, ((isIndeterminate && !hasError) ? 0 : 100));
-	m_progressBar->setValue(isIndeterminate ? (hasError ? 0 : -1) : ((m_transfer->getBytesTotal() > 0) ? qFloor(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal())) : -1));
-	m_progressBar->setFormat(isIndeterminate ? tr("Unknown") : QLatin1String("%p%"));
+	m_progressBar->setRange(0, ((isIndeterminate && !hasError && !isQueued) ? 0 : 100));
+	m_progressBar->setValue(isIndeterminate ? ((hasError || isQueued) ? 0 : -1) : ((m_transfer->getBytesTotal() > 0) ? qFloor(Utils::calculatePercent(m_transfer->getBytesReceived(), m_transfer->getBytesTotal())) : -1));
+	m_progressBar->setFormat(isQueued ? tr("Queued") : (isIndeterminate ? tr("Unknown") : QLatin1String("%p%")));
 
 	switch (m_transfer->getState())
 	{
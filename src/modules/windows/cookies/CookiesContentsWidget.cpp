@@ -38,8 +38,9 @@ namespace Otter
 {
 
 CookiesContentsWidget::CookiesContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent) : ContentsWidget(parameters, window, parent),
-	m_model(new QStandardItemModel(this)),
+	m_model(new CookiesModel(this)),
 	m_cookieJar(NetworkManagerFactory::getCookieJar()),
+	m_updateTimer(0),
 	m_isLoading(true),
 	m_ui(new Ui::CookiesContentsWidget)
 {
@@ -54,7 +55,15 @@ CookiesContentsWidget::CookiesContentsWidget(const QVariantMap &parameters, Wind
 
 	QTimer::singleShot(100, this, &CookiesContentsWidget::populateCookies);
 
-	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, m_ui->cookiesViewWidget, &ItemViewWidget::setFilterString);
+	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, this, [&](const QString &text)
+	{
+		if (!text.isEmpty())
+		{
+			m_model->fetchAll();
+		}
+
+		m_ui->cookiesViewWidget->setFilterString(text);
+	});
 	connect(m_ui->cookiesViewWidget, &ItemViewWidget::customContextMenuRequested, this, &CookiesContentsWidget::showContextMenu);
 	connect(m_ui->propertiesButton, &QPushButton::clicked, this, &CookiesContentsWidget::cookieProperties);
 	connect(m_ui->deleteButton, &QPushButton::clicked, this, &CookiesContentsWidget::removeCookies);
@@ -66,6 +75,22 @@ CookiesContentsWidget::~CookiesContentsWidget()
 	delete m_ui;
 }
 
+void CookiesContentsWidget::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_updateTimer)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+
+		applyCookieChanges();
+	}
+	else
+	{
+		ContentsWidget::timerEvent(event);
+	}
+}
+
 void CookiesContentsWidget::changeEvent(QEvent *event)
 {
 	ContentsWidget::changeEvent(event);
@@ -78,14 +103,7 @@ void CookiesContentsWidget::changeEvent(QEvent *event)
 
 void CookiesContentsWidget::populateCookies()
 {
-	const QVector<QNetworkCookie> cookies(m_cookieJar->getCookies());
-
-	for (int i = 0; i < cookies.count(); ++i)
-	{
-		handleCookieAdded(cookies.at(i));
-	}
-
-	m_model->sort(0);
+	m_model->setCookies(m_cookieJar->getCookies());
 
 	m_ui->cookiesViewWidget->setViewMode(ItemViewWidget::TreeView);
 	m_ui->cookiesViewWidget->setModel(m_model);
@@ -141,10 +159,7 @@ void CookiesContentsWidget::removeCookies()
 				continue;
 			}
 
-			for (int j = 0; j < domainItem->rowCount(); ++j)
-			{
-				cookies.append(getCookie(ItemModel::getItemData(domainItem->child(j, 0), CookieRole)));
-			}
+			cookies += m_model->getCookies(domainItem);
 		}
 		else
 		{
@@ -152,7 +167,7 @@ void CookiesContentsWidget::removeCookies()
 
 			if (cookieItem)
 			{
-				cookies.append(getCookie(cookieItem->index().data(CookieRole)));
+				cookies.append(CookiesModel::getCookie(cookieItem->index().data(CookieRole)));
 			}
 		}
 	}
@@ -178,16 +193,18 @@ void CookiesContentsWidget::removeDomainCookies()
 	for (int i = 0; i < indexes.count(); ++i)
 	{
 		const QModelIndex index(indexes.at(i));
-		const QStandardItem *domainItem((index.isValid() && index.parent() == m_model->invisibleRootItem()->index()) ? findDomainItem(index.sibling(index.row(), 0).data(Qt::ToolTipRole).toString()) : m_model->itemFromIndex(index.parent()));
+		const QStandardItem *domainItem((index.isValid() && index.parent() == m_model->invisibleRootItem()->index()) ? m_model->getDomainItem(index.sibling(index.row(), 0).data(Qt::ToolTipRole).toString()) : m_model->itemFromIndex(index.parent()));
 
 		if (!domainItem)
 		{
 			continue;
 		}
 
-		for (int j = 0; j < domainItem->rowCount(); ++j)
+		const QVector<QNetworkCookie> domainCookies(m_model->getCookies(domainItem));
+
+		for (int j = 0; j < domainCookies.count(); ++j)
 		{
-			const QNetworkCookie cookie(getCookie(ItemModel::getItemData(domainItem->child(j, 0), CookieRole)));
+			const QNetworkCookie cookie(domainCookies.at(j));
 
 			if (!cookies.contains(cookie))
 			{
@@ -238,7 +255,7 @@ void CookiesContentsWidget::removeAllCookies()
 
 void CookiesContentsWidget::cookieProperties()
 {
-	CookiePropertiesDialog dialog(getCookie(m_ui->cookiesViewWidget->currentIndex().data(CookieRole)), this);
+	CookiePropertiesDialog dialog(CookiesModel::getCookie(m_ui->cookiesViewWidget->currentIndex().data(CookieRole)), this);
 
 	if (dialog.exec() == QDialog::Accepted && dialog.isModified())
 	{
@@ -247,93 +264,75 @@ void CookiesContentsWidget::cookieProperties()
 	}
 }
 
-void CookiesContentsWidget::handleCookieAdded(const QNetworkCookie &cookie)
+void CookiesContentsWidget::applyCookieChanges()
 {
-	const QString domain(getCookieDomain(cookie));
-	QStandardItem *domainItem(findDomainItem(domain));
+	const QVector<CookieChange> changes(m_cookieChanges);
+	QPoint point;
+	bool needsSorting(false);
+
+	m_cookieChanges.clear();
 
-	if (domainItem)
+	for (int i = 0; i < changes.count(); ++i)
 	{
-		for (int i = 0; i < domainItem->rowCount(); ++i)
+		const CookieChange &change(changes.at(i));
+
+		if (change.isRemoval)
 		{
-			QStandardItem *childItem(domainItem->child(i, 0));
+			const QModelIndex index(m_model->getCookieIndex(change.cookie));
 
-			if (childItem && cookie.hasSameIdentifier(getCookie(childItem->index().data(CookieRole))))
+			if (index.isValid())
 			{
-				childItem->setData(cookie.toRawForm(), CookieRole);
-
-				updateActions();
-
-				return;
+				point = m_ui->cookiesViewWidget->visualRect(index).center();
 			}
-		}
-	}
-	else
-	{
-		domainItem = new QStandardItem(HistoryManager::getIcon(QUrl(QStringLiteral("http://%1/").arg(domain))), domain);
-		domainItem->setToolTip(domain);
-
-		m_model->appendRow(domainItem);
 
-		if (sender())
+			m_model->removeCookie(change.cookie);
+		}
+		else if (m_model->addCookie(change.cookie))
 		{
-			m_model->sort(0);
+			needsSorting = true;
 		}
 	}
 
-	QStandardItem *cookieItem(new QStandardItem(QString::fromLatin1(cookie.name())));
-	cookieItem->setData(cookie.toRawForm(), CookieRole);
-	cookieItem->setToolTip(QString::fromLatin1(cookie.name()));
-	cookieItem->setFlags(cookieItem->flags() | Qt::ItemNeverHasChildren);
-
-	domainItem->appendRow(cookieItem);
-	domainItem->setText(QStringLiteral("%1 (%2)").arg(domain).arg(domainItem->rowCount()));
-}
-
-void CookiesContentsWidget::handleCookieRemoved(const QNetworkCookie &cookie)
-{
-	const QString domain(getCookieDomain(cookie));
-	QStandardItem *domainItem(findDomainItem(domain));
-
-	if (!domainItem)
+	if (needsSorting)
 	{
-		return;
+		m_model->sort(0);
 	}
 
-	QPoint point;
-
-	for (int i = 0; i < domainItem->rowCount(); ++i)
+	if (!point.isNull())
 	{
-		if (cookie.hasSameIdentifier(getCookie(ItemModel::getItemData(domainItem->child(i, 0), CookieRole))))
-		{
-			const QStandardItem *cookieItem(domainItem->child(i, 0));
+		const QModelIndex index(m_ui->cookiesViewWidget->indexAt(point));
 
-			if (cookieItem)
-			{
-				point = m_ui->cookiesViewWidget->visualRect(cookieItem->index()).center();
-			}
+		m_ui->cookiesViewWidget->setCurrentIndex(index);
+		m_ui->cookiesViewWidget->selectionModel()->select(index, QItemSelectionModel::Select);
+	}
 
-			domainItem->removeRow(i);
+	updateActions();
+}
 
-			break;
-		}
-	}
+void CookiesContentsWidget::handleCookieAdded(const QNetworkCookie &cookie)
+{
+	CookieChange change;
+	change.cookie = cookie;
 
-	if (domainItem->rowCount() == 0)
-	{
-		m_model->invisibleRootItem()->removeRow(domainItem->row());
-	}
-	else
+	m_cookieChanges.append(change);
+
+	if (m_updateTimer == 0)
 	{
-		domainItem->setText(QStringLiteral("%1 (%2)").arg(domain).arg(domainItem->rowCount()));
+		m_updateTimer = startTimer(100);
 	}
+}
 
-	if (!point.isNull())
-	{
-		const QModelIndex index(m_ui->cookiesViewWidget->indexAt(point));
+void CookiesContentsWidget::handleCookieRemoved(const QNetworkCookie &cookie)
+{
+	CookieChange change;
+	change.cookie = cookie;
+	change.isRemoval = true;
 
-		m_ui->cookiesViewWidget->setCurrentIndex(index);
-		m_ui->cookiesViewWidget->selectionModel()->select(index, QItemSelectionModel::Select);
+	m_cookieChanges.append(change);
+
+	if (m_updateTimer == 0)
+	{
+		m_updateTimer = startTimer(100);
 	}
 }
 
@@ -415,7 +414,7 @@ void CookiesContentsWidget::updateActions()
 
 	if (indexes.count() == 1)
 	{
-		const QNetworkCookie cookie(getCookie(indexes.value(0).data(CookieRole)));
+		const QNetworkCookie cookie(CookiesModel::getCookie(indexes.value(0).data(CookieRole)));
 
 		if (!cookie.name().isEmpty())
 		{
@@ -431,26 +430,6 @@ void CookiesContentsWidget::updateActions()
 	emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::EditingCategory});
 }
 
-QStandardItem* CookiesContentsWidget::findDomainItem(const QString &domain)
-{
-	for (int i = 0; i < m_model->rowCount(); ++i)
-	{
-		QStandardItem *item(m_model->item(i, 0));
-
-		if (item && domain == item->toolTip())
-		{
-			return item;
-		}
-	}
-
-	return nullptr;
-}
-
-QString CookiesContentsWidget::getCookieDomain(const QNetworkCookie &cookie) const
-{
-	return QString(cookie.domain().startsWith(QLatin1Char('.')) ? cookie.domain().mid(1) : cookie.domain());
-}
-
 QString CookiesContentsWidget::getTitle() const
 {
 	return tr("Cookies");
@@ -471,13 +450,6 @@ QIcon CookiesContentsWidget::getIcon() const
 	return ThemesManager::createIcon(QLatin1String("cookies"), false);
 }
 
-QNetworkCookie CookiesContentsWidget::getCookie(const QVariant &data) const
-{
-	const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(data.toByteArray()));
-
-	return (cookies.isEmpty() ? QNetworkCookie() : cookies.value(0));
-}
-
 ActionsManager::ActionDefinition::State CookiesContentsWidget::getActionState(int identifier, const QVariantMap &parameters) const
 {
 	ActionsManager::ActionDefinition::State state(ActionsManager::getActionDefinition(identifier).getDefaultState());
@@ -517,4 +489,302 @@ bool CookiesContentsWidget::eventFilter(QObject *object, QEvent *event)
 	return ContentsWidget::eventFilter(object, event);
 }
 
+CookiesModel::CookiesModel(QObject *parent) : QStandardItemModel(parent)
+{
+}
+
+void CookiesModel::setCookies(const QVector<QNetworkCookie> &cookies)
+{
+	clear();
+
+	m_domains.clear();
+	m_pendingCookies.clear();
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		const QNetworkCookie cookie(cookies.at(i));
+
+		m_pendingCookies[getCookieDomain(cookie)].append(cookie);
+	}
+
+	QList<QStandardItem*> domainItems;
+	domainItems.reserve(m_pendingCookies.count());
+
+	QHash<QString, QVector<QNetworkCookie> >::const_iterator iterator;
+
+	for (iterator = m_pendingCookies.constBegin(); iterator != m_pendingCookies.constEnd(); ++iterator)
+	{
+		QStandardItem *domainItem(createDomainItem(iterator.key()));
+
+		updateDomainItem(domainItem);
+
+		domainItems.append(domainItem);
+	}
+
+	invisibleRootItem()->appendRows(domainItems);
+
+	sort(0);
+}
+
+bool CookiesModel::addCookie(const QNetworkCookie &cookie)
+{
+	const QString domain(getCookieDomain(cookie));
+	QStandardItem *domainItem(m_domains.value(domain));
+
+	if (!domainItem)
+	{
+		domainItem = createDomainItem(domain);
+		domainItem->appendRow(createCookieItem(cookie));
+
+		updateDomainItem(domainItem);
+
+		appendRow(domainItem);
+
+		return true;
+	}
+
+	if (m_pendingCookies.contains(domain))
+	{
+		QVector<QNetworkCookie> &cookies(m_pendingCookies[domain]);
+
+		for (int i = 0; i < cookies.count(); ++i)
+		{
+			if (cookie.hasSameIdentifier(cookies.at(i)))
+			{
+				cookies[i] = cookie;
+
+				return false;
+			}
+		}
+
+		cookies.append(cookie);
+	}
+	else
+	{
+		for (int i = 0; i < domainItem->rowCount(); ++i)
+		{
+			QStandardItem *cookieItem(domainItem->child(i, 0));
+
+			if (cookieItem && cookie.hasSameIdentifier(getCookie(cookieItem->data(CookiesContentsWidget::CookieRole))))
+			{
+				cookieItem->setData(cookie.toRawForm(), CookiesContentsWidget::CookieRole);
+
+				return false;
+			}
+		}
+
+		domainItem->appendRow(createCookieItem(cookie));
+	}
+
+	updateDomainItem(domainItem);
+
+	return false;
+}
+
+void CookiesModel::removeCookie(const QNetworkCookie &cookie)
+{
+	const QString domain(getCookieDomain(cookie));
+	QStandardItem *domainItem(m_domains.value(domain));
+
+	if (!domainItem)
+	{
+		return;
+	}
+
+	bool isEmpty(false);
+
+	if (m_pendingCookies.contains(domain))
+	{
+		QVector<QNetworkCookie> &cookies(m_pendingCookies[domain]);
+
+		for (int i = 0; i < cookies.count(); ++i)
+		{
+			if (cookie.hasSameIdentifier(cookies.at(i)))
+			{
+				cookies.removeAt(i);
+
+				break;
+			}
+		}
+
+		isEmpty = cookies.isEmpty();
+	}
+	else
+	{
+		for (int i = 0; i < domainItem->rowCount(); ++i)
+		{
+			if (cookie.hasSameIdentifier(getCookie(ItemModel::getItemData(domainItem->child(i, 0), CookiesContentsWidget::CookieRole))))
+			{
+				domainItem->removeRow(i);
+
+				break;
+			}
+		}
+
+		isEmpty = (domainItem->rowCount() == 0);
+	}
+
+	if (isEmpty)
+	{
+		m_domains.remove(domain);
+		m_pendingCookies.remove(domain);
+
+		invisibleRootItem()->removeRow(domainItem->row());
+	}
+	else
+	{
+		updateDomainItem(domainItem);
+	}
+}
+
+void CookiesModel::fetchAll()
+{
+	const QStringList domains(m_pendingCookies.keys());
+
+	for (int i = 0; i < domains.count(); ++i)
+	{
+		const QStandardItem *domainItem(m_domains.value(domains.at(i)));
+
+		if (domainItem)
+		{
+			fetchMore(domainItem->index());
+		}
+	}
+}
+
+void CookiesModel::fetchMore(const QModelIndex &parent)
+{
+	const QString domain(getDomain(parent));
+	QStandardItem *domainItem(m_domains.value(domain));
+
+	if (!domainItem || !m_pendingCookies.contains(domain))
+	{
+		return;
+	}
+
+	const QVector<QNetworkCookie> cookies(m_pendingCookies.take(domain));
+	QList<QStandardItem*> cookieItems;
+	cookieItems.reserve(cookies.count());
+
+	for (int i = 0; i < cookies.count(); ++i)
+	{
+		cookieItems.append(createCookieItem(cookies.at(i)));
+	}
+
+	domainItem->appendRows(cookieItems);
+	domainItem->sortChildren(0);
+}
+
+void CookiesModel::updateDomainItem(QStandardItem *domainItem)
+{
+	const QString domain(domainItem->toolTip());
+
+	domainItem->setText(QStringLiteral("%1 (%2)").arg(domain).arg(m_pendingCookies.contains(domain) ? m_pendingCookies[domain].count() : domainItem->rowCount()));
+}
+
+QStandardItem* CookiesModel::createDomainItem(const QString &domain)
+{
+	QStandardItem *domainItem(new QStandardItem(HistoryManager::getIcon(QUrl(QStringLiteral("http://%1/").arg(domain))), domain));
+	domainItem->setToolTip(domain);
+
+	m_domains[domain] = domainItem;
+
+	return domainItem;
+}
+
+QStandardItem* CookiesModel::createCookieItem(const QNetworkCookie &cookie) const
+{
+	QStandardItem *cookieItem(new QStandardItem(QString::fromLatin1(cookie.name())));
+	cookieItem->setData(cookie.toRawForm(), CookiesContentsWidget::CookieRole);
+	cookieItem->setToolTip(QString::fromLatin1(cookie.name()));
+	cookieItem->setFlags(cookieItem->flags() | Qt::ItemNeverHasChildren);
+
+	return cookieItem;
+}
+
+QStandardItem* CookiesModel::getDomainItem(const QString &domain) const
+{
+	return m_domains.value(domain);
+}
+
+QModelIndex CookiesModel::getCookieIndex(const QNetworkCookie &cookie) const
+{
+	const QString domain(getCookieDomain(cookie));
+	const QStandardItem *domainItem(m_domains.value(domain));
+
+	if (!domainItem || m_pendingCookies.contains(domain))
+	{
+		return {};
+	}
+
+	for (int i = 0; i < domainItem->rowCount(); ++i)
+	{
+		const QStandardItem *cookieItem(domainItem->child(i, 0));
+
+		if (cookieItem && cookie.hasSameIdentifier(getCookie(cookieItem->data(CookiesContentsWidget::CookieRole))))
+		{
+			return cookieItem->index();
+		}
+	}
+
+	return {};
+}
+
+QString CookiesModel::getDomain(const QModelIndex &index) const
+{
+	if (!index.isValid() || index.parent().isValid())
+	{
+		return {};
+	}
+
+	return index.sibling(index.row(), 0).data(Qt::ToolTipRole).toString();
+}
+
+QString CookiesModel::getCookieDomain(const QNetworkCookie &cookie)
+{
+	return QString(cookie.domain().startsWith(QLatin1Char('.')) ? cookie.domain().mid(1) : cookie.domain());
+}
+
+QNetworkCookie CookiesModel::getCookie(const QVariant &data)
+{
+	const QList<QNetworkCookie> cookies(QNetworkCookie::parseCookies(data.toByteArray()));
+
+	return (cookies.isEmpty() ? QNetworkCookie() : cookies.value(0));
+}
+
+QVector<QNetworkCookie> CookiesModel::getCookies(const QStandardItem *domainItem) const
+{
+	if (!domainItem)
+	{
+		return {};
+	}
+
+	const QString domain(domainItem->toolTip());
+
+	if (m_pendingCookies.contains(domain))
+	{
+		return m_pendingCookies.value(domain);
+	}
+
+	QVector<QNetworkCookie> cookies;
+	cookies.reserve(domainItem->rowCount());
+
+	for (int i = 0; i < domainItem->rowCount(); ++i)
+	{
+		cookies.append(getCookie(ItemModel::getItemData(domainItem->child(i, 0), CookiesContentsWidget::CookieRole)));
+	}
+
+	return cookies;
+}
+
+bool CookiesModel::canFetchMore(const QModelIndex &parent) const
+{
+	return m_pendingCookies.contains(getDomain(parent));
+}
+
+bool CookiesModel::hasChildren(const QModelIndex &parent) const
+{
+	return (canFetchMore(parent) || QStandardItemModel::hasChildren(parent));
+}
+
 }
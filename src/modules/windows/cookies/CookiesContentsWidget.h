@@ -33,6 +33,7 @@ namespace Ui
 	class CookiesContentsWidget;
 }
 
+class CookiesModel;
 class Window;
 
 class CookiesContentsWidget final : public ContentsWidget
@@ -61,10 +62,15 @@ public slots:
 	void triggerAction(int identifier, const QVariantMap &parameters = {}, ActionsManager::TriggerType trigger = ActionsManager::UnknownTrigger) override;
 
 protected:
+	struct CookieChange final
+	{
+		QNetworkCookie cookie;
+		bool isRemoval = false;
+	};
+
+	void timerEvent(QTimerEvent *event) override;
 	void changeEvent(QEvent *event) override;
-	QStandardItem* findDomainItem(const QString &domain);
-	QString getCookieDomain(const QNetworkCookie &cookie) const;
-	QNetworkCookie getCookie(const QVariant &data) const;
+	void applyCookieChanges();
 
 protected slots:
 	void populateCookies();
@@ -79,12 +85,45 @@ protected slots:
 	void updateActions();
 
 private:
-	QStandardItemModel *m_model;
+	CookiesModel *m_model;
 	CookieJar *m_cookieJar;
+	QVector<CookieChange> m_cookieChanges;
+	int m_updateTimer;
 	bool m_isLoading;
 	Ui::CookiesContentsWidget *m_ui;
 };
 
+class CookiesModel final : public QStandardItemModel
+{
+	Q_OBJECT
+
+public:
+	explicit CookiesModel(QObject *parent = nullptr);
+
+	void setCookies(const QVector<QNetworkCookie> &cookies);
+	bool addCookie(const QNetworkCookie &cookie);
+	void removeCookie(const QNetworkCookie &cookie);
+	void fetchAll();
+	void fetchMore(const QModelIndex &parent) override;
+	QStandardItem* getDomainItem(const QString &domain) const;
+	QModelIndex getCookieIndex(const QNetworkCookie &cookie) const;
+	QVector<QNetworkCookie> getCookies(const QStandardItem *domainItem) const;
+	static QString getCookieDomain(const QNetworkCookie &cookie);
+	static QNetworkCookie getCookie(const QVariant &data);
+	bool canFetchMore(const QModelIndex &parent) const override;
+	bool hasChildren(const QModelIndex &parent = {}) const override;
+
+protected:
+	QStandardItem* createDomainItem(const QString &domain);
+	QStandardItem* createCookieItem(const QNetworkCookie &cookie) const;
+	void updateDomainItem(QStandardItem *domainItem);
+	QString getDomain(const QModelIndex &index) const;
+
+private:
+	QHash<QString, QStandardItem*> m_domains;
+	QHash<QString, QVector<QNetworkCookie> > m_pendingCookies;
+};
+
 }
 
 #endif
@@ -18,7 +18,9 @@
 **************************************************************************/
 
 #include "HistoryContentsWidget.h"
+#include "HistoryProxyModel.h"
 #include "../../../core/Application.h"
+#include "../../../core/HistoryManager.h"
 #include "../../../core/ThemesManager.h"
 #include "../../../core/Utils.h"
 #include "../../../ui/Action.h"
@@ -35,45 +37,45 @@ namespace Otter
 {
 
 HistoryContentsWidget::HistoryContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent) : ContentsWidget(parameters, window, parent),
-	m_model(new QStandardItemModel(this)),
+	m_model(new HistoryProxyModel(HistoryManager::getBrowsingHistoryModel(), this)),
 	m_isLoading(true),
 	m_ui(new Ui::HistoryContentsWidget)
 {
 	m_ui->setupUi(this);
 	m_ui->filterLineEditWidget->setClearOnEscape(true);
 
-	const QStringList groups({tr("Today"), tr("Yesterday"), tr("Earlier This Week"), tr("Previous Week"), tr("Earlier This Month"), tr("Earlier This Year"), tr("Older")});
-	const QIcon icon(ThemesManager::createIcon(QLatin1String("inode-directory")));
-
-	for (int i = 0; i < groups.count(); ++i)
-	{
-		m_model->appendRow(new QStandardItem(icon, groups.at(i)));
-	}
-
-	m_model->setHorizontalHeaderLabels({tr("Address"), tr("Title"), tr("Date")});
 	m_model->setHeaderData(0, Qt::Horizontal, 300, HeaderViewWidget::WidthRole);
 	m_model->setHeaderData(1, Qt::Horizontal, 300, HeaderViewWidget::WidthRole);
-	m_model->setSortRole(Qt::DisplayRole);
 
 	m_ui->historyViewWidget->setViewMode(ItemViewWidget::TreeView);
 	m_ui->historyViewWidget->setModel(m_model, true);
-	m_ui->historyViewWidget->setSortRoleMapping({{2, TimeVisitedRole}});
+	m_ui->historyViewWidget->setSortRoleMapping({{2, HistoryProxyModel::TimeVisitedRole}});
 	m_ui->historyViewWidget->installEventFilter(this);
 	m_ui->historyViewWidget->viewport()->installEventFilter(this);
 
-	for (int i = 0; i < m_model->rowCount(); ++i)
+	updateGroups();
+
+	QTimer::singleShot(0, this, &HistoryContentsWidget::populateEntries);
+
+	connect(HistoryManager::getInstance(), &HistoryManager::dayChanged, m_model, &HistoryProxyModel::reloadModel);
+	connect(m_model, &HistoryProxyModel::modelReset, this, &HistoryContentsWidget::populateEntries);
+	connect(m_model, &HistoryProxyModel::rowsInserted, this, &HistoryContentsWidget::handleEntriesInserted);
+	connect(m_model, &HistoryProxyModel::rowsRemoved, this, &HistoryContentsWidget::updateGroups);
+	connect(m_model, &HistoryProxyModel::dataChanged, this, &HistoryContentsWidget::updateGroups);
+	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, this, [&](const QString &text)
 	{
-		m_ui->historyViewWidget->setRowHidden(i, m_model->invisibleRootItem()->index(), true);
-	}
+		if (!text.isEmpty())
+		{
+			m_model->fetchAll();
+		}
 
-	QTimer::singleShot(100, this, &HistoryContentsWidget::populateEntries);
+		m_ui->historyViewWidget->setFilterString(text);
 
-	connect(HistoryManager::getBrowsingHistoryModel(), &HistoryModel::cleared, this, &HistoryContentsWidget::populateEntries);
-	connect(HistoryManager::getBrowsingHistoryModel(), &HistoryModel::entryAdded, this, &HistoryContentsWidget::handleEntryAdded);
-	connect(HistoryManager::getBrowsingHistoryModel(), &HistoryModel::entryModified, this, &HistoryContentsWidget::handleEntryModified);
-	connect(HistoryManager::getBrowsingHistoryModel(), &HistoryModel::entryRemoved, this, &HistoryContentsWidget::handleEntryRemoved);
-	connect(HistoryManager::getInstance(), &HistoryManager::dayChanged, this, &HistoryContentsWidget::populateEntries);
-	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, m_ui->historyViewWidget, &ItemViewWidget::setFilterString);
+		if (text.isEmpty())
+		{
+			updateGroups();
+		}
+	});
 	connect(m_ui->historyViewWidget, &ItemViewWidget::doubleClicked, this, &HistoryContentsWidget::openEntry);
 	connect(m_ui->historyViewWidget, &ItemViewWidget::customContextMenuRequested, this, &HistoryContentsWidget::showContextMenu);
 }
@@ -90,15 +92,8 @@ void HistoryContentsWidget::changeEvent(QEvent *event)
 	if (event->type() == QEvent::LanguageChange)
 	{
 		m_ui->retranslateUi(this);
-
-		const QStringList groups({tr("Today"), tr("Yesterday"), tr("Earlier This Week"), tr("Previous Week"), tr("Earlier This Month"), tr("Earlier This Year"), tr("Older")});
-
-		for (int i = 0; i < groups.count(); ++i)
-		{
-			m_model->setData(m_model->index(i, 0), groups.at(i), Qt::DisplayRole);
-		}
-
-		m_model->setHorizontalHeaderLabels({tr("Address"), tr("Title"), tr("Date")});
+		m_ui->historyViewWidget->header()->viewport()->update();
+		m_ui->historyViewWidget->viewport()->update();
 	}
 }
 
@@ -129,51 +124,37 @@ void HistoryContentsWidget::print(QPrinter *printer)
 
 void HistoryContentsWidget::populateEntries()
 {
-	const QDate date(QDate::currentDate());
-	const QVector<QDate> dates({date, date.addDays(-1), date.addDays(-7), date.addDays(-14), date.addDays(-30), date.addDays(-365)});
+	updateGroups();
+	expandBranches();
 
-	for (int i = 0; i < m_model->rowCount(); ++i)
-	{
-		QStandardItem *groupItem(m_model->item(i, 0));
+	m_isLoading = false;
 
-		if (groupItem)
-		{
-			groupItem->setData(dates.value(i, QDate()), GroupDateRole);
-			groupItem->removeRows(0, groupItem->rowCount());
-		}
-	}
+	emit loadingStateChanged(WebWidget::FinishedLoadingState);
+}
 
-	const HistoryModel *model(HistoryManager::getBrowsingHistoryModel());
+void HistoryContentsWidget::expandBranches()
+{
+	const QString mode(SettingsManager::getOption(SettingsManager::History_ExpandBranchesOption).toString());
 
-	for (int i = 0; i < model->rowCount(); ++i)
+	if (mode != QLatin1String("first") && mode != QLatin1String("all"))
 	{
-		handleEntryAdded(static_cast<HistoryModel::Entry*>(model->item(i, 0)));
+		return;
 	}
 
-	const QString expandBranches(SettingsManager::getOption(SettingsManager::History_ExpandBranchesOption).toString());
-
-	if (expandBranches == QLatin1String("first"))
+	for (int i = 0; i < m_model->rowCount(); ++i)
 	{
-		for (int i = 0; i < m_model->rowCount(); ++i)
+		const QModelIndex index(m_model->index(i, 0));
+
+		if (m_model->hasChildren(index))
 		{
-			const QModelIndex index(m_model->index(i, 0));
+			m_ui->historyViewWidget->expand(m_ui->historyViewWidget->getProxyModel()->mapFromSource(index));
 
-			if (m_model->rowCount(index) > 0)
+			if (mode == QLatin1String("first"))
 			{
-				m_ui->historyViewWidget->expand(m_ui->historyViewWidget->getProxyModel()->mapFromSource(index));
-
 				break;
 			}
 		}
 	}
-	else if (expandBranches == QLatin1String("all"))
-	{
-		m_ui->historyViewWidget->expandAll();
-	}
-
-	m_isLoading = false;
-
-	emit loadingStateChanged(WebWidget::FinishedLoadingState);
 }
 
 void HistoryContentsWidget::removeEntry()
@@ -188,33 +169,24 @@ void HistoryContentsWidget::removeEntry()
 
 void HistoryContentsWidget::removeDomainEntries()
 {
-	const QStandardItem *domainItem(findEntry(getEntry(m_ui->historyViewWidget->currentIndex())));
+	const HistoryModel::Entry *domainEntry(HistoryManager::getEntry(getEntry(m_ui->historyViewWidget->currentIndex())));
 
-	if (!domainItem)
+	if (!domainEntry)
 	{
 		return;
 	}
 
-	const QString host(QUrl(domainItem->text()).host());
+	const QString host(domainEntry->getUrl().host());
+	const HistoryModel *model(HistoryManager::getBrowsingHistoryModel());
 	QVector<quint64> entries;
 
-	for (int i = 0; i < m_model->rowCount(); ++i)
+	for (int i = (model->rowCount() - 1); i >= 0; --i)
 	{
-		const QStandardItem *groupItem(m_model->item(i, 0));
+		const HistoryModel::Entry *entry(static_cast<HistoryModel::Entry*>(model->item(i, 0)));
 
-		if (!groupItem)
+		if (entry && host == entry->getUrl().host())
 		{
-			continue;
-		}
-
-		for (int j = (groupItem->rowCount() - 1); j >= 0; --j)
-		{
-			const QStandardItem *entryItem(groupItem->child(j, 0));
-
-			if (entryItem && host == QUrl(entryItem->text()).host())
-			{
-				entries.append(entryItem->data(IdentifierRole).toULongLong());
-			}
+			entries.append(entry->getIdentifier());
 		}
 	}
 
@@ -225,7 +197,7 @@ void HistoryContentsWidget::openEntry()
 {
 	const QModelIndex index(m_ui->historyViewWidget->currentIndex());
 
-	if (!index.isValid() || index.parent() == m_model->invisibleRootItem()->index())
+	if (!index.isValid() || !index.parent().isValid())
 	{
 		return;
 	}
@@ -244,110 +216,34 @@ void HistoryContentsWidget::openEntry()
 	}
 }
 
-void HistoryContentsWidget::handleEntryAdded(HistoryModel::Entry *entry)
+void HistoryContentsWidget::updateGroups()
 {
-	if (!entry || !entry->isValid() || findEntry(entry->getIdentifier()))
-	{
-		return;
-	}
-
-	QStandardItem *groupItem(nullptr);
-
-	for (int i = 0; i < m_model->rowCount(); ++i)
-	{
-		groupItem = m_model->item(i, 0);
-
-		const QDate date(groupItem ? groupItem->data(GroupDateRole).toDate() : QDate());
-
-		if (!date.isValid() || entry->getTimeVisited().date() >= date)
-		{
-			break;
-		}
-
-		groupItem = nullptr;
-	}
-
-	if (!groupItem)
-	{
-		return;
-	}
-
-	QList<QStandardItem*> entryItems({new QStandardItem(entry->getIcon(), entry->getUrl().toDisplayString().replace(QLatin1String("%23"), QString(QLatin1Char('#')))), new QStandardItem(entry->getTitle()), new QStandardItem(Utils::formatDateTime(entry->getTimeVisited()))});
-	entryItems[0]->setData(entry->getIdentifier(), IdentifierRole);
-	entryItems[0]->setFlags(entryItems[0]->flags() | Qt::ItemNeverHasChildren);
-	entryItems[1]->setFlags(entryItems[1]->flags() | Qt::ItemNeverHasChildren);
-	entryItems[2]->setData(entry->getTimeVisited(), TimeVisitedRole);
-	entryItems[2]->setFlags(entryItems[2]->flags() | Qt::ItemNeverHasChildren);
-	entryItems[2]->setToolTip(Utils::formatDateTime(entry->getTimeVisited(), {}, false));
-
-	groupItem->appendRow(entryItems);
-
-	m_ui->historyViewWidget->setRowHidden(groupItem->row(), groupItem->index().parent(), false);
-
-	if (!sender() || groupItem->rowCount() != 1 || SettingsManager::getOption(SettingsManager::History_ExpandBranchesOption).toString() != QLatin1String("first"))
+	if (!m_ui->filterLineEditWidget->text().isEmpty())
 	{
 		return;
 	}
 
 	for (int i = 0; i < m_model->rowCount(); ++i)
 	{
-		const QModelIndex index(m_model->index(i, 0));
+		const QModelIndex groupIndex(m_model->index(i, 0));
+		const QModelIndex index(m_ui->historyViewWidget->getProxyModel()->mapFromSource(groupIndex));
 
-		if (m_model->rowCount(index) > 0)
-		{
-			m_ui->historyViewWidget->expand(m_ui->historyViewWidget->getProxyModel()->mapFromSource(index));
-
-			break;
-		}
+		m_ui->historyViewWidget->setRowHidden(index.row(), index.parent(), !m_model->hasChildren(groupIndex));
 	}
 }
 
-void HistoryContentsWidget::handleEntryModified(HistoryModel::Entry *entry)
+void HistoryContentsWidget::handleEntriesInserted(const QModelIndex &parent, int first, int last)
 {
-	if (!entry || !entry->isValid())
+	if (!parent.isValid())
 	{
 		return;
 	}
 
-	QStandardItem *entryItem(findEntry(entry->getIdentifier()));
+	updateGroups();
 
-	if (!entryItem)
+	if (!m_isLoading && first == 0 && last == 0 && m_model->rowCount(parent) == 1 && SettingsManager::getOption(SettingsManager::History_ExpandBranchesOption).toString() == QLatin1String("first"))
 	{
-		handleEntryAdded(entry);
-
-		return;
-	}
-
-	entryItem->setIcon(entry->getIcon());
-	entryItem->setText(entry->getUrl().toDisplayString());
-	entryItem->parent()->child(entryItem->row(), 1)->setText(entry->getTitle());
-	entryItem->parent()->child(entryItem->row(), 2)->setText(Utils::formatDateTime(entry->getTimeVisited()));
-}
-
-void HistoryContentsWidget::handleEntryRemoved(HistoryModel::Entry *entry)
-{
-	if (!entry || !entry->isValid())
-	{
-		return;
-	}
-
-	QStandardItem *entryItem(findEntry(entry->getIdentifier()));
-
-	if (!entryItem)
-	{
-		return;
-	}
-
-	QStandardItem *groupItem(entryItem->parent());
-
-	if (groupItem)
-	{
-		m_model->removeRow(entryItem->row(), groupItem->index());
-
-		if (groupItem->rowCount() == 0)
-		{
-			m_ui->historyViewWidget->setRowHidden(groupItem->row(), m_model->invisibleRootItem()->index(), true);
-		}
+		expandBranches();
 	}
 }
 
@@ -368,20 +264,20 @@ void HistoryContentsWidget::showContextMenu(const QPoint &position)
 		menu.addSeparator();
 		menu.addAction(tr("Add to Bookmarks…"), this, [&]()
 		{
-			const QStandardItem *entryItem(findEntry(getEntry(m_ui->historyViewWidget->currentIndex())));
+			const QModelIndex index(m_ui->historyViewWidget->currentIndex());
 
-			if (entryItem)
+			if (getEntry(index) > 0)
 			{
-				Application::triggerAction(ActionsManager::BookmarkPageAction, {{QLatin1String("url"), entryItem->text()}, {QLatin1String("title"), m_ui->historyViewWidget->currentIndex().sibling(m_ui->historyViewWidget->currentIndex().row(), 1).data(Qt::DisplayRole).toString()}}, parentWidget());
+				Application::triggerAction(ActionsManager::BookmarkPageAction, {{QLatin1String("url"), index.sibling(index.row(), 0).data(Qt::DisplayRole).toString()}, {QLatin1String("title"), index.sibling(index.row(), 1).data(Qt::DisplayRole).toString()}}, parentWidget());
 			}
 		});
 		menu.addAction(tr("Copy Link to Clipboard"), this, [&]()
 		{
-			const QStandardItem *entryItem(findEntry(getEntry(m_ui->historyViewWidget->currentIndex())));
+			const QModelIndex index(m_ui->historyViewWidget->currentIndex());
 
-			if (entryItem)
+			if (getEntry(index) > 0)
 			{
-				QGuiApplication::clipboard()->setText(entryItem->text());
+				QGuiApplication::clipboard()->setText(index.sibling(index.row(), 0).data(Qt::DisplayRole).toString());
 			}
 		});
 		menu.addSeparator();
@@ -393,29 +289,6 @@ void HistoryContentsWidget::showContextMenu(const QPoint &position)
 	menu.exec(m_ui->historyViewWidget->mapToGlobal(position));
 }
 
-QStandardItem* HistoryContentsWidget::findEntry(quint64 identifier)
-{
-	for (int i = 0; i < m_model->rowCount(); ++i)
-	{
-		const QStandardItem *groupItem(m_model->item(i, 0));
-
-		if (groupItem)
-		{
-			for (int j = 0; j < groupItem->rowCount(); ++j)
-			{
-				QStandardItem *entryItem(groupItem->child(j, 0));
-
-				if (entryItem && entryItem->data(IdentifierRole).toULongLong() == identifier)
-				{
-					return entryItem;
-				}
-			}
-		}
-	}
-
-	return nullptr;
-}
-
 QString HistoryContentsWidget::getTitle() const
 {
 	return tr("History");
@@ -443,7 +316,7 @@ WebWidget::LoadingState HistoryContentsWidget::getLoadingState() const
 
 quint64 HistoryContentsWidget::getEntry(const QModelIndex &index) const
 {
-	return ((index.isValid() && index.parent().isValid() && index.parent().parent() == m_model->invisibleRootItem()->index()) ? index.sibling(index.row(), 0).data(IdentifierRole).toULongLong() : 0);
+	return ((index.isValid() && index.parent().isValid() && !index.parent().parent().isValid()) ? index.sibling(index.row(), 0).data(HistoryProxyModel::IdentifierRole).toULongLong() : 0);
 }
 
 bool HistoryContentsWidget::eventFilter(QObject *object, QEvent *event)
@@ -475,7 +348,7 @@ bool HistoryContentsWidget::eventFilter(QObject *object, QEvent *event)
 		{
 			const QModelIndex entryIndex(m_ui->historyViewWidget->currentIndex());
 
-			if (!entryIndex.isValid() || entryIndex.parent() == m_model->invisibleRootItem()->index())
+			if (!entryIndex.isValid() || !entryIndex.parent().isValid())
 			{
 				return ContentsWidget::eventFilter(object, event);
 			}
@@ -20,11 +20,8 @@
 #ifndef OTTER_HISTORYCONTENTSWIDGET_H
 #define OTTER_HISTORYCONTENTSWIDGET_H
 
-#include "../../../core/HistoryManager.h"
 #include "../../../ui/ContentsWidget.h"
 
-#include <QtGui/QStandardItemModel>
-
 namespace Otter
 {
 
@@ -33,6 +30,7 @@ namespace Ui
 	class HistoryContentsWidget;
 }
 
+class HistoryProxyModel;
 class Window;
 
 class HistoryContentsWidget final : public ContentsWidget
@@ -40,13 +38,6 @@ class HistoryContentsWidget final : public ContentsWidget
 	Q_OBJECT
 
 public:
-	enum DataRole
-	{
-		IdentifierRole = Qt::UserRole,
-		TimeVisitedRole,
-		GroupDateRole
-	};
-
 	explicit HistoryContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent);
 	~HistoryContentsWidget();
 
@@ -63,7 +54,7 @@ public slots:
 
 protected:
 	void changeEvent(QEvent *event) override;
-	QStandardItem* findEntry(quint64 identifier);
+	void expandBranches();
 	quint64 getEntry(const QModelIndex &index) const;
 
 protected slots:
@@ -71,13 +62,12 @@ protected slots:
 	void removeEntry();
 	void removeDomainEntries();
 	void openEntry();
-	void handleEntryAdded(HistoryModel::Entry *entry);
-	void handleEntryModified(HistoryModel::Entry *entry);
-	void handleEntryRemoved(HistoryModel::Entry *entry);
+	void updateGroups();
+	void handleEntriesInserted(const QModelIndex &parent, int first, int last);
 	void showContextMenu(const QPoint &position);
 
 private:
-	QStandardItemModel *m_model;
+	HistoryProxyModel *m_model;
 	bool m_isLoading;
 	Ui::HistoryContentsWidget *m_ui;
 };
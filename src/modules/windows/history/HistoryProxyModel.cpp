@@ -0,0 +1,576 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "HistoryProxyModel.h"
+#include "../../../core/ThemesManager.h"
+#include "../../../core/Utils.h"
+
+#include <QtCore/QCoreApplication>
+
+namespace Otter
+{
+
+HistoryProxyModel::HistoryProxyModel(HistoryModel *model, QObject *parent) : QAbstractProxyModel(parent),
+	m_model(model),
+	m_removedGroup(-1),
+	m_isResetting(false)
+{
+	setSourceModel(model);
+
+	m_groups.resize(7);
+
+	reloadModel();
+
+	connect(model, &HistoryModel::entryAdded, this, &HistoryProxyModel::handleEntryAdded);
+	connect(model, &HistoryModel::entryModified, this, &HistoryProxyModel::handleEntryModified);
+	connect(model, &HistoryModel::rowsAboutToBeRemoved, this, &HistoryProxyModel::handleSourceRowsAboutToBeRemoved);
+	connect(model, &HistoryModel::rowsRemoved, this, &HistoryProxyModel::handleSourceRowsRemoved);
+	connect(model, &HistoryModel::modelAboutToBeReset, this, &HistoryProxyModel::handleSourceAboutToBeReset);
+	connect(model, &HistoryModel::modelReset, this, &HistoryProxyModel::handleSourceReset);
+	connect(model, &HistoryModel::layoutAboutToBeChanged, this, &HistoryProxyModel::handleSourceAboutToBeReset);
+	connect(model, &HistoryModel::layoutChanged, this, &HistoryProxyModel::handleSourceReset);
+}
+
+void HistoryProxyModel::reloadModel()
+{
+	const QDate date(QDate::currentDate());
+	const QVector<QDate> dates({date, date.addDays(-1), date.addDays(-7), date.addDays(-14), date.addDays(-30), date.addDays(-365), QDate()});
+
+	beginResetModel();
+
+	for (int i = 0; i < m_groups.count(); ++i)
+	{
+		m_groups[i].date = dates.value(i);
+	}
+
+	m_groups = calculateGroups(false);
+
+	endResetModel();
+}
+
+void HistoryProxyModel::fetchMore(const QModelIndex &parent)
+{
+	if (!canFetchMore(parent))
+	{
+		return;
+	}
+
+	Group &group(m_groups[parent.row()]);
+	const int amount(qMin(250, (group.sourceAmount - group.loadedAmount)));
+
+	beginInsertRows(parent, group.loadedAmount, (group.loadedAmount + amount - 1));
+
+	group.loadedAmount += amount;
+
+	endInsertRows();
+}
+
+void HistoryProxyModel::fetchAll()
+{
+	for (int i = 0; i < m_groups.count(); ++i)
+	{
+		const QModelIndex groupIndex(index(i, 0));
+
+		while (canFetchMore(groupIndex))
+		{
+			fetchMore(groupIndex);
+		}
+	}
+}
+
+void HistoryProxyModel::handleEntryAdded(HistoryModel::Entry *entry)
+{
+	if (!entry || !entry->isValid() || entry->model() != m_model)
+	{
+		return;
+	}
+
+	const QVector<Group> groups(calculateGroups(true));
+	const int sourceRow(entry->row());
+	int groupRow(-1);
+
+	for (int i = 0; i < groups.count(); ++i)
+	{
+		if (sourceRow >= groups.at(i).sourceRow && sourceRow < (groups.at(i).sourceRow + groups.at(i).sourceAmount))
+		{
+			groupRow = i;
+
+			break;
+		}
+	}
+
+	if (groupRow < 0)
+	{
+		m_groups = groups;
+
+		return;
+	}
+
+	const Group &previousGroup(m_groups.at(groupRow));
+	const int row(sourceRow - groups.at(groupRow).sourceRow);
+	const bool wasEmpty(previousGroup.sourceAmount == 0);
+
+	if (row < previousGroup.loadedAmount || previousGroup.loadedAmount == previousGroup.sourceAmount)
+	{
+		const int loadedAmount(previousGroup.loadedAmount + 1);
+
+		beginInsertRows(index(groupRow, 0), row, row);
+
+		m_groups = groups;
+		m_groups[groupRow].loadedAmount = loadedAmount;
+
+		endInsertRows();
+	}
+	else
+	{
+		m_groups = groups;
+	}
+
+	if (wasEmpty)
+	{
+		const QModelIndex groupIndex(index(groupRow, 0));
+
+		emit dataChanged(groupIndex, groupIndex);
+	}
+}
+
+void HistoryProxyModel::handleEntryModified(HistoryModel::Entry *entry)
+{
+	if (!entry || entry->model() != m_model)
+	{
+		return;
+	}
+
+	const QModelIndex entryIndex(mapFromSource(entry->index()));
+
+	if (entryIndex.isValid())
+	{
+		emit dataChanged(entryIndex, entryIndex.sibling(entryIndex.row(), (columnCount() - 1)));
+	}
+}
+
+void HistoryProxyModel::handleSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+	if (parent.isValid() || m_isResetting)
+	{
+		return;
+	}
+
+	if (first != last)
+	{
+		m_isResetting = true;
+
+		beginResetModel();
+
+		return;
+	}
+
+	const int groupRow(findGroup(first));
+
+	if (groupRow < 0)
+	{
+		return;
+	}
+
+	const int row(first - m_groups.at(groupRow).sourceRow);
+
+	if (row < m_groups.at(groupRow).loadedAmount)
+	{
+		m_removedGroup = groupRow;
+
+		beginRemoveRows(index(groupRow, 0), row, row);
+	}
+}
+
+void HistoryProxyModel::handleSourceRowsRemoved(const QModelIndex &parent)
+{
+	if (parent.isValid())
+	{
+		return;
+	}
+
+	if (m_isResetting)
+	{
+		handleSourceReset();
+
+		return;
+	}
+
+	QVector<Group> groups(calculateGroups(true));
+
+	if (m_removedGroup >= 0)
+	{
+		groups[m_removedGroup].loadedAmount = qMax(0, (m_groups.at(m_removedGroup).loadedAmount - 1));
+
+		m_groups = groups;
+		m_removedGroup = -1;
+
+		endRemoveRows();
+	}
+	else
+	{
+		m_groups = groups;
+	}
+}
+
+void HistoryProxyModel::handleSourceAboutToBeReset()
+{
+	if (!m_isResetting)
+	{
+		m_isResetting = true;
+
+		beginResetModel();
+	}
+}
+
+void HistoryProxyModel::handleSourceReset()
+{
+	m_groups = calculateGroups(false);
+	m_removedGroup = -1;
+
+	if (m_isResetting)
+	{
+		m_isResetting = false;
+
+		endResetModel();
+	}
+}
+
+HistoryModel::Entry* HistoryProxyModel::getEntry(const QModelIndex &index) const
+{
+	return static_cast<HistoryModel::Entry*>(m_model->itemFromIndex(mapToSource(index)));
+}
+
+QVector<HistoryProxyModel::Group> HistoryProxyModel::calculateGroups(bool keepLoaded) const
+{
+	QVector<Group> groups(m_groups);
+	int sourceRow(0);
+
+	for (int i = 0; i < groups.count(); ++i)
+	{
+		Group &group(groups[i]);
+		const int boundary(group.date.isValid() ? qMax(sourceRow, findBoundary(group.date)) : m_model->rowCount());
+
+		group.sourceRow = sourceRow;
+		group.sourceAmount = (boundary - sourceRow);
+		group.loadedAmount = (keepLoaded ? qMin(group.loadedAmount, group.sourceAmount) : 0);
+
+		sourceRow = boundary;
+	}
+
+	return groups;
+}
+
+QVariant HistoryProxyModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid())
+	{
+		return {};
+	}
+
+	if (index.internalId() == 0)
+	{
+		if (index.column() > 0 || index.row() >= m_groups.count())
+		{
+			return {};
+		}
+
+		switch (role)
+		{
+			case Qt::DisplayRole:
+				{
+					const QStringList groups({QCoreApplication::translate("Otter::HistoryContentsWidget", "Today"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Yesterday"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Earlier This Week"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Previous Week"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Earlier This Month"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Earlier This Year"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Older")});
+
+					return groups.value(index.row());
+				}
+			case Qt::DecorationRole:
+				return ThemesManager::createIcon(QLatin1String("inode-directory"));
+			case GroupDateRole:
+				return m_groups.at(index.row()).date;
+			default:
+				break;
+		}
+
+		return {};
+	}
+
+	const HistoryModel::Entry *entry(getEntry(index));
+
+	if (!entry)
+	{
+		return {};
+	}
+
+	switch (index.column())
+	{
+		case 0:
+			switch (role)
+			{
+				case Qt::DisplayRole:
+					return entry->getUrl().toDisplayString().replace(QLatin1String("%23"), QString(QLatin1Char('#')));
+				case Qt::DecorationRole:
+					return entry->getIcon();
+				case IdentifierRole:
+					return entry->getIdentifier();
+				default:
+					break;
+			}
+
+			break;
+		case 1:
+			if (role == Qt::DisplayRole)
+			{
+				return entry->getTitle();
+			}
+
+			break;
+		case 2:
+			switch (role)
+			{
+				case Qt::DisplayRole:
+					return Utils::formatDateTime(entry->getTimeVisited());
+				case Qt::ToolTipRole:
+					return Utils::formatDateTime(entry->getTimeVisited(), {}, false);
+				case TimeVisitedRole:
+					return entry->getTimeVisited();
+				default:
+					break;
+			}
+
+			break;
+		default:
+			break;
+	}
+
+	return {};
+}
+
+QVariant HistoryProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || section < 0 || section >= columnCount())
+	{
+		return {};
+	}
+
+	if (role == Qt::DisplayRole)
+	{
+		const QStringList titles({QCoreApplication::translate("Otter::HistoryContentsWidget", "Address"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Title"), QCoreApplication::translate("Otter::HistoryContentsWidget", "Date")});
+
+		return titles.value(section);
+	}
+
+	if (m_headerData.contains(section) && m_headerData[section].contains(role))
+	{
+		return m_headerData[section][role];
+	}
+
+	return {};
+}
+
+QModelIndex HistoryProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+	if (row < 0 || column < 0 || column >= columnCount())
+	{
+		return {};
+	}
+
+	if (!parent.isValid())
+	{
+		return ((row < m_groups.count()) ? createIndex(row, column, quintptr(0)) : QModelIndex());
+	}
+
+	if (parent.internalId() != 0 || parent.row() >= m_groups.count() || row >= m_groups.at(parent.row()).loadedAmount)
+	{
+		return {};
+	}
+
+	return createIndex(row, column, quintptr(parent.row() + 1));
+}
+
+QModelIndex HistoryProxyModel::parent(const QModelIndex &child) const
+{
+	if (!child.isValid() || child.internalId() == 0)
+	{
+		return {};
+	}
+
+	return createIndex(static_cast<int>(child.internalId() - 1), 0, quintptr(0));
+}
+
+QModelIndex HistoryProxyModel::sibling(int row, int column, const QModelIndex &index) const
+{
+	return this->index(row, column, index.parent());
+}
+
+QModelIndex HistoryProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+	if (!sourceIndex.isValid() || sourceIndex.model() != m_model)
+	{
+		return {};
+	}
+
+	const int groupRow(findGroup(sourceIndex.row()));
+
+	if (groupRow < 0)
+	{
+		return {};
+	}
+
+	return index((sourceIndex.row() - m_groups.at(groupRow).sourceRow), 0, index(groupRow, 0));
+}
+
+QModelIndex HistoryProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+	if (!proxyIndex.isValid() || proxyIndex.internalId() == 0)
+	{
+		return {};
+	}
+
+	const int groupRow(static_cast<int>(proxyIndex.internalId() - 1));
+
+	if (groupRow >= m_groups.count() || proxyIndex.row() >= m_groups.at(groupRow).loadedAmount)
+	{
+		return {};
+	}
+
+	return m_model->index((m_groups.at(groupRow).sourceRow + proxyIndex.row()), 0);
+}
+
+QDate HistoryProxyModel::getSourceDate(int row) const
+{
+	return m_model->index(row, 0).data(HistoryModel::TimeVisitedRole).toDateTime().date();
+}
+
+Qt::ItemFlags HistoryProxyModel::flags(const QModelIndex &index) const
+{
+	if (!index.isValid())
+	{
+		return Qt::NoItemFlags;
+	}
+
+	if (index.internalId() == 0)
+	{
+		return (Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+	}
+
+	return (Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled | Qt::ItemNeverHasChildren);
+}
+
+int HistoryProxyModel::columnCount(const QModelIndex &parent) const
+{
+	Q_UNUSED(parent)
+
+	return 3;
+}
+
+int HistoryProxyModel::rowCount(const QModelIndex &parent) const
+{
+	if (!parent.isValid())
+	{
+		return m_groups.count();
+	}
+
+	if (parent.internalId() != 0 || parent.column() > 0 || parent.row() >= m_groups.count())
+	{
+		return 0;
+	}
+
+	return m_groups.at(parent.row()).loadedAmount;
+}
+
+int HistoryProxyModel::findBoundary(const QDate &date) const
+{
+	int low(0);
+	int high(m_model->rowCount());
+
+	while (low < high)
+	{
+		const int middle(low + ((high - low) / 2));
+
+		if (getSourceDate(middle) >= date)
+		{
+			low = (middle + 1);
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+int HistoryProxyModel::findGroup(int sourceRow) const
+{
+	for (int i = 0; i < m_groups.count(); ++i)
+	{
+		if (sourceRow >= m_groups.at(i).sourceRow && sourceRow < (m_groups.at(i).sourceRow + m_groups.at(i).sourceAmount))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool HistoryProxyModel::canFetchMore(const QModelIndex &parent) const
+{
+	if (!parent.isValid() || parent.internalId() != 0 || parent.row() >= m_groups.count())
+	{
+		return false;
+	}
+
+	return (m_groups.at(parent.row()).loadedAmount < m_groups.at(parent.row()).sourceAmount);
+}
+
+bool HistoryProxyModel::hasChildren(const QModelIndex &parent) const
+{
+	if (!parent.isValid())
+	{
+		return !m_groups.isEmpty();
+	}
+
+	if (parent.internalId() != 0 || parent.column() > 0 || parent.row() >= m_groups.count())
+	{
+		return false;
+	}
+
+	return (m_groups.at(parent.row()).sourceAmount > 0);
+}
+
+bool HistoryProxyModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant &value, int role)
+{
+	if (orientation == Qt::Vertical)
+	{
+		return false;
+	}
+
+	if (!m_headerData.contains(section))
+	{
+		m_headerData[section] = {};
+	}
+
+	m_headerData[section][role] = value;
+
+	emit headerDataChanged(orientation, section, section);
+
+	return true;
+}
+
+}
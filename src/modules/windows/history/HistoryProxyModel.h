@@ -0,0 +1,96 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2026 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_HISTORYPROXYMODEL_H
+#define OTTER_HISTORYPROXYMODEL_H
+
+#include "../../../core/HistoryModel.h"
+
+#include <QtCore/QAbstractProxyModel>
+
+namespace Otter
+{
+
+class HistoryProxyModel final : public QAbstractProxyModel
+{
+	Q_OBJECT
+
+public:
+	enum DataRole
+	{
+		IdentifierRole = Qt::UserRole,
+		TimeVisitedRole,
+		GroupDateRole
+	};
+
+	explicit HistoryProxyModel(HistoryModel *model, QObject *parent = nullptr);
+
+	void fetchMore(const QModelIndex &parent) override;
+	void fetchAll();
+	HistoryModel::Entry* getEntry(const QModelIndex &index) const;
+	QVariant data(const QModelIndex &index, int role) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	QModelIndex index(int row, int column, const QModelIndex &parent = {}) const override;
+	QModelIndex parent(const QModelIndex &child) const override;
+	QModelIndex sibling(int row, int column, const QModelIndex &index) const override;
+	QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+	QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+	Qt::ItemFlags flags(const QModelIndex &index) const override;
+	int columnCount(const QModelIndex &parent = {}) const override;
+	int rowCount(const QModelIndex &parent = {}) const override;
+	bool canFetchMore(const QModelIndex &parent) const override;
+	bool hasChildren(const QModelIndex &parent = {}) const override;
+	bool setHeaderData(int section, Qt::Orientation orientation, const QVariant &value, int role = Qt::EditRole) override;
+
+public slots:
+	void reloadModel();
+
+protected:
+	struct Group final
+	{
+		QDate date;
+		int sourceRow = 0;
+		int sourceAmount = 0;
+		int loadedAmount = 0;
+	};
+
+	QVector<Group> calculateGroups(bool keepLoaded) const;
+	QDate getSourceDate(int row) const;
+	int findBoundary(const QDate &date) const;
+	int findGroup(int sourceRow) const;
+
+protected slots:
+	void handleEntryAdded(HistoryModel::Entry *entry);
+	void handleEntryModified(HistoryModel::Entry *entry);
+	void handleSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+	void handleSourceRowsRemoved(const QModelIndex &parent);
+	void handleSourceAboutToBeReset();
+	void handleSourceReset();
+
+private:
+	HistoryModel *m_model;
+	QVector<Group> m_groups;
+	QMap<int, QMap<int, QVariant> > m_headerData;
+	int m_removedGroup;
+	bool m_isResetting;
+};
+
+}
+
+#endif
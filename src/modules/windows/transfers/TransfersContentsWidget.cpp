@@ -53,11 +53,12 @@ void ProgressBarDelegate::setEditorData(QWidget *editor, const QModelIndex &inde
 	const Transfer::TransferState state(static_cast<Transfer::TransferState>(index.data(TransfersContentsWidget::StateRole).toInt()));
 	const bool isIndeterminate(index.data(TransfersContentsWidget::BytesTotalRole).toLongLong() <= 0);
 	const bool hasError(state == Transfer::UnknownState || state == Transfer::ErrorState);
+	const bool isQueued(state == Transfer::QueuedState);
 
 	progressBar->setHasError(hasError);
-	progressBar->setRange(0, ((isIndeterminate && !hasError) ? 0 : 100));
-	progressBar->setValue(isIndeterminate ? (hasError ? 0 : -1) : index.data(TransfersContentsWidget::ProgressRole).toInt());
-	progressBar->setFormat(isIndeterminate ? tr("Unknown") : QLatin1String("%p%"));
+	progressBar->setRange(0, ((isIndeterminate && !hasError && !isQueued) ? 0 : 100));
+	progressBar->setValue(isIndeterminate ? ((hasError || isQueued) ? 0 : -1) : index.data(TransfersContentsWidget::ProgressRole).toInt());
+	progressBar->setFormat(isQueued ? tr("Queued") : (isIndeterminate ? tr("Unknown") : QLatin1String("%p%")));
 }
 
 QWidget* ProgressBarDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const
@@ -204,6 +205,7 @@ void TransfersContentsWidget::stopResumeTransfer()
 
 	switch (transfer->getState())
 	{
+		case Transfer::QueuedState:
 		case Transfer::RunningState:
 			transfer->stop();
 
@@ -266,6 +268,7 @@ void TransfersContentsWidget::handleTransferChanged(Transfer *transfer)
 
 	switch (transfer->getState())
 	{
+		case Transfer::QueuedState:
 		case Transfer::RunningState:
 			iconName = QLatin1String("task-ongoing");
 
@@ -386,7 +389,7 @@ void TransfersContentsWidget::showContextMenu(const QPoint &position)
 			}
 		})->setEnabled(canOpen || QFileInfo(transfer->getTarget()).dir().exists());
 		menu.addSeparator();
-		menu.addAction(((transfer->getState() == Transfer::ErrorState) ? tr("Resume") : tr("Stop")), this, &TransfersContentsWidget::stopResumeTransfer)->setEnabled(transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState);
+		menu.addAction(((transfer->getState() == Transfer::ErrorState) ? tr("Resume") : tr("Stop")), this, &TransfersContentsWidget::stopResumeTransfer)->setEnabled(transfer->getState() == Transfer::QueuedState || transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState);
 		menu.addAction(tr("Redownload"), this, &TransfersContentsWidget::redownloadTransfer);
 		menu.addSeparator();
 		menu.addAction(tr("Copy Transfer Information"), this, &TransfersContentsWidget::copyTransferInformation);
@@ -425,7 +428,7 @@ void TransfersContentsWidget::updateActions()
 		m_ui->stopResumeButton->setIcon(ThemesManager::createIcon(QLatin1String("task-reject")));
 	}
 
-	m_ui->stopResumeButton->setEnabled(transfer && (transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState));
+	m_ui->stopResumeButton->setEnabled(transfer && (transfer->getState() == Transfer::QueuedState || transfer->getState() == Transfer::RunningState || transfer->getState() == Transfer::ErrorState));
 	m_ui->redownloadButton->setEnabled(transfer);
 
 	if (transfer)
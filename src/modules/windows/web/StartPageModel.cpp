@@ -22,6 +22,7 @@
 #include "../../../core/BookmarksManager.h"
 #include "../../../core/SessionsManager.h"
 #include "../../../core/SettingsManager.h"
+#include "../../../core/ThumbnailsManager.h"
 #include "../../../core/WebBackend.h"
 
 #include <QtCore/QFile>
@@ -341,7 +342,25 @@ bool StartPageModel::requestThumbnail(const QUrl &url, quint64 identifier, bool
 		return false;
 	}
 
-	WebPageThumbnailJob *job(AddonsManager::getWebBackend()->createPageThumbnailJob(url, {SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt()}));
+	const QSize size(SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt());
+	const ThumbnailsManager::Thumbnail thumbnail(ThumbnailsManager::getThumbnail(url));
+	const QSize thumbnailSize(thumbnail.pixmap.size() / thumbnail.pixmap.devicePixelRatio());
+
+	if (thumbnail.isValid && thumbnailSize.width() >= size.width() && thumbnailSize.height() >= size.height())
+	{
+		const QPixmap pixmap(thumbnail.pixmap.scaled((size * thumbnail.pixmap.devicePixelRatio()), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation).copy(QRect(QPoint(0, 0), (size * thumbnail.pixmap.devicePixelRatio()))));
+
+		m_tileReloads[identifier] = needsTitleUpdate;
+
+		QTimer::singleShot(0, this, [=]()
+		{
+			handleThumbnailCreated(identifier, pixmap, thumbnail.title);
+		});
+
+		return true;
+	}
+
+	WebPageThumbnailJob *job(AddonsManager::getWebBackend()->createPageThumbnailJob(url, size));
 
 	if (!job)
 	{
@@ -36,6 +36,7 @@
 #include "../../../core/SearchEnginesManager.h"
 #include "../../../core/SettingsManager.h"
 #include "../../../core/ThemesManager.h"
+#include "../../../core/ThumbnailsManager.h"
 #include "../../../core/ToolBarsManager.h"
 #include "../../../core/Utils.h"
 #include "../../../core/WebBackend.h"
@@ -1215,6 +1216,7 @@ void WebContentsWidget::setWidget(WebWidget *widget, const QVariantMap &paramete
 	connect(m_webWidget, &WebWidget::requestedPermission, this, &WebContentsWidget::handlePermissionRequest);
 	connect(m_webWidget, &WebWidget::requestedSavePassword, this, &WebContentsWidget::handleSavePasswordRequest);
 	connect(m_webWidget, &WebWidget::requestedGeometryChange, this, &WebContentsWidget::requestedGeometryChange);
+	connect(m_webWidget, &WebWidget::contentsDamaged, this, &WebContentsWidget::contentsDamaged);
 	connect(m_webWidget, &WebWidget::requestedInspectorVisibilityChange, this, &WebContentsWidget::handleInspectorVisibilityChangeRequest);
 	connect(m_webWidget, &WebWidget::statusMessageChanged, this, &WebContentsWidget::statusMessageChanged);
 	connect(m_webWidget, &WebWidget::titleChanged, this, &WebContentsWidget::titleChanged);
@@ -1436,7 +1438,7 @@ QPixmap WebContentsWidget::createThumbnail()
 		return m_startPageWidget->createThumbnail();
 	}
 
-	return m_webWidget->createThumbnail();
+	return m_webWidget->createThumbnail(ThumbnailsManager::getThumbnailSize());
 }
 
 ActionsManager::ActionDefinition::State WebContentsWidget::getActionState(int identifier, const QVariantMap &parameters) const
@@ -411,6 +411,8 @@ ItemViewWidget::ItemViewWidget(QWidget *parent) : QTreeView(parent),
 	m_dragRow(-1),
 	m_areRowsMovable(false),
 	m_canGatherExpanded(false),
+	m_isFilterIndexOutdated(true),
+	m_isUpdatingFilter(false),
 	m_isExclusive(false),
 	m_isModified(false),
 	m_isInitialized(false)
@@ -836,11 +838,392 @@ void ItemViewWidget::notifySelectionChanged()
 	emit needsActionsUpdate();
 }
 
+void ItemViewWidget::createFilterIndex(QVector<FilterEntry> &entries, const QModelIndex &parent, int parentEntry, int first, int last, int offset) const
+{
+	for (int i = first; i <= last; ++i)
+	{
+		FilterEntry entry;
+		entry.index = model()->index(i, 0, parent);
+		entry.text = getFilterText(entry.index);
+		entry.parent = parentEntry;
+		entry.isFolder = !entry.index.flags().testFlag(Qt::ItemNeverHasChildren);
+		entry.isHidden = isRowHidden(i, parent);
+
+		const int position(offset + entries.count());
+
+		entries.append(entry);
+
+		if (entry.isFolder)
+		{
+			createFilterIndex(entries, entry.index, position, 0, (getRowCount(entry.index) - 1), offset);
+		}
+
+		entries[position - offset].lastDescendant = (offset + entries.count() - 1);
+	}
+}
+
+void ItemViewWidget::handleFilterDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+	if (m_isFilterIndexOutdated)
+	{
+		return;
+	}
+
+	if (m_isUpdatingFilter)
+	{
+		invalidateFilterIndex();
+
+		return;
+	}
+
+	if (!roles.isEmpty())
+	{
+		bool hasFilterRole(false);
+
+		for (int i = 0; i < roles.count(); ++i)
+		{
+			if (m_filterRoles.contains(roles.at(i)))
+			{
+				hasFilterRole = true;
+
+				break;
+			}
+		}
+
+		if (!hasFilterRole)
+		{
+			return;
+		}
+	}
+
+	int position(getFilterEntry(topLeft.parent(), topLeft.row()));
+	bool hasMatchesChange(false);
+
+	for (int i = topLeft.row(); i <= bottomRight.row(); ++i)
+	{
+		const QModelIndex index(topLeft.sibling(i, 0));
+
+		if (position < 0 || position >= m_filterEntries.count() || m_filterEntries.at(position).index != index)
+		{
+			invalidateFilterIndex();
+			updateFilter();
+
+			return;
+		}
+
+		FilterEntry &entry(m_filterEntries[position]);
+		const bool wasMatching(entry.text.contains(m_filterMatchesString));
+
+		entry.text = getFilterText(index);
+
+		if (entry.text.contains(m_filterMatchesString) != wasMatching)
+		{
+			if (wasMatching)
+			{
+				m_filterMatches.removeOne(position);
+			}
+			else
+			{
+				m_filterMatches.append(position);
+			}
+
+			hasMatchesChange = true;
+		}
+
+		position = (entry.lastDescendant + 1);
+	}
+
+	if (hasMatchesChange)
+	{
+		applyFilter();
+	}
+}
+
+void ItemViewWidget::handleFilterRowsInserted(const QModelIndex &parent, int first, int last)
+{
+	if (m_filterString.isEmpty())
+	{
+		return;
+	}
+
+	if (m_isFilterIndexOutdated || m_isUpdatingFilter)
+	{
+		invalidateFilterIndex();
+		updateFilter();
+
+		return;
+	}
+
+	const int parentEntry(parent.isValid() ? getFilterEntry(parent.parent(), parent.row()) : -1);
+	const int position(getFilterEntry(parent, first));
+
+	if (position < 0 || (parent.isValid() && (parentEntry < 0 || parentEntry >= m_filterEntries.count() || m_filterEntries.at(parentEntry).index != parent)))
+	{
+		invalidateFilterIndex();
+		updateFilter();
+
+		return;
+	}
+
+	QVector<FilterEntry> entries;
+
+	createFilterIndex(entries, parent, parentEntry, first, last, position);
+
+	const int amount(entries.count());
+
+	for (int i = 0; i < m_filterEntries.count(); ++i)
+	{
+		FilterEntry &entry(m_filterEntries[i]);
+
+		if (entry.parent >= position)
+		{
+			entry.parent += amount;
+		}
+
+		if (entry.lastDescendant >= position)
+		{
+			entry.lastDescendant += amount;
+		}
+	}
+
+	int ancestor(parentEntry);
+
+	while (ancestor >= 0)
+	{
+		FilterEntry &entry(m_filterEntries[ancestor]);
+
+		if (entry.lastDescendant < position)
+		{
+			entry.lastDescendant += amount;
+		}
+
+		ancestor = entry.parent;
+	}
+
+	for (int i = 0; i < m_filterMatches.count(); ++i)
+	{
+		if (m_filterMatches.at(i) >= position)
+		{
+			m_filterMatches[i] += amount;
+		}
+	}
+
+	m_filterEntries.insert(position, amount, FilterEntry());
+
+	for (int i = 0; i < amount; ++i)
+	{
+		m_filterEntries[position + i] = entries.at(i);
+
+		if (entries.at(i).text.contains(m_filterMatchesString))
+		{
+			m_filterMatches.append(position + i);
+		}
+	}
+
+	applyFilter();
+}
+
+void ItemViewWidget::handleFilterRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+	if (m_filterString.isEmpty())
+	{
+		return;
+	}
+
+	if (m_isFilterIndexOutdated || m_isUpdatingFilter)
+	{
+		invalidateFilterIndex();
+		updateFilter();
+
+		return;
+	}
+
+	const int position(getFilterEntry(parent, first));
+	int end(position);
+
+	for (int i = first; i <= last && end >= 0; ++i)
+	{
+		end = ((end < m_filterEntries.count()) ? (m_filterEntries.at(end).lastDescendant + 1) : -1);
+	}
+
+	if (position < 0 || end < position)
+	{
+		invalidateFilterIndex();
+		updateFilter();
+
+		return;
+	}
+
+	const int amount(end - position);
+
+	m_filterEntries.remove(position, amount);
+
+	for (int i = 0; i < m_filterEntries.count(); ++i)
+	{
+		FilterEntry &entry(m_filterEntries[i]);
+
+		if (entry.parent >= end)
+		{
+			entry.parent -= amount;
+		}
+
+		if (entry.lastDescendant >= end)
+		{
+			entry.lastDescendant -= amount;
+		}
+		else if (entry.lastDescendant >= position)
+		{
+			entry.lastDescendant = (position - 1);
+		}
+	}
+
+	QVector<int> matches;
+	matches.reserve(m_filterMatches.count());
+
+	for (int i = 0; i < m_filterMatches.count(); ++i)
+	{
+		const int match(m_filterMatches.at(i));
+
+		if (match < position)
+		{
+			matches.append(match);
+		}
+		else if (match >= end)
+		{
+			matches.append(match - amount);
+		}
+	}
+
+	m_filterMatches = matches;
+
+	applyFilter();
+}
+
 void ItemViewWidget::updateFilter()
 {
-	for (int i = 0; i < getRowCount(); ++i)
+	if (!model() || m_isUpdatingFilter)
+	{
+		return;
+	}
+
+	if (m_isFilterIndexOutdated)
+	{
+		m_filterEntries.clear();
+		m_filterMatches.clear();
+		m_filterMatchesString.clear();
+
+		createFilterIndex(m_filterEntries, {}, -1, 0, (getRowCount() - 1), 0);
+
+		m_isFilterIndexOutdated = false;
+	}
+
+	const QString filter(m_filterString.toCaseFolded());
+
+	if (!filter.isEmpty())
 	{
-		applyFilter(getIndex(i, 0));
+		const bool canNarrow(!m_filterMatchesString.isEmpty() && filter.contains(m_filterMatchesString));
+		const int candidatesAmount(canNarrow ? m_filterMatches.count() : m_filterEntries.count());
+		QVector<int> matches;
+
+		for (int i = 0; i < candidatesAmount; ++i)
+		{
+			const int candidate(canNarrow ? m_filterMatches.at(i) : i);
+
+			if (m_filterEntries.at(candidate).text.contains(filter))
+			{
+				matches.append(candidate);
+			}
+		}
+
+		m_filterMatches = matches;
+		m_filterMatchesString = filter;
+	}
+
+	applyFilter();
+}
+
+void ItemViewWidget::applyFilter()
+{
+	m_isUpdatingFilter = true;
+
+	const bool hasFilter(!m_filterString.isEmpty());
+	QVector<bool> visibleEntries(m_filterEntries.count(), !hasFilter);
+
+	if (hasFilter)
+	{
+		for (int i = 0; i < m_filterMatches.count(); ++i)
+		{
+			const FilterEntry &entry(m_filterEntries.at(m_filterMatches.at(i)));
+
+			for (int j = m_filterMatches.at(i); j <= entry.lastDescendant; ++j)
+			{
+				visibleEntries[j] = true;
+			}
+
+			int parent(entry.parent);
+
+			while (parent >= 0 && !visibleEntries.at(parent))
+			{
+				visibleEntries[parent] = true;
+
+				parent = m_filterEntries.at(parent).parent;
+			}
+		}
+	}
+
+	setUpdatesEnabled(false);
+
+	for (int i = 0; i < m_filterEntries.count(); ++i)
+	{
+		FilterEntry &entry(m_filterEntries[i]);
+		const bool isHidden(hasFilter && (!visibleEntries.at(i) || (entry.isFolder && entry.lastDescendant == i)));
+
+		if (entry.isFolder && m_canGatherExpanded && isExpanded(entry.index))
+		{
+			m_expandedBranches.insert(entry.index);
+		}
+
+		if (isHidden != entry.isHidden)
+		{
+			setRowHidden(entry.index.row(), entry.index.parent(), isHidden);
+
+			entry.isHidden = isHidden;
+		}
+
+		if (entry.isFolder)
+		{
+			const bool shouldExpand(hasFilter ? visibleEntries.at(i) : m_expandedBranches.contains(entry.index));
+
+			if (shouldExpand != isExpanded(entry.index))
+			{
+				setExpanded(entry.index, shouldExpand);
+			}
+		}
+	}
+
+	setUpdatesEnabled(true);
+
+	m_isUpdatingFilter = false;
+
+	if (m_isFilterIndexOutdated)
+	{
+		updateFilter();
+	}
+	else if (!hasFilter)
+	{
+		invalidateFilterIndex();
+	}
+}
+
+void ItemViewWidget::invalidateFilterIndex()
+{
+	m_isFilterIndexOutdated = true;
+
+	if (!m_isUpdatingFilter)
+	{
+		m_filterEntries.clear();
+		m_filterMatches.clear();
+		m_filterMatchesString.clear();
 	}
 }
 
@@ -969,9 +1352,7 @@ void ItemViewWidget::setFilterString(const QString &filter)
 
 	if (m_filterString.isEmpty())
 	{
-		connect(model(), &QAbstractItemModel::rowsInserted, this, &ItemViewWidget::updateFilter);
 		connect(model(), &QAbstractItemModel::rowsMoved, this, &ItemViewWidget::updateFilter);
-		connect(model(), &QAbstractItemModel::rowsRemoved, this, &ItemViewWidget::updateFilter);
 	}
 
 	m_canGatherExpanded = m_filterString.isEmpty();
@@ -983,15 +1364,15 @@ void ItemViewWidget::setFilterString(const QString &filter)
 	{
 		m_expandedBranches.clear();
 
-		disconnect(model(), &QAbstractItemModel::rowsInserted, this, &ItemViewWidget::updateFilter);
 		disconnect(model(), &QAbstractItemModel::rowsMoved, this, &ItemViewWidget::updateFilter);
-		disconnect(model(), &QAbstractItemModel::rowsRemoved, this, &ItemViewWidget::updateFilter);
 	}
 }
 
 void ItemViewWidget::setFilterRoles(const QSet<int> &roles)
 {
 	m_filterRoles = roles;
+
+	invalidateFilterIndex();
 }
 
 void ItemViewWidget::setRowsMovable(bool areMovable)
@@ -1073,7 +1454,15 @@ void ItemViewWidget::setModel(QAbstractItemModel *model, bool useSortProxy)
 
 	emit needsActionsUpdate();
 
+	invalidateFilterIndex();
+
 	connect(selectionModel(), &QItemSelectionModel::selectionChanged, this, &ItemViewWidget::notifySelectionChanged);
+	connect(activeModel, &QAbstractItemModel::dataChanged, this, &ItemViewWidget::handleFilterDataChanged);
+	connect(activeModel, &QAbstractItemModel::rowsInserted, this, &ItemViewWidget::handleFilterRowsInserted);
+	connect(activeModel, &QAbstractItemModel::rowsRemoved, this, &ItemViewWidget::handleFilterRowsRemoved);
+	connect(activeModel, &QAbstractItemModel::rowsMoved, this, &ItemViewWidget::invalidateFilterIndex);
+	connect(activeModel, &QAbstractItemModel::layoutChanged, this, &ItemViewWidget::invalidateFilterIndex);
+	connect(activeModel, &QAbstractItemModel::modelReset, this, &ItemViewWidget::invalidateFilterIndex);
 	connect(model, &QAbstractItemModel::dataChanged, this, &ItemViewWidget::markAsModified);
 	connect(model, &QAbstractItemModel::headerDataChanged, this, &ItemViewWidget::updateSize);
 	connect(model, &QAbstractItemModel::rowsInserted, this, &ItemViewWidget::markAsModified);
@@ -1135,6 +1524,37 @@ QStandardItem* ItemViewWidget::getItem(int row, int column, const QModelIndex &p
 	return (m_sourceModel ? m_sourceModel->itemFromIndex(getIndex(row, column, parent)) : nullptr);
 }
 
+QString ItemViewWidget::getFilterText(const QModelIndex &index) const
+{
+	const int columnCount(getColumnCount(index.parent()));
+	QString text;
+
+	for (int i = 0; i < columnCount; ++i)
+	{
+		const QModelIndex columnIndex((i == index.column()) ? index : index.sibling(index.row(), i));
+
+		if (!columnIndex.isValid())
+		{
+			continue;
+		}
+
+		QSet<int>::const_iterator iterator;
+
+		for (iterator = m_filterRoles.constBegin(); iterator != m_filterRoles.constEnd(); ++iterator)
+		{
+			const QVariant roleData(columnIndex.data(*iterator));
+
+			if (!roleData.isNull())
+			{
+				text.append(roleData.toString().toCaseFolded());
+				text.append(QLatin1Char('\n'));
+			}
+		}
+	}
+
+	return text;
+}
+
 QModelIndex ItemViewWidget::getCheckedIndex(const QModelIndex &parent) const
 {
 	if (!m_isExclusive || !m_sourceModel)
@@ -1242,6 +1662,37 @@ int ItemViewWidget::getCurrentRow() const
 	return (hasSelection() ? currentIndex().row() : -1);
 }
 
+int ItemViewWidget::getFilterEntry(const QModelIndex &parent, int row) const
+{
+	int position(0);
+	int lastPosition(m_filterEntries.count() - 1);
+
+	if (parent.isValid())
+	{
+		const int parentEntry(getFilterEntry(parent.parent(), parent.row()));
+
+		if (parentEntry < 0 || parentEntry > lastPosition || m_filterEntries.at(parentEntry).index != parent)
+		{
+			return -1;
+		}
+
+		position = (parentEntry + 1);
+		lastPosition = m_filterEntries.at(parentEntry).lastDescendant;
+	}
+
+	for (int i = 0; i < row; ++i)
+	{
+		if (position > lastPosition)
+		{
+			return -1;
+		}
+
+		position = (m_filterEntries.at(position).lastDescendant + 1);
+	}
+
+	return position;
+}
+
 int ItemViewWidget::getRowCount(const QModelIndex &parent) const
 {
 	return (model() ? model()->rowCount(parent) : 0);
@@ -1285,81 +1736,4 @@ bool ItemViewWidget::isModified() const
 	return m_isModified;
 }
 
-bool ItemViewWidget::applyFilter(const QModelIndex &index, bool parentHasMatch)
-{
-	if (!model())
-	{
-		return false;
-	}
-
-	const bool isFolder(!index.flags().testFlag(Qt::ItemNeverHasChildren));
-	const bool hasFilter(!m_filterString.isEmpty());
-	bool hasMatch(!hasFilter || (isFolder && parentHasMatch));
-
-	if (!hasMatch)
-	{
-		for (int i = 0; i < getColumnCount(index.parent()); ++i)
-		{
-			const QModelIndex childIndex(index.sibling(index.row(), i));
-
-			if (!childIndex.isValid())
-			{
-				continue;
-			}
-
-			QSet<int>::iterator iterator;
-
-			for (iterator = m_filterRoles.begin(); iterator != m_filterRoles.end(); ++iterator)
-			{
-				const QVariant roleData(childIndex.data(*iterator));
-
-				if (!roleData.isNull() && roleData.toString().contains(m_filterString, Qt::CaseInsensitive))
-				{
-					hasMatch = true;
-
-					break;
-				}
-			}
-
-			if (hasMatch)
-			{
-				break;
-			}
-		}
-	}
-
-	if (isFolder)
-	{
-		if (m_canGatherExpanded && isExpanded(index))
-		{
-			m_expandedBranches.insert(index);
-		}
-
-		const int rowCount(getRowCount(index));
-		bool folderHasMatch(false);
-
-		for (int i = 0; i < rowCount; ++i)
-		{
-			if (applyFilter(model()->index(i, 0, index), hasMatch))
-			{
-				folderHasMatch = true;
-			}
-		}
-
-		if (!hasMatch)
-		{
-			hasMatch = folderHasMatch;
-		}
-	}
-
-	setRowHidden(index.row(), index.parent(), (hasFilter ? (!(hasMatch || parentHasMatch) || (isFolder && getRowCount(index) == 0)) : false));
-
-	if (isFolder)
-	{
-		setExpanded(index, ((hasMatch && hasFilter) || (!hasFilter && m_expandedBranches.contains(index))));
-	}
-
-	return hasMatch;
-}
-
 }
@@ -159,6 +159,16 @@ public slots:
 	void setRowsMovable(bool areMovable);
 
 protected:
+	struct FilterEntry final
+	{
+		QPersistentModelIndex index;
+		QString text;
+		int parent = -1;
+		int lastDescendant = -1;
+		bool isFolder = false;
+		bool isHidden = false;
+	};
+
 	void paintEvent(QPaintEvent *event) override;
 	void showEvent(QShowEvent *event) override;
 	void resizeEvent(QResizeEvent *event) override;
@@ -168,14 +178,21 @@ protected:
 	void startDrag(Qt::DropActions supportedActions) override;
 	void ensureInitialized();
 	void moveRow(bool moveUp);
-	bool applyFilter(const QModelIndex &index, bool parentHasMatch = false);
+	void createFilterIndex(QVector<FilterEntry> &entries, const QModelIndex &parent, int parentEntry, int first, int last, int offset) const;
+	void applyFilter();
+	QString getFilterText(const QModelIndex &index) const;
+	int getFilterEntry(const QModelIndex &parent, int row) const;
 
 protected slots:
 	void currentChanged(const QModelIndex &current, const QModelIndex &previous) override;
 	void saveState();
 	void handleOptionChanged(int identifier, const QVariant &value);
 	void notifySelectionChanged();
+	void handleFilterDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+	void handleFilterRowsInserted(const QModelIndex &parent, int first, int last);
+	void handleFilterRowsRemoved(const QModelIndex &parent, int first, int last);
 	void updateFilter();
+	void invalidateFilterIndex();
 	void updateSize();
 
 private:
@@ -185,6 +202,9 @@ private:
 	QSortFilterProxyModel *m_proxyModel;
 	QString m_filterString;
 	QMap<int, int> m_sortRoleMapping;
+	QString m_filterMatchesString;
+	QVector<FilterEntry> m_filterEntries;
+	QVector<int> m_filterMatches;
 	QSet<QModelIndex> m_expandedBranches;
 	QSet<int> m_filterRoles;
 	ViewMode m_viewMode;
@@ -193,6 +213,8 @@ private:
 	int m_dragRow;
 	bool m_areRowsMovable;
 	bool m_canGatherExpanded;
+	bool m_isFilterIndexOutdated;
+	bool m_isUpdatingFilter;
 	bool m_isExclusive;
 	bool m_isModified;
 	bool m_isInitialized;
@@ -52,7 +52,8 @@ Menu::Menu(QWidget *parent) : QMenu(parent),
 	m_actionGroup(nullptr),
 	m_clickedAction(nullptr),
 	m_role(UnknownMenu),
-	m_option(-1)
+	m_option(-1),
+	m_bookmarksAmount(0)
 {
 }
 
@@ -60,7 +61,8 @@ Menu::Menu(int role, QWidget *parent) : QMenu(parent),
 	m_actionGroup(nullptr),
 	m_clickedAction(nullptr),
 	m_role(role),
-	m_option(-1)
+	m_option(-1),
+	m_bookmarksAmount(0)
 {
 	Q_UNUSED(QT_TRANSLATE_NOOP("actions", "File"))
 	Q_UNUSED(QT_TRANSLATE_NOOP("actions", "Edit"))
@@ -128,6 +130,7 @@ Menu::Menu(int role, QWidget *parent) : QMenu(parent),
 				if (role == BookmarksMenu)
 				{
 					connect(this, &Menu::aboutToShow, this, &Menu::populateBookmarksMenu);
+					connect(this, &Menu::hovered, this, &Menu::handleBookmarkHovered);
 				}
 				else
 				{
@@ -666,12 +669,12 @@ void Menu::populateBookmarksMenu()
 		return;
 	}
 
-	MainWindow *mainWindow(MainWindow::findMainWindow(parent()));
-	ActionExecutor::Object executor(mainWindow, mainWindow);
+	m_bookmarksAmount = 0;
 
 	if (folderBookmark->rowCount() > 1)
 	{
-		Action *action(new OpenBookmarkMenuAction(folderBookmark->getIdentifier(), executor, this));
+		MainWindow *mainWindow(MainWindow::findMainWindow(parent()));
+		Action *action(new OpenBookmarkMenuAction(folderBookmark->getIdentifier(), ActionExecutor::Object(mainWindow, mainWindow), this));
 		action->setTextOverride(QT_TRANSLATE_NOOP("actions", "Open All"));
 		action->setIconOverride(QLatin1String("document-open-folder"));
 
@@ -679,7 +682,23 @@ void Menu::populateBookmarksMenu()
 		addSeparator();
 	}
 
-	for (int i = 0; i < folderBookmark->rowCount(); ++i)
+	appendBookmarks();
+}
+
+void Menu::appendBookmarks()
+{
+	const BookmarksModel::Bookmark *folderBookmark(BookmarksManager::getModel()->getBookmark(m_menuOptions.value(QLatin1String("bookmark")).toULongLong()));
+
+	if (!folderBookmark)
+	{
+		return;
+	}
+
+	MainWindow *mainWindow(MainWindow::findMainWindow(parent()));
+	ActionExecutor::Object executor(mainWindow, mainWindow);
+	const int amount(qMin(folderBookmark->rowCount(), (m_bookmarksAmount + 100)));
+
+	for (int i = m_bookmarksAmount; i < amount; ++i)
 	{
 		const BookmarksModel::Bookmark *bookmark(folderBookmark->getChild(i));
 
@@ -725,6 +744,8 @@ void Menu::populateBookmarksMenu()
 				break;
 		}
 	}
+
+	m_bookmarksAmount = amount;
 }
 
 void Menu::populateBookmarkSelectorMenu()
@@ -1618,6 +1639,23 @@ void Menu::populateWindowsMenu()
 	}
 }
 
+void Menu::handleBookmarkHovered(QAction *action)
+{
+	const MenuAction *menuAction(qobject_cast<MenuAction*>(action));
+
+	if (!menuAction || menuAction->getIdentifier() != ActionsManager::OpenBookmarkAction)
+	{
+		return;
+	}
+
+	const BookmarksModel::Bookmark *folderBookmark(BookmarksManager::getModel()->getBookmark(m_menuOptions.value(QLatin1String("bookmark")).toULongLong()));
+
+	if (folderBookmark && m_bookmarksAmount < folderBookmark->rowCount() && actions().indexOf(action) >= (actions().count() - 10))
+	{
+		appendBookmarks();
+	}
+}
+
 void Menu::clearBookmarksMenu()
 {
 	const int offset((m_menuOptions.value(QLatin1String("bookmark")).toULongLong() == 0) ? 3 : 0);
@@ -1630,6 +1668,8 @@ void Menu::clearBookmarksMenu()
 		removeAction(action);
 	}
 
+	m_bookmarksAmount = 0;
+
 	connect(this, &Menu::aboutToShow, this, &Menu::populateBookmarksMenu);
 }
 
@@ -91,6 +91,7 @@ protected:
 	void mouseReleaseEvent(QMouseEvent *event) override;
 	void contextMenuEvent(QContextMenuEvent *event) override;
 	void appendAction(const QJsonValue &definition, const QStringList &sections, const ActionExecutor::Object &executor);
+	void appendBookmarks();
 	ActionExecutor::Object getExecutor() const;
 	MenuContext getMenuContext() const;
 	bool canInclude(const QJsonObject &definition, const QStringList &sections);
@@ -115,6 +116,7 @@ protected slots:
 	void populateToolBarsMenu();
 	void populateUserAgentMenu();
 	void populateWindowsMenu();
+	void handleBookmarkHovered(QAction *action);
 	void clearBookmarksMenu();
 	void clearNotesMenu();
 	void selectOption(QAction *action);
@@ -130,6 +132,7 @@ private:
 	QVariantMap m_menuOptions;
 	int m_role;
 	int m_option;
+	int m_bookmarksAmount;
 
 	static int m_menuRoleIdentifierEnumerator;
 };
@@ -186,6 +186,7 @@ SourceEditWidget::SourceEditWidget(QWidget *parent) : TextEditWidget(false, pare
 	m_findFlags(WebWidget::NoFlagsFind),
 	m_initialRevision(-1),
 	m_savedRevision(-1),
+	m_highlightingTimer(0),
 	m_zoom(100)
 {
 	setZoom(SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
@@ -194,6 +195,7 @@ SourceEditWidget::SourceEditWidget(QWidget *parent) : TextEditWidget(false, pare
 	handleOptionChanged(SettingsManager::SourceViewer_WrapLinesOption, SettingsManager::getOption(SettingsManager::SourceViewer_WrapLinesOption));
 
 	connect(this, &SourceEditWidget::textChanged, this, &SourceEditWidget::updateSelection);
+	connect(this, &SourceEditWidget::updateRequest, this, &SourceEditWidget::scheduleHighlightingUpdate);
 	connect(this, &SourceEditWidget::cursorPositionChanged, this, &SourceEditWidget::updateTextCursor);
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &SourceEditWidget::handleOptionChanged);
 }
@@ -209,6 +211,22 @@ void SourceEditWidget::changeEvent(QEvent *event)
 	}
 }
 
+void SourceEditWidget::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_highlightingTimer)
+	{
+		killTimer(m_highlightingTimer);
+
+		m_highlightingTimer = 0;
+
+		updateHighlighting();
+	}
+	else
+	{
+		TextEditWidget::timerEvent(event);
+	}
+}
+
 void SourceEditWidget::resizeEvent(QResizeEvent *event)
 {
 	TextEditWidget::resizeEvent(event);
@@ -243,6 +261,30 @@ void SourceEditWidget::wheelEvent(QWheelEvent *event)
 	TextEditWidget::wheelEvent(event);
 }
 
+void SourceEditWidget::updateHighlighting()
+{
+	if (!m_highlighter)
+	{
+		return;
+	}
+
+	const QTextBlock firstBlock(firstVisibleBlock());
+	const QPointF offset(contentOffset());
+	const int height(viewport()->height());
+	QTextBlock lastBlock(firstBlock);
+	QTextBlock block(firstBlock);
+
+	while (block.isValid() && blockBoundingGeometry(block).translated(offset).top() <= height)
+	{
+		lastBlock = block;
+		block = block.next();
+	}
+
+	const int margin(qMax(50, (lastBlock.blockNumber() - firstBlock.blockNumber() + 1)));
+
+	m_highlighter->setHighlightingRange((firstBlock.blockNumber() - margin), (lastBlock.blockNumber() + margin));
+}
+
 void SourceEditWidget::triggerAction(int identifier, const QVariantMap &parameters, ActionsManager::TriggerType trigger)
 {
 	if (identifier != ActionsManager::CheckSpellingAction)
@@ -351,6 +393,14 @@ void SourceEditWidget::handleOptionChanged(int identifier, const QVariant &value
 	}
 }
 
+void SourceEditWidget::scheduleHighlightingUpdate()
+{
+	if (m_highlightingTimer == 0)
+	{
+		m_highlightingTimer = startTimer(0);
+	}
+}
+
 void SourceEditWidget::markAsLoaded()
 {
 	m_initialRevision = document()->revision();
@@ -457,6 +507,8 @@ void SourceEditWidget::setSyntax(SyntaxHighlighter::HighlightingSyntax syntax)
 	}
 
 	m_highlighter = SyntaxHighlighter::createHighlighter(syntax, document());
+
+	updateHighlighting();
 }
 
 void SourceEditWidget::setZoom(int zoom)
@@ -73,15 +73,18 @@ public slots:
 
 protected:
 	void changeEvent(QEvent *event) override;
+	void timerEvent(QTimerEvent *event) override;
 	void resizeEvent(QResizeEvent *event) override;
 	void focusInEvent(QFocusEvent *event) override;
 	void wheelEvent(QWheelEvent *event) override;
+	void updateHighlighting();
 	QRect getMarginGeometry() const;
 	int getInitialRevision() const;
 	int getSavedRevision() const;
 
 protected slots:
 	void handleOptionChanged(int identifier, const QVariant &value);
+	void scheduleHighlightingUpdate();
 	void updateTextCursor();
 	void updateSelection();
 
@@ -94,6 +97,7 @@ private:
 	WebWidget::FindFlags m_findFlags;
 	int m_initialRevision;
 	int m_savedRevision;
+	int m_highlightingTimer;
 	int m_zoom;
 
 signals:
@@ -27,6 +27,7 @@
 #include "../core/NotesManager.h"
 #include "../core/Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QFile>
 #include <QtCore/QTextCodec>
 #include <QtGui/QClipboard>
@@ -42,6 +43,8 @@ SourceViewerWebWidget::SourceViewerWebWidget(bool isPrivate, ContentsWidget *par
 	m_sourceEditWidget(new SourceEditWidget(this)),
 	m_networkManager(nullptr),
 	m_viewSourceReply(nullptr),
+	m_contentsWatcher(nullptr),
+	m_contentsTimer(0),
 	m_isLoading(true),
 	m_isPrivate(isPrivate)
 {
@@ -106,6 +109,24 @@ void SourceViewerWebWidget::triggerAction(int identifier, const QVariantMap &par
 				m_viewSourceReply = nullptr;
 			}
 
+			if (m_contentsWatcher)
+			{
+				m_contentsWatcher->disconnect(this);
+				m_contentsWatcher->deleteLater();
+				m_contentsWatcher = nullptr;
+			}
+
+			if (m_contentsTimer != 0)
+			{
+				killTimer(m_contentsTimer);
+
+				m_contentsTimer = 0;
+
+				m_pendingContents.clear();
+
+				markContentsAsLoaded();
+			}
+
 			m_isLoading = false;
 
 			emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory});
@@ -275,15 +296,73 @@ void SourceViewerWebWidget::print(QPrinter *printer)
 	m_sourceEditWidget->print(printer);
 }
 
+void SourceViewerWebWidget::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_contentsTimer)
+	{
+		WebWidget::timerEvent(event);
+
+		return;
+	}
+
+	if (!m_pendingContents.isEmpty())
+	{
+		QTextCursor cursor(m_sourceEditWidget->document());
+		cursor.movePosition(QTextCursor::End);
+		cursor.insertText(m_pendingContents.takeFirst());
+	}
+
+	if (m_pendingContents.isEmpty())
+	{
+		killTimer(m_contentsTimer);
+
+		m_contentsTimer = 0;
+
+		markContentsAsLoaded();
+
+		m_isLoading = false;
+
+		emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory});
+		emit loadingStateChanged(WebWidget::FinishedLoadingState);
+	}
+}
+
+void SourceViewerWebWidget::markContentsAsLoaded()
+{
+	m_sourceEditWidget->document()->setUndoRedoEnabled(true);
+	m_sourceEditWidget->markAsLoaded();
+}
+
+void SourceViewerWebWidget::handleContentsDecoded()
+{
+	if (!m_contentsWatcher)
+	{
+		return;
+	}
+
+	m_pendingContents = m_contentsWatcher->result();
+
+	m_contentsWatcher->deleteLater();
+	m_contentsWatcher = nullptr;
+
+	m_sourceEditWidget->document()->setUndoRedoEnabled(false);
+	m_sourceEditWidget->setPlainText(m_pendingContents.isEmpty() ? QString() : m_pendingContents.takeFirst());
+
+	m_contentsTimer = startTimer(0);
+}
+
 void SourceViewerWebWidget::handleViewSourceReplyFinished()
 {
 	if (m_viewSourceReply)
 	{
-		setContents(m_viewSourceReply->readAll(), m_viewSourceReply->header(QNetworkRequest::ContentTypeHeader).toString());
+		QNetworkReply *reply(m_viewSourceReply);
 
-		m_viewSourceReply->deleteLater();
 		m_viewSourceReply = nullptr;
 
+		setContents(reply->readAll(), reply->header(QNetworkRequest::ContentTypeHeader).toString());
+
+		reply->deleteLater();
+
 		emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory});
 	}
 }
@@ -368,6 +447,22 @@ void SourceViewerWebWidget::setUrl(const QUrl &url, bool isTypedIn)
 
 void SourceViewerWebWidget::setContents(const QByteArray &contents, const QString &contentType)
 {
+	if (m_contentsWatcher)
+	{
+		m_contentsWatcher->disconnect(this);
+		m_contentsWatcher->deleteLater();
+		m_contentsWatcher = nullptr;
+	}
+
+	if (m_contentsTimer != 0)
+	{
+		killTimer(m_contentsTimer);
+
+		m_contentsTimer = 0;
+	}
+
+	m_pendingContents.clear();
+
 	triggerAction(ActionsManager::StopAction);
 
 	const QTextCodec *codec(nullptr);
@@ -392,16 +487,32 @@ void SourceViewerWebWidget::setContents(const QByteArray &contents, const QStrin
 		codec = QTextCodec::codecForHtml(contents);
 	}
 
-	if (codec)
-	{
-		m_sourceEditWidget->setPlainText(codec->toUnicode(contents));
-	}
-	else
+	m_contentsWatcher = new QFutureWatcher<QStringList>(this);
+	m_contentsWatcher->setFuture(QtConcurrent::run([=]()
 	{
-		m_sourceEditWidget->setPlainText(QString::fromLatin1(contents));
-	}
+		const QString text(codec ? codec->toUnicode(contents) : QString::fromLatin1(contents));
+		QStringList chunks;
+		int position(0);
 
-	m_sourceEditWidget->markAsLoaded();
+		while (position < text.length())
+		{
+			const int end(text.indexOf(QLatin1Char('\n'), qMin((position + 262144), (text.length() - 1))));
+			const int length(((end < 0) ? text.length() : (end + 1)) - position);
+
+			chunks.append(text.mid(position, length));
+
+			position += length;
+		}
+
+		return chunks;
+	}));
+
+	m_isLoading = true;
+
+	connect(m_contentsWatcher, &QFutureWatcher<QStringList>::finished, this, &SourceViewerWebWidget::handleContentsDecoded);
+
+	emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory});
+	emit loadingStateChanged(WebWidget::OngoingLoadingState);
 }
 
 WebWidget* SourceViewerWebWidget::clone(bool cloneHistory, bool isPrivate, const QStringList &excludedOptions) const
@@ -22,6 +22,7 @@
 
 #include "WebWidget.h"
 
+#include <QtCore/QFutureWatcher>
 #include <QtNetwork/QNetworkReply>
 
 namespace Otter
@@ -65,10 +66,13 @@ public slots:
 	void setContents(const QByteArray &contents, const QString &contentType);
 
 protected:
+	void timerEvent(QTimerEvent *event) override;
+	void markContentsAsLoaded();
 	void setOptions(const QHash<int, QVariant> &options, const QStringList &excludedOptions = {}) override;
 	bool canViewSource() const override;
 
 protected slots:
+	void handleContentsDecoded();
 	void handleViewSourceReplyFinished();
 	void handleZoomChanged();
 	void notifyEditingActionsStateChanged();
@@ -78,7 +82,10 @@ private:
 	SourceEditWidget *m_sourceEditWidget;
 	NetworkManager *m_networkManager;
 	QNetworkReply *m_viewSourceReply;
+	QFutureWatcher<QStringList> *m_contentsWatcher;
+	QStringList m_pendingContents;
 	QUrl m_url;
+	int m_contentsTimer;
 	bool m_isLoading;
 	bool m_isPrivate;
 };
@@ -22,14 +22,175 @@
 
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtGui/QTextDocument>
 
 namespace Otter
 {
 
-SyntaxHighlighter::SyntaxHighlighter(QTextDocument *document) : QSyntaxHighlighter(document)
+SyntaxHighlighter::SyntaxHighlighter(QTextDocument *document) : QSyntaxHighlighter(document),
+	m_firstBlock(0),
+	m_lastBlock(-1),
+	m_canFormat(true)
 {
 }
 
+void SyntaxHighlighter::highlightBlock(const QString &text)
+{
+	const QTextBlock block(currentBlock());
+
+	if (!isInHighlightingRange(block.blockNumber()))
+	{
+		BlockData *blockData(static_cast<BlockData*>(currentBlockUserData()));
+
+		if (blockData)
+		{
+			blockData->isHighlighted = false;
+		}
+
+		setCurrentBlockState(-1);
+
+		return;
+	}
+
+	BlockData data;
+	int state(0);
+
+	restoreState(block.previous(), data, state);
+
+	m_canFormat = true;
+
+	parseBlock(text, data, state);
+
+	if (m_lastBlock >= 0 || !data.context.isEmpty())
+	{
+		BlockData *blockData(new BlockData());
+		blockData->context = data.context;
+		blockData->state = data.state;
+		blockData->isHighlighted = true;
+
+		setCurrentBlockUserData(blockData);
+	}
+	else
+	{
+		setCurrentBlockUserData(nullptr);
+	}
+
+	setCurrentBlockState(state);
+}
+
+void SyntaxHighlighter::applyFormat(int start, int count, const QTextCharFormat &format)
+{
+	if (m_canFormat)
+	{
+		setFormat(start, count, format);
+	}
+}
+
+void SyntaxHighlighter::restoreState(const QTextBlock &block, BlockData &data, int &state)
+{
+	if (!block.isValid())
+	{
+		return;
+	}
+
+	if (block.userState() < 0)
+	{
+		QTextBlock checkpointBlock(block);
+
+		while (checkpointBlock.isValid() && checkpointBlock.userState() < 0)
+		{
+			checkpointBlock = checkpointBlock.previous();
+		}
+
+		BlockData checkpointData;
+		int checkpointState(0);
+
+		if (checkpointBlock.isValid())
+		{
+			const BlockData *blockData(static_cast<BlockData*>(checkpointBlock.userData()));
+
+			if (blockData)
+			{
+				checkpointData.context = blockData->context;
+				checkpointData.state = blockData->state;
+			}
+
+			checkpointState = checkpointBlock.userState();
+			checkpointBlock = checkpointBlock.next();
+		}
+		else
+		{
+			checkpointBlock = document()->firstBlock();
+		}
+
+		m_canFormat = false;
+
+		while (checkpointBlock.isValid())
+		{
+			parseBlock(checkpointBlock.text(), checkpointData, checkpointState);
+
+			if (checkpointData.context.isEmpty())
+			{
+				checkpointBlock.setUserData(nullptr);
+			}
+			else
+			{
+				BlockData *blockData(new BlockData());
+				blockData->context = checkpointData.context;
+				blockData->state = checkpointData.state;
+
+				checkpointBlock.setUserData(blockData);
+			}
+
+			checkpointBlock.setUserState(checkpointState);
+
+			if (checkpointBlock == block)
+			{
+				break;
+			}
+
+			checkpointBlock = checkpointBlock.next();
+		}
+
+		m_canFormat = true;
+	}
+
+	const BlockData *blockData(static_cast<BlockData*>(block.userData()));
+
+	if (blockData)
+	{
+		data.context = blockData->context;
+		data.state = blockData->state;
+	}
+
+	state = qMax(block.userState(), 0);
+}
+
+void SyntaxHighlighter::setHighlightingRange(int firstBlock, int lastBlock)
+{
+	m_firstBlock = qMax(0, firstBlock);
+	m_lastBlock = lastBlock;
+
+	if (m_lastBlock < 0 || !document())
+	{
+		return;
+	}
+
+	QTextBlock block(document()->findBlockByNumber(m_firstBlock));
+
+	while (block.isValid() && block.blockNumber() <= m_lastBlock)
+	{
+		const BlockData *blockData(static_cast<BlockData*>(block.userData()));
+
+		if (!blockData || !blockData->isHighlighted)
+		{
+			rehighlightBlock(block);
+		}
+
+		block = block.next();
+	}
+}
+
 SyntaxHighlighter* SyntaxHighlighter::createHighlighter(HighlightingSyntax syntax, QTextDocument *document)
 {
 	switch (syntax)
@@ -82,6 +243,11 @@ QTextCharFormat SyntaxHighlighter::loadFormat(const QJsonObject &definitionObjec
 	return format;
 }
 
+bool SyntaxHighlighter::isInHighlightingRange(int block) const
+{
+	return (m_lastBlock < 0 || (block >= m_firstBlock && block <= m_lastBlock));
+}
+
 QMap<AdblockPlusSyntaxHighlighter::HighlightingState, QTextCharFormat> AdblockPlusSyntaxHighlighter::m_formats;
 
 AdblockPlusSyntaxHighlighter::AdblockPlusSyntaxHighlighter(QTextDocument *document) : SyntaxHighlighter(document)
@@ -101,29 +267,25 @@ AdblockPlusSyntaxHighlighter::AdblockPlusSyntaxHighlighter(QTextDocument *docume
 	}
 }
 
-void AdblockPlusSyntaxHighlighter::highlightBlock(const QString &text)
+void AdblockPlusSyntaxHighlighter::parseBlock(const QString &text, BlockData &data, int &state)
 {
-	QString buffer;
-	BlockData currentData;
-	HighlightingState previousState(static_cast<HighlightingState>(qMax(previousBlockState(), 0)));
+	Q_UNUSED(data)
+
+	HighlightingState previousState(static_cast<HighlightingState>(state));
 	HighlightingState currentState(previousState);
 	int previousStateBegin(0);
 	int currentStateBegin(0);
+	int bufferBegin(0);
 	int position(0);
 	const bool isComment(text.trimmed().startsWith(QLatin1Char('!')));
 	bool isOption(false);
 
-	if (currentBlock().previous().userData())
-	{
-		currentData = *static_cast<BlockData*>(currentBlock().previous().userData());
-	}
-
 	while (position < text.length())
 	{
-		buffer.append(text.at(position));
-
 		++position;
 
+		const QStringRef buffer(text.midRef(bufferBegin, (position - bufferBegin)));
+
 		const bool isEndOfLine(position == text.length());
 
 		if (isOption)
@@ -211,31 +373,22 @@ void AdblockPlusSyntaxHighlighter::highlightBlock(const QString &text)
 
 		if (previousState != currentState || isEndOfLine)
 		{
-			setFormat(previousStateBegin, (position - previousStateBegin), m_formats[previousState]);
+			applyFormat(previousStateBegin, (position - previousStateBegin), m_formats[previousState]);
 
 			if (isEndOfLine)
 			{
-				setFormat(currentStateBegin, (position - currentStateBegin), m_formats[currentState]);
+				applyFormat(currentStateBegin, (position - currentStateBegin), m_formats[currentState]);
 
 				currentState = NoState;
 			}
 
-			buffer.clear();
+			bufferBegin = position;
 			previousState = currentState;
 			previousStateBegin = currentStateBegin;
 		}
 	}
 
-	if (!currentData.context.isEmpty())
-	{
-		BlockData *nextBlockData(new BlockData());
-		nextBlockData->context = currentData.context;
-		nextBlockData->state = currentData.state;
-
-		setCurrentBlockUserData(nextBlockData);
-	}
-
-	setCurrentBlockState(currentState);
+	state = currentState;
 }
 
 SyntaxHighlighter::HighlightingSyntax AdblockPlusSyntaxHighlighter::getSyntax() const
@@ -262,27 +415,21 @@ HtmlSyntaxHighlighter::HtmlSyntaxHighlighter(QTextDocument *document) : SyntaxHi
 	}
 }
 
-void HtmlSyntaxHighlighter::highlightBlock(const QString &text)
+void HtmlSyntaxHighlighter::parseBlock(const QString &text, BlockData &data, int &state)
 {
-	QString buffer;
-	BlockData currentData;
-	HighlightingState previousState(static_cast<HighlightingState>(qMax(previousBlockState(), 0)));
+	HighlightingState previousState(static_cast<HighlightingState>(state));
 	HighlightingState currentState(previousState);
 	int previousStateBegin(0);
 	int currentStateBegin(0);
+	int bufferBegin(0);
 	int position(0);
 
-	if (currentBlock().previous().userData())
-	{
-		currentData = *static_cast<BlockData*>(currentBlock().previous().userData());
-	}
-
 	while (position < text.length())
 	{
-		buffer.append(text.at(position));
-
 		++position;
 
+		const QStringRef buffer(text.midRef(bufferBegin, (position - bufferBegin)));
+
 		const bool isEndOfLine(position == text.length());
 
 		if (currentState == NoState && text.at(position - 1) == QLatin1Char('<'))
@@ -334,44 +481,35 @@ void HtmlSyntaxHighlighter::highlightBlock(const QString &text)
 		}
 		else if ((currentState == KeywordState || currentState == DoctypeState || currentState == AttributeState) && (text.at(position - 1) == QLatin1Char('\'') || text.at(position - 1) == QLatin1Char('"')))
 		{
-			currentData.context = text.at(position - 1);
-			currentData.state = currentState;
+			data.context = text.at(position - 1);
+			data.state = currentState;
 			currentState = ValueState;
 			currentStateBegin = (position - 1);
 		}
-		else if (currentState == ValueState && text.at(position - 1) == currentData.context)
+		else if (currentState == ValueState && text.at(position - 1) == data.context)
 		{
-			currentState = static_cast<HighlightingState>(currentData.state);
+			currentState = static_cast<HighlightingState>(data.state);
 			currentStateBegin = position;
-			currentData.context.clear();
-			currentData.state = NoState;
+			data.context.clear();
+			data.state = NoState;
 		}
 
 		if (previousState != currentState || isEndOfLine)
 		{
-			setFormat(previousStateBegin, (position - previousStateBegin), m_formats[previousState]);
+			applyFormat(previousStateBegin, (position - previousStateBegin), m_formats[previousState]);
 
 			if (isEndOfLine)
 			{
-				setFormat(currentStateBegin, (position - currentStateBegin), m_formats[currentState]);
+				applyFormat(currentStateBegin, (position - currentStateBegin), m_formats[currentState]);
 			}
 
-			buffer.clear();
+			bufferBegin = position;
 			previousState = currentState;
 			previousStateBegin = currentStateBegin;
 		}
 	}
 
-	if (!currentData.context.isEmpty())
-	{
-		BlockData *nextBlockData(new BlockData());
-		nextBlockData->context = currentData.context;
-		nextBlockData->state = currentData.state;
-
-		setCurrentBlockUserData(nextBlockData);
-	}
-
-	setCurrentBlockState(currentState);
+	state = currentState;
 }
 
 SyntaxHighlighter::HighlightingSyntax HtmlSyntaxHighlighter::getSyntax() const
@@ -45,16 +45,28 @@ public:
 		HighlightingSyntax currentSyntax = NoSyntax;
 		HighlightingSyntax previousSyntax = NoSyntax;
 		int state = 0;
+		bool isHighlighted = false;
 	};
 
 	explicit SyntaxHighlighter(QTextDocument *document);
 
+	void setHighlightingRange(int firstBlock, int lastBlock);
 	static SyntaxHighlighter* createHighlighter(HighlightingSyntax syntax, QTextDocument *document);
 	virtual HighlightingSyntax getSyntax() const = 0;
 
 protected:
+	void highlightBlock(const QString &text) override;
+	virtual void parseBlock(const QString &text, BlockData &data, int &state) = 0;
+	void applyFormat(int start, int count, const QTextCharFormat &format);
+	void restoreState(const QTextBlock &block, BlockData &data, int &state);
 	QJsonObject loadSyntax(HighlightingSyntax syntax) const;
 	QTextCharFormat loadFormat(const QJsonObject &definitionObject) const;
+	bool isInHighlightingRange(int block) const;
+
+private:
+	int m_firstBlock;
+	int m_lastBlock;
+	bool m_canFormat;
 };
 
 class AdblockPlusSyntaxHighlighter final : public SyntaxHighlighter
@@ -81,7 +93,7 @@ public:
 	HighlightingSyntax getSyntax() const override;
 
 protected:
-	void highlightBlock(const QString &text) override;
+	void parseBlock(const QString &text, BlockData &data, int &state) override;
 
 private:
 	static QMap<HighlightingState, QTextCharFormat> m_formats;
@@ -111,7 +123,7 @@ public:
 	HighlightingSyntax getSyntax() const override;
 
 protected:
-	void highlightBlock(const QString &text) override;
+	void parseBlock(const QString &text, BlockData &data, int &state) override;
 
 private:
 	static QMap<HighlightingState, QTextCharFormat> m_formats;
@@ -191,7 +191,7 @@ void TabSwitcherWidget::selectTab(bool next)
 
 void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 {
-	const Window *window(m_mainWindow->getWindowByIdentifier(index.data(IdentifierRole).toULongLong()));
+	Window *window(m_mainWindow->getWindowByIdentifier(index.data(IdentifierRole).toULongLong()));
 
 	m_previewLabel->setMovie(nullptr);
 	m_previewLabel->setPixmap({});
@@ -230,7 +230,7 @@ void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 
 		if (loadingState != WebWidget::CrashedLoadingState)
 		{
-			pixmap = window->createThumbnail();
+			pixmap = window->getThumbnail();
 		}
 
 		if (pixmap.isNull())
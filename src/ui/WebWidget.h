@@ -359,6 +359,7 @@ signals:
 	void requestedGeometryChange(const QRect &geometry);
 	void requestedInspectorVisibilityChange(bool isVisible);
 	void geometryChanged();
+	void contentsDamaged();
 	void findInPageResultsChanged(const QString &text, int matchesAmount, int activeResult);
 	void statusMessageChanged(const QString &message);
 	void titleChanged(const QString &title);
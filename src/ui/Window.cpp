@@ -26,6 +26,7 @@
 #include "../core/HandlersManager.h"
 #include "../core/HistoryManager.h"
 #include "../core/SettingsManager.h"
+#include "../core/ThumbnailsManager.h"
 #include "../core/Utils.h"
 #include "../modules/widgets/address/AddressWidget.h"
 #include "../modules/widgets/search/SearchWidget.h"
@@ -67,6 +68,7 @@ Window::Window(const QVariantMap &parameters, ContentsWidget *widget, MainWindow
 	m_parameters(parameters),
 	m_identifier(++m_identifierCounter),
 	m_suspendTimer(0),
+	m_thumbnailTimer(0),
 	m_isAboutToClose(false),
 	m_isPinned(false)
 {
@@ -91,6 +93,11 @@ Window::Window(const QVariantMap &parameters, ContentsWidget *widget, MainWindow
 	});
 }
 
+Window::~Window()
+{
+	ThumbnailsManager::removeThumbnail(m_identifier);
+}
+
 void Window::timerEvent(QTimerEvent *event)
 {
 	if (event->timerId() == m_suspendTimer)
@@ -101,6 +108,14 @@ void Window::timerEvent(QTimerEvent *event)
 
 		triggerAction(ActionsManager::SuspendTabAction);
 	}
+	else if (event->timerId() == m_thumbnailTimer)
+	{
+		killTimer(m_thumbnailTimer);
+
+		m_thumbnailTimer = 0;
+
+		updateThumbnail();
+	}
 }
 
 void Window::hideEvent(QHideEvent *event)
@@ -263,6 +278,28 @@ void Window::markAsActive(bool updateLastActivity)
 	emit activated();
 }
 
+void Window::updateThumbnail()
+{
+	if (!m_contentsWidget || m_isAboutToClose)
+	{
+		return;
+	}
+
+	const QPixmap thumbnail(m_contentsWidget->createThumbnail());
+
+	if (!thumbnail.isNull())
+	{
+		ThumbnailsManager::setThumbnail(m_identifier, getUrl(), getTitle(), thumbnail, isPrivate());
+
+		emit thumbnailChanged();
+	}
+}
+
+void Window::invalidateThumbnail()
+{
+	ThumbnailsManager::invalidateThumbnail(m_identifier);
+}
+
 void Window::updateFocus()
 {
 	QTimer::singleShot(100, this, [&]()
@@ -410,6 +447,8 @@ void Window::setContentsWidget(ContentsWidget *widget)
 
 	m_contentsWidget = widget;
 
+	invalidateThumbnail();
+
 	if (!m_contentsWidget)
 	{
 		if (m_addressBarWidget)
@@ -487,8 +526,11 @@ void Window::setContentsWidget(ContentsWidget *widget)
 	connect(m_contentsWidget, &ContentsWidget::titleChanged, this, &Window::titleChanged);
 	connect(m_contentsWidget, &ContentsWidget::urlChanged, this, [&](const QUrl &url)
 	{
+		invalidateThumbnail();
+
 		emit urlChanged(url, false);
 	});
+	connect(m_contentsWidget, &ContentsWidget::contentsDamaged, this, &Window::invalidateThumbnail);
 	connect(m_contentsWidget, &ContentsWidget::iconChanged, this, &Window::iconChanged);
 	connect(m_contentsWidget, &ContentsWidget::requestBlocked, this, &Window::requestBlocked);
 	connect(m_contentsWidget, &ContentsWidget::arbitraryActionsStateChanged, this, &Window::arbitraryActionsStateChanged);
@@ -577,9 +619,21 @@ QIcon Window::getIcon() const
 	return ((m_contentsWidget && !m_isAboutToClose) ? m_contentsWidget->getIcon() : HistoryManager::getIcon(m_session.getUrl()));
 }
 
-QPixmap Window::createThumbnail() const
+QPixmap Window::getThumbnail()
 {
-	return ((m_contentsWidget && !m_isAboutToClose) ? m_contentsWidget->createThumbnail() : QPixmap());
+	if (!m_contentsWidget || m_isAboutToClose)
+	{
+		return {};
+	}
+
+	const ThumbnailsManager::Thumbnail thumbnail(ThumbnailsManager::getThumbnail(m_identifier));
+
+	if (!thumbnail.isValid && m_thumbnailTimer == 0)
+	{
+		m_thumbnailTimer = startTimer(thumbnail.pixmap.isNull() ? 0 : 500);
+	}
+
+	return thumbnail.pixmap;
 }
 
 QDateTime Window::getLastActivity() const
@@ -50,6 +50,7 @@ class Window final : public QWidget, public ActionExecutor
 
 public:
 	explicit Window(const QVariantMap &parameters, ContentsWidget *widget, MainWindow *mainWindow);
+	~Window();
 
 	void clear();
 	void setOption(int identifier, const QVariant &value);
@@ -65,7 +66,7 @@ public:
 	QVariant getOption(int identifier) const;
 	QUrl getUrl() const;
 	QIcon getIcon() const;
-	QPixmap createThumbnail() const;
+	QPixmap getThumbnail();
 	QDateTime getLastActivity() const;
 	ActionsManager::ActionDefinition::State getActionState(int identifier, const QVariantMap &parameters = {}) const override;
 	Session::Window::History getHistory() const;
@@ -98,6 +99,10 @@ protected:
 	void updateFocus();
 	void setContentsWidget(ContentsWidget *widget);
 
+protected slots:
+	void updateThumbnail();
+	void invalidateThumbnail();
+
 private:
 	Q_DISABLE_COPY(Window)
 
@@ -109,6 +114,7 @@ private:
 	QVariantMap m_parameters;
 	quint64 m_identifier;
 	int m_suspendTimer;
+	int m_thumbnailTimer;
 	bool m_isAboutToClose;
 	bool m_isPinned;
 
@@ -137,6 +143,7 @@ signals:
 	void zoomChanged(int zoom);
 	void canZoomChanged(bool isAllowed);
 	void isPinnedChanged(bool isPinned);
+	void thumbnailChanged();
 };
 
 }